@@ -0,0 +1,434 @@
+﻿#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Asset/CacheFile.h"
+#include "Asset/ContentHash.h"
+#include "Asset/CookedMeshCache.h"
+#include "Asset/MeshAssetRegistry.h"
+#include "Asset/MeshOptimizer.h"
+#include "benchmark/benchmark.h"
+#include "SimpleEngine/Asset/Pipeline/AssetImporter.h"
+#include "SimpleEngine/Asset/Pipeline/Factories/StaticMeshFactory.h"
+#include "SimpleEngine/Asset/Pipeline/Translators/AssimpTranslator.h"
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+#include "SimpleEngine/Core/HAL/FileDialog.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace se;
+
+
+/* 힙 사용량 추적
+ * 임포트 한 번에 필요한 최대 힙 크기를 재기 위해 전역 new / delete를 감싼다.
+ * 크기를 알기 위해 할당 앞에 헤더를 붙인다 (정렬 버전 new는 그대로 둔다).
+ */
+namespace
+{
+    constexpr size_t AllocHeaderSize = alignof(std::max_align_t);
+
+    std::atomic<int64> current_heap_bytes = 0;
+    std::atomic<int64> peak_heap_bytes = 0;
+
+    void* TrackedAlloc(size_t size)
+    {
+        auto* block = static_cast<uint8*>(std::malloc(size + AllocHeaderSize));
+        if (!block)
+        {
+            throw std::bad_alloc();
+        }
+        *reinterpret_cast<size_t*>(block) = size;
+
+        const int64 current = current_heap_bytes += static_cast<int64>(size);
+        int64 peak = peak_heap_bytes.load(std::memory_order_relaxed);
+        while (current > peak && !peak_heap_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+        return block + AllocHeaderSize;
+    }
+
+    void TrackedFree(void* ptr)
+    {
+        if (!ptr) return;
+
+        uint8* block = static_cast<uint8*>(ptr) - AllocHeaderSize;
+        current_heap_bytes -= static_cast<int64>(*reinterpret_cast<size_t*>(block));
+        std::free(block);
+    }
+
+    /// 지금부터의 최대 힙 사용량을 다시 잰다.
+    void ResetPeakHeap()
+    {
+        peak_heap_bytes = current_heap_bytes.load();
+    }
+
+    /// 프로세스 전체의 최대 RSS (MB)
+    double GetPeakRssMB()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+        }
+        return 0.0;
+#else
+        rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+    #if defined(__APPLE__)
+        return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0); // bytes
+    #else
+        return static_cast<double>(usage.ru_maxrss) / 1024.0; // KB
+    #endif
+#endif
+    }
+}
+
+void* operator new(size_t size) { return TrackedAlloc(size); }
+void* operator new[](size_t size) { return TrackedAlloc(size); }
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { TrackedFree(ptr); }
+
+
+namespace
+{
+    std::filesystem::path GetTestAssetPath(const char* file_name)
+    {
+        return std::filesystem::path(PROJECT_ROOT_DIR) / "TestAssets" / file_name;
+    }
+
+    /// 임포트할 때 읽는 바이트. 원본에 원본이 참조하는 파일(gltf의 bin, obj의 mtl)을 더한다.
+    uint64 GetAssetBytes(const std::filesystem::path& path)
+    {
+        uint64 total = 0;
+        auto add_file_size = [&total](const std::filesystem::path& file_path)
+        {
+            std::error_code ec;
+            const uint64 size = std::filesystem::file_size(file_path, ec);
+            if (!ec)
+            {
+                total += size;
+            }
+        };
+
+        add_file_size(path);
+        for (const std::filesystem::path& dependency : FindSourceDependencies(path))
+        {
+            add_file_size(dependency);
+        }
+        return total;
+    }
+
+    /**
+     * triangle_count개 이상의 삼각형으로 된 격자 OBJ를 임시 폴더에 만든다.
+     * 같은 크기는 한 번만 만들고 다시 쓴다. 중간에 끊긴 실행이 남긴 반쯤 쓴 파일을 재지 않도록 다 쓴 뒤에 이름을 바꿔 놓는다.
+     */
+    std::filesystem::path GetSyntheticObj(uint64 triangle_count)
+    {
+        const uint32 grid = static_cast<uint32>(std::ceil(std::sqrt(static_cast<double>(triangle_count) / 2.0)));
+        const std::filesystem::path path = std::filesystem::temp_directory_path()
+                                         / std::format("SDL3_Playground_Grid_{}.obj", grid);
+        if (std::filesystem::exists(path))
+        {
+            return path;
+        }
+
+        // 실패하면 파일이 없으므로 호출한 벤치마크가 건너뛴다
+        WriteFileAtomically(path, [grid](std::ostream& file)
+        {
+            std::string line;
+            for (uint32 y = 0; y <= grid; ++y)
+            {
+                for (uint32 x = 0; x <= grid; ++x)
+                {
+                    const float u = static_cast<float>(x) / static_cast<float>(grid);
+                    const float v = static_cast<float>(y) / static_cast<float>(grid);
+                    const float height = 0.1f * std::sin(u * 20.0f) * std::cos(v * 20.0f);
+                    line = std::format("v {} {} {}\nvt {} {}\nvn 0 0 1\n", u * 100.0f, v * 100.0f, height, u, v);
+                    file << line;
+                }
+            }
+
+            // OBJ 인덱스는 1부터
+            const uint32 stride = grid + 1;
+            for (uint32 y = 0; y < grid; ++y)
+            {
+                for (uint32 x = 0; x < grid; ++x)
+                {
+                    const uint32 i0 = y * stride + x + 1;
+                    const uint32 i1 = i0 + 1;
+                    const uint32 i2 = i0 + stride;
+                    const uint32 i3 = i2 + 1;
+                    line = std::format(
+                        "f {0}/{0}/{0} {1}/{1}/{1} {3}/{3}/{3}\nf {0}/{0}/{0} {3}/{3}/{3} {2}/{2}/{2}\n",
+                        i0, i1, i2, i3
+                    );
+                    file << line;
+                }
+            }
+        });
+        return path;
+    }
+
+    std::unique_ptr<asset::AssetImporter> CreateAssetImporter()
+    {
+        auto importer = std::make_unique<asset::AssetImporter>();
+        importer->RegisterTranslator<asset::AssimpTranslator>();
+        importer->RegisterFactory<asset::StaticMeshFactory>();
+        return importer;
+    }
+
+    /// 임포트한 StaticMesh들의 삼각형 수. 실패하면 0
+    uint64 ImportAndCountTriangles(asset::AssetImporter& importer, const Path& path)
+    {
+        auto assets = importer.Import(path);
+        if (assets.HasError())
+        {
+            return 0;
+        }
+
+        uint64 triangles = 0;
+        for (const auto& asset : *assets)
+        {
+            if (const auto mesh = std::dynamic_pointer_cast<asset::StaticMesh>(asset))
+            {
+                triangles += mesh->indices.Len() / 3;
+            }
+        }
+        return triangles;
+    }
+
+    void RunImportBenchmark(benchmark::State& state, const std::filesystem::path& file_path)
+    {
+        if (!std::filesystem::exists(file_path))
+        {
+            state.SkipWithError(std::format("asset not found: {}", file_path.generic_string()));
+            return;
+        }
+
+        const Path path(file_path.generic_string().c_str());
+        const uint64 file_bytes = GetAssetBytes(file_path);
+
+        // 번역기 / 팩토리 등록 비용은 빼고 Import만 잰다 (App과 같이 임포터는 재사용)
+        const std::unique_ptr<asset::AssetImporter> importer = CreateAssetImporter();
+
+        uint64 triangles = 0;
+        int64 peak_heap = 0;
+        for (auto _ : state)
+        {
+            ResetPeakHeap();
+            const int64 heap_before = current_heap_bytes.load();
+
+            triangles = ImportAndCountTriangles(*importer, path);
+
+            peak_heap = std::max(peak_heap, peak_heap_bytes.load() - heap_before);
+            if (triangles == 0)
+            {
+                state.SkipWithError("import failed");
+                return;
+            }
+        }
+
+        state.counters["MB/s"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * file_bytes) / (1024.0 * 1024.0), benchmark::Counter::kIsRate
+        );
+        state.counters["tris/s"] = benchmark::Counter(
+            static_cast<double>(state.iterations() * triangles), benchmark::Counter::kIsRate
+        );
+        state.counters["triangles"] = static_cast<double>(triangles);
+        state.counters["file_MB"] = static_cast<double>(file_bytes) / (1024.0 * 1024.0);
+        state.counters["peak_heap_MB"] = static_cast<double>(peak_heap) / (1024.0 * 1024.0);
+        state.counters["peak_rss_MB"] = GetPeakRssMB();
+    }
+
+    std::vector<std::shared_ptr<asset::StaticMesh>> ImportMeshes(asset::AssetImporter& importer, const Path& path)
+    {
+        std::vector<std::shared_ptr<asset::StaticMesh>> meshes;
+        auto assets = importer.Import(path);
+        if (!assets.HasError())
+        {
+            for (const auto& asset : *assets)
+            {
+                if (auto mesh = std::dynamic_pointer_cast<asset::StaticMesh>(asset))
+                {
+                    meshes.push_back(std::move(mesh));
+                }
+            }
+        }
+        return meshes;
+    }
+}
+
+static void BM_Import_TestAsset(benchmark::State& state, const char* file_name)
+{
+    RunImportBenchmark(state, GetTestAssetPath(file_name));
+}
+
+static void BM_Import_SyntheticGrid(benchmark::State& state)
+{
+    // 생성은 측정 밖에서 (처음 한 번만 파일을 만든다)
+    RunImportBenchmark(state, GetSyntheticObj(static_cast<uint64>(state.range(0))));
+}
+
+/// 임포트 후 최적화 단계만 잰다. 최적화는 메쉬를 바꾸므로 매 반복마다 다시 임포트한다 (측정 제외).
+static void BM_OptimizeMesh_TestAsset(benchmark::State& state, const char* file_name)
+{
+    const std::filesystem::path file_path = GetTestAssetPath(file_name);
+    if (!std::filesystem::exists(file_path))
+    {
+        state.SkipWithError(std::format("asset not found: {}", file_path.generic_string()));
+        return;
+    }
+
+    const Path path(file_path.generic_string().c_str());
+    const std::unique_ptr<asset::AssetImporter> importer = CreateAssetImporter();
+
+    MeshOptimizeStats total;
+    uint64 triangles = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto meshes = ImportMeshes(*importer, path);
+        state.ResumeTiming();
+
+        if (meshes.empty())
+        {
+            state.SkipWithError("import failed");
+            return;
+        }
+
+        total = {};
+        triangles = 0;
+        for (const auto& mesh : meshes)
+        {
+            const MeshOptimizeStats stats = OptimizeStaticMesh(*mesh);
+            total.vertices_before += stats.vertices_before;
+            total.vertices_after += stats.vertices_after;
+            total.cache_before.vertices_transformed += stats.cache_before.vertices_transformed;
+            total.cache_after.vertices_transformed += stats.cache_after.vertices_transformed;
+            triangles += stats.cache_before.num_triangles;
+        }
+    }
+
+    // 메쉬 여러 개는 삼각형 / 정점 수로 가중 평균
+    const auto ratio = [](uint32 a, uint64 b) { return b > 0 ? static_cast<double>(a) / static_cast<double>(b) : 0.0; };
+    state.counters["tris/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * triangles), benchmark::Counter::kIsRate
+    );
+    state.counters["acmr_before"] = ratio(total.cache_before.vertices_transformed, triangles);
+    state.counters["acmr_after"] = ratio(total.cache_after.vertices_transformed, triangles);
+    state.counters["atvr_after"] = ratio(total.cache_after.vertices_transformed, total.vertices_after);
+    state.counters["vertices_before"] = static_cast<double>(total.vertices_before);
+    state.counters["vertices_after"] = static_cast<double>(total.vertices_after);
+}
+
+/* 쿠킹 캐시에서 다시 읽는 비용 (원본 내용 해시 + 매핑 + 업로드할 바이트를 한 번 복사)
+ * 복사 대상은 Transfer Buffer 대신 미리 잡아 둔 버퍼. 쿠킹은 측정 밖에서 한 번만 한다.
+ * BM_Import_SyntheticGrid와 같은 크기로 비교한다.
+ */
+static void BM_LoadCooked_SyntheticGrid(benchmark::State& state)
+{
+    const std::filesystem::path file_path = GetSyntheticObj(static_cast<uint64>(state.range(0)));
+    const std::filesystem::path cache_dir = std::filesystem::temp_directory_path() / "SDL3_Playground_MeshCache";
+    CookedMeshCache cache(cache_dir);
+
+    const std::optional<uint64> content_hash = HashSourceFiles(file_path);
+    if (!content_hash)
+    {
+        state.SkipWithError("asset not found");
+        return;
+    }
+
+    const uint64 key = MeshAssetRegistry::MakeKey(*content_hash, 0);
+    if (!cache.Load(key))
+    {
+        const std::unique_ptr<asset::AssetImporter> importer = CreateAssetImporter();
+        const auto meshes = ImportMeshes(*importer, Path(file_path.generic_string().c_str()));
+        if (meshes.empty())
+        {
+            state.SkipWithError("import failed");
+            return;
+        }
+
+        std::vector<GpuMeshData> cooked;
+        for (const auto& mesh : meshes)
+        {
+            cooked.push_back(MakeGpuMeshData(*mesh, {}, true));
+        }
+        cache.Store(key, cooked);
+    }
+
+    std::vector<uint8> transfer_buffer;
+    uint64 cooked_bytes = 0;
+    for (auto _ : state)
+    {
+        const std::optional<uint64> hash = HashSourceFiles(file_path);
+        const auto cooked = hash ? cache.Load(MeshAssetRegistry::MakeKey(*hash, 0)) : std::nullopt;
+        if (!cooked)
+        {
+            state.SkipWithError("cooked load failed");
+            return;
+        }
+
+        cooked_bytes = 0;
+        for (const GpuMeshData& mesh : *cooked)
+        {
+            cooked_bytes += mesh.vertex_data.size() + mesh.index_data.size();
+        }
+        transfer_buffer.resize(cooked_bytes);
+
+        uint8* dst = transfer_buffer.data();
+        for (const GpuMeshData& mesh : *cooked)
+        {
+            std::memcpy(dst, mesh.vertex_data.data(), mesh.vertex_data.size());
+            dst += mesh.vertex_data.size();
+            std::memcpy(dst, mesh.index_data.data(), mesh.index_data.size());
+            dst += mesh.index_data.size();
+        }
+        benchmark::DoNotOptimize(transfer_buffer.data());
+    }
+
+    state.counters["MB/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * cooked_bytes) / (1024.0 * 1024.0), benchmark::Counter::kIsRate
+    );
+    state.counters["cooked_MB"] = static_cast<double>(cooked_bytes) / (1024.0 * 1024.0);
+}
+
+BENCHMARK_CAPTURE(BM_Import_TestAsset, TestMesh_gltf, "TestMesh.gltf")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Import_TestAsset, Heart_obj, "Heart_LowPolygon.obj")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Import_TestAsset, Heart_fbx, "Heart_LowPolygon.fbx")->Unit(benchmark::kMillisecond);
+
+// 약 1.6만 ~ 420만 삼각형
+BENCHMARK(BM_Import_SyntheticGrid)
+    ->RangeMultiplier(4)->Range(1 << 14, 1 << 22)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_LoadCooked_SyntheticGrid)
+    ->RangeMultiplier(4)->Range(1 << 14, 1 << 22)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_OptimizeMesh_TestAsset, TestMesh_gltf, "TestMesh.gltf")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OptimizeMesh_TestAsset, Heart_obj, "Heart_LowPolygon.obj")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OptimizeMesh_TestAsset, Heart_fbx, "Heart_LowPolygon.fbx")->Unit(benchmark::kMillisecond);
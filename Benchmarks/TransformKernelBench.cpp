@@ -0,0 +1,158 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Math/TransformKernel.h"
+#include "SimpleEngine/Core/Math/Math.h"
+#include "SimpleEngine/ECS/Components/TransformComponent.h"
+
+using namespace se;
+using namespace se::ecs;
+
+
+namespace
+{
+    std::vector<TransformComponent> MakeTransforms(size_t count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<double> position_dist(-100.0, 100.0);
+        std::uniform_real_distribution<double> axis_dist(-1.0, 1.0);
+        std::uniform_real_distribution<double> angle_dist(-180.0, 180.0);
+        std::uniform_real_distribution<double> scale_dist(0.1, 4.0);
+
+        std::vector<TransformComponent> transforms(count);
+        for (TransformComponent& transform : transforms)
+        {
+            transform.position = Vector3(position_dist(rng), position_dist(rng), position_dist(rng));
+            transform.rotation = Quaternion::FromAxisAngle(
+                Vector3(axis_dist(rng), axis_dist(rng), axis_dist(rng) + 2.0).GetNormalized(),
+                Radian{ Degree<double>{ angle_dist(rng) } }
+            );
+            transform.scale = Vector3(scale_dist(rng), scale_dist(rng), scale_dist(rng));
+        }
+        return transforms;
+    }
+
+    Matrix4x4 MakeViewProjection()
+    {
+        const Matrix4x4 view_mat = math::TransformUtility::MakeViewMatrix(
+            Vector3{ 0, -8, 6 }, Vector3{ 0, -7, 6 }, Vector3::UnitZ()
+        );
+        const Matrix4x4 projection_mat = math::TransformUtility::MakePerspectiveMatrix(
+            Radian{ 90_deg }, 16.0 / 9.0, 0.1, 10000.0
+        );
+        return view_mat * projection_mat;
+    }
+
+    Matrix4x4f ToFloatMatrix(const Matrix4x4& mat)
+    {
+        Matrix4x4f result;
+        for (int i = 0; i < 16; ++i)
+        {
+            result.GetData()[i] = static_cast<float>(mat.GetData()[i]);
+        }
+        return result;
+    }
+
+    /// 기존 App::Render의 엔티티별 경로 (double 모델 행렬 -> model * vp -> float 변환)
+    void BuildReference(const std::vector<TransformComponent>& transforms, const Matrix4x4& vp_mat, std::vector<Matrix4x4f>& out)
+    {
+        for (size_t i = 0; i < transforms.size(); ++i)
+        {
+            const TransformComponent& transform = transforms[i];
+            const Matrix4x4 model = math::TransformUtility::MakeModelMatrix(
+                transform.position, transform.rotation, transform.scale
+            );
+            out[i] = ToFloatMatrix(model * vp_mat);
+        }
+    }
+
+    /// 기준 경로와의 최대 상대 오차
+    double MaxRelativeError(const std::vector<Matrix4x4f>& expected, const std::vector<Matrix4x4f>& actual)
+    {
+        double max_error = 0.0;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            for (int j = 0; j < 16; ++j)
+            {
+                const double e = expected[i].GetData()[j];
+                const double a = actual[i].GetData()[j];
+                max_error = std::max(max_error, std::abs(e - a) / std::max(1.0, std::abs(e)));
+            }
+        }
+        return max_error;
+    }
+}
+
+static void BM_Mvp_PerEntity(benchmark::State& state)
+{
+    const std::vector<TransformComponent> transforms = MakeTransforms(static_cast<size_t>(state.range(0)));
+    const Matrix4x4 vp_mat = MakeViewProjection();
+    std::vector<Matrix4x4f> out(transforms.size());
+
+    for (auto _ : state)
+    {
+        BuildReference(transforms, vp_mat, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Mvp_Batch(benchmark::State& state, TransformKernelBackend backend)
+{
+    if (TransformBatch::ResolveBackend(backend) != backend)
+    {
+        state.SkipWithError("backend not supported on this CPU/build");
+        return;
+    }
+
+    const std::vector<TransformComponent> transforms = MakeTransforms(static_cast<size_t>(state.range(0)));
+    const Matrix4x4 vp_mat = MakeViewProjection();
+    const Matrix4x4f vp_matf = ToFloatMatrix(vp_mat);
+
+    TransformBatch batch;
+    batch.Reserve(transforms.size());
+    std::vector<Matrix4x4f> out(transforms.size());
+
+    // 결과가 기존 경로와 일치하는지 먼저 확인
+    {
+        for (const TransformComponent& transform : transforms)
+        {
+            batch.Push(transform);
+        }
+        batch.BuildMvpMatrices(vp_matf, out, backend);
+
+        std::vector<Matrix4x4f> expected(transforms.size());
+        BuildReference(transforms, vp_mat, expected);
+
+        const double error = MaxRelativeError(expected, out);
+        state.counters["max_rel_error"] = error;
+        if (error > 1e-3)
+        {
+            state.SkipWithError("batch result does not match MakeModelMatrix * vp");
+            return;
+        }
+    }
+
+    // 매 프레임 하는 일과 같게, SoA 수집(Push)까지 포함해서 측정
+    for (auto _ : state)
+    {
+        batch.Clear();
+        for (const TransformComponent& transform : transforms)
+        {
+            batch.Push(transform);
+        }
+        batch.BuildMvpMatrices(vp_matf, out, backend);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Mvp_PerEntity)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_CAPTURE(BM_Mvp_Batch, Scalar, TransformKernelBackend::Scalar)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_CAPTURE(BM_Mvp_Batch, SSE41, TransformKernelBackend::SSE41)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_CAPTURE(BM_Mvp_Batch, AVX2, TransformKernelBackend::AVX2)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
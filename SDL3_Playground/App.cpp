@@ -1,11 +1,32 @@
 ﻿#include "App.h"
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cmath>
 #include <filesystem>
 #include <format>
+#include <limits>
 #include <ranges>
-
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Asset/CookedMeshCache.h"
+#include "Asset/MeshAssetRegistry.h"
+#include "Asset/MeshOptimizer.h"
+#include "Asset/MeshSimplifier.h"
 #include "Graphics/Compiler/Provider.h"
+#include "Rendering/CachingShaderProvider.h"
+#include "Rendering/FrustumCulling.h"
+#include "Rendering/GeometryBuffer.h"
+#include "Rendering/InstanceBuffer.h"
+#include "Rendering/MeshInstanceBatcher.h"
+#include "Rendering/RenderTargetPool.h"
+#include "Rendering/ShaderCache.h"
+#include "Rendering/ShaderLibrary.h"
+#include "Rendering/UploadRing.h"
+#include "Threading/WorkerPool.h"
 #include "SimpleEngine/Asset/Pipeline/AssetImporter.h"
 #include "SimpleEngine/Asset/Pipeline/Factories/StaticMeshFactory.h"
 #include "SimpleEngine/Asset/Pipeline/Translators/AssimpTranslator.h"
@@ -17,7 +38,6 @@
 #include "SimpleEngine/ECS/Components/TransformComponent.h"
 #include "SimpleEngine/Graphics/MeshPrimitives.h"
 #include "SimpleEngine/Graphics/Manager/PSOManager.h"
-#include "SimpleEngine/Graphics/Memory/GpuResourceManager.h"
 #include "SimpleEngine/Utility/StringUtils.h"
 
 #include "imgui.h"
@@ -56,13 +76,23 @@ static se::Ray ScreenToWorldRay(float mouse_x, float mouse_y, float window_w, fl
     return se::Ray(ray_origin, ray_dir);
 }
 
+static Matrix4x4f ToFloatMatrix(const Matrix4x4& mat)
+{
+    Matrix4x4f result;
+    for (int i = 0; i < 16; ++i)
+    {
+        result.GetData()[i] = static_cast<float>(mat.GetData()[i]);
+    }
+    return result;
+}
+
 double App::CurrentTime = 0.0;
 double App::LastTime = 0.0;
 double App::DeltaTime = 1.0 / 60.0;
 double App::FixedDeltaTime = 1.0 / 60.0;
 uint64 App::TotalElapsedTime = 0;
 
-uint32 App::TargetFps = 24000;
+uint32 App::TargetFps = 120;
 double App::TargetFrameTime = 1.0 / static_cast<double>(TargetFps);
 
 App* App::Instance = nullptr;
@@ -78,17 +108,127 @@ struct Camera
     Degree<double> fov = 90_deg;
 };
 
-struct MeshComponent
+// Default.vert.hlsl의 ViewBuffer와 레이아웃이 같아야 함
+struct ViewUniform
+{
+    Matrix4x4f view_proj;
+    uint32 instance_offset = 0;
+    uint32 padding[3] = {};
+};
+
+// 뷰(윈도우)마다 따로 가지는 렌더링 스크래치. 뷰를 병렬로 기록할 때 서로 공유하지 않는다.
+struct ViewRenderContext
 {
-    std::shared_ptr<LoadedMesh> mesh;
+    explicit ViewRenderContext(SDL_GPUDevice* device)
+        : instance_buffer(device)
+    {
+    }
+
+    InstanceBuffer instance_buffer;
+    MeshInstanceBatcher mesh_batcher;
+    std::vector<Matrix4x4f> instance_models;
+    std::vector<uint8> visibility;
 };
 
+static std::unique_ptr<asset::AssetImporter> CreateAssetImporter()
+{
+    auto importer = std::make_unique<asset::AssetImporter>();
+    importer->RegisterTranslator<asset::AssimpTranslator>();
+    importer->RegisterFactory<asset::StaticMeshFactory>();
+    return importer;
+}
+
+/// 임포트 워커에서 메쉬마다 실행되는 후처리 (최적화 -> LOD 생성 -> GPU 인코딩 순서, LOD는 최적화된 정점을 참조한다)
+/// 인코딩 결과는 쿠킹 캐시에 그대로 저장된다.
+static AsyncMeshImporter::MeshProcessor MakeMeshProcessor(bool is_optimize_enabled, bool is_lod_enabled, bool is_compact_enabled)
+{
+    return [is_optimize_enabled, is_lod_enabled, is_compact_enabled](ImportedMesh& imported)
+    {
+        asset::StaticMesh& mesh = *imported.mesh;
+        if (is_optimize_enabled)
+        {
+            const MeshOptimizeStats stats = OptimizeStaticMesh(mesh);
+            SDL_Log(
+                "Mesh optimized: %u -> %u vertices, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                stats.vertices_before, stats.vertices_after,
+                stats.cache_before.acmr, stats.cache_after.acmr,
+                stats.cache_before.atvr, stats.cache_after.atvr
+            );
+        }
+
+        if (is_lod_enabled)
+        {
+            imported.lods = GenerateMeshLods(mesh);
+
+            std::string chain = std::to_string(mesh.indices.Len() / 3);
+            for (const MeshLod& lod : imported.lods)
+            {
+                chain += std::format(" -> {} ({:.4f})", lod.num_triangles, lod.error);
+            }
+            SDL_Log("Mesh LODs: %s triangles", chain.c_str());
+        }
+
+        imported.gpu = MakeGpuMeshData(mesh, imported.lods, is_compact_enabled);
+    };
+}
+
+
 static Camera my_camera;
 
 static SDL_Window* focused_window = nullptr;
 
 
-App::App()
+AppOptions AppOptions::FromCommandLine(int argc, char* argv[])
+{
+    AppOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string_view key = arg.substr(0, eq);
+        const std::string_view value = eq != std::string_view::npos ? arg.substr(eq + 1) : std::string_view{};
+
+        if (key == "--headless")
+        {
+            options.is_headless = true;
+        }
+        else if (key == "--gpu-driver")
+        {
+            options.gpu_driver = value; // vulkan, direct3d12, metal
+        }
+        else if (key == "--frames-in-flight")
+        {
+            std::from_chars(value.data(), value.data() + value.size(), options.frames_in_flight);
+        }
+        else if (key == "--frames")
+        {
+            std::from_chars(value.data(), value.data() + value.size(), options.max_frames);
+        }
+        else if (key == "--size")
+        {
+            const size_t x = value.find('x');
+            if (x != std::string_view::npos)
+            {
+                uint32 width = 0, height = 0;
+                std::from_chars(value.data(), value.data() + x, width);
+                std::from_chars(value.data() + x + 1, value.data() + value.size(), height);
+                if (width > 0 && height > 0)
+                {
+                    options.width = width;
+                    options.height = height;
+                }
+            }
+        }
+        else
+        {
+            SDL_Log("Unknown argument: %s", argv[i]);
+        }
+    }
+    return options;
+}
+
+App::App(AppOptions options)
+    : options(std::move(options))
 {
     assert(!Instance);
     Instance = this;
@@ -103,12 +243,25 @@ void App::Initialize()
 {
     ZoneScoped;
 
-    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD | SDL_INIT_EVENTS);
+    if (options.is_headless)
+    {
+        // 디스플레이가 없는 CI에서도 SDL 비디오 서브시스템이 뜨도록 오프스크린 드라이버 사용
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    }
+    else
+    {
+        SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD | SDL_INIT_EVENTS);
+    }
     SDL_ShaderCross_Init();
 
-    asset_importer = std::make_unique<asset::AssetImporter>();
-    asset_importer->RegisterTranslator<asset::AssimpTranslator>();
-    asset_importer->RegisterFactory<asset::StaticMeshFactory>();
+    // 임포트는 워커 스레드에서 (워커마다 AssetImporter 하나)
+    // 후처리는 압축 정점 파이프라인을 만든 뒤 지정한다 (만들지 못하면 압축하지 않는다)
+    mesh_importer = std::make_unique<AsyncMeshImporter>(&CreateAssetImporter);
+    cooked_mesh_cache = std::make_shared<CookedMeshCache>(std::filesystem::path(SDL_GetBasePath()) / "MeshCache");
+    mesh_importer->SetCookedMeshCache(cooked_mesh_cache);
+    mesh_asset_registry = std::make_shared<MeshAssetRegistry>();
+    mesh_importer->SetMeshAssetRegistry(mesh_asset_registry);
 
     /* GPU Device 초기화 */
     // 지원할 셰이더 포맷들 설정
@@ -123,8 +276,17 @@ void App::Initialize()
     SDL_SetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_DEBUGMODE_BOOLEAN, true);
 #endif
 
-    // dx12로 설정
-    SDL_SetHint(SDL_HINT_GPU_DRIVER, "direct3d12");
+    // 드라이버를 지정하지 않으면 Windows에서는 dx12로 설정
+    if (!options.gpu_driver.empty())
+    {
+        SDL_SetHint(SDL_HINT_GPU_DRIVER, options.gpu_driver.c_str());
+    }
+#ifdef _WIN32
+    else
+    {
+        SDL_SetHint(SDL_HINT_GPU_DRIVER, "direct3d12");
+    }
+#endif
 
     // GPU Device 생성
     gpu_device = SDL_CreateGPUDeviceWithProperties(props);
@@ -135,31 +297,58 @@ void App::Initialize()
         [[maybe_unused]] const char* msg = SDL_GetError();
         SDL_AssertBreakpoint();
     }
+    SDL_Log("GPU driver: %s", SDL_GetGPUDeviceDriver(gpu_device));
 
-    /* 윈도우 초기화 */
-    const float main_display_scale = SDL_GetDisplayContentScale(SDL_GetPrimaryDisplay());
+    // 윈도우별 컬러 / 뎁스 타겟
+    render_target_pool = std::make_unique<RenderTargetPool>(gpu_device);
 
-    constexpr int32 width = 1600;
-    constexpr int32 height = 900;
+    // D24S8을 지원하지 않는 드라이버(일부 Vulkan / Metal)는 D32S8 사용
+    depth_target_format = SDL_GPUTextureSupportsFormat(
+        gpu_device, SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT, SDL_GPU_TEXTURETYPE_2D, SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET
+    ) ? SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT : SDL_GPU_TEXTUREFORMAT_D32_FLOAT_S8_UINT;
 
-    main_window_id = CreateWindow(
-        "SDL3 Playground",
-        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-        static_cast<int32>(width * main_display_scale),
-        static_cast<int32>(height * main_display_scale),
-        SDL_WINDOW_RESIZABLE
-    );
+    // 스왑체인 쪽 제한도 같은 값으로 맞춘다
+    frames_in_flight = std::clamp(options.frames_in_flight, 1u, MaxFramesInFlight);
+    SDL_SetGPUAllowedFramesInFlight(gpu_device, frames_in_flight);
 
-    SDL_Window* window = GetWindow(main_window_id);
-    windows.insert({ main_window_id, window });
+    const uint32 width = options.width;
+    const uint32 height = options.height;
 
-    // Swapchain 설정
-    SDL_SetGPUSwapchainParameters(
-        gpu_device,
-        window,
-        SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
-        SDL_GPU_PRESENTMODE_MAILBOX
-    );
+    SDL_Window* window = nullptr;
+    float main_display_scale = 1.0f;
+    if (options.is_headless)
+    {
+        // 헤드리스: 윈도우 / 스왑체인 없이 오프스크린 컬러 타겟에 그린다 (타겟은 풀에서 얻는다)
+        color_target_format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+
+        // 페이싱 없이 최대한 빨리 돌려 CPU 비용만 측정
+        frame_pacer.SetMode(FramePacingMode::Unlimited);
+    }
+    else
+    {
+        /* 윈도우 초기화 */
+        main_display_scale = SDL_GetDisplayContentScale(SDL_GetPrimaryDisplay());
+
+        main_window_id = CreateWindow(
+            "SDL3 Playground",
+            SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+            static_cast<int32>(static_cast<float>(width) * main_display_scale),
+            static_cast<int32>(static_cast<float>(height) * main_display_scale),
+            SDL_WINDOW_RESIZABLE
+        );
+
+        window = GetWindow(main_window_id);
+        windows.insert({ main_window_id, window });
+
+        // Swapchain 설정
+        SDL_SetGPUSwapchainParameters(
+            gpu_device,
+            window,
+            SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
+            GetPresentMode(window)
+        );
+        color_target_format = SDL_GetGPUSwapchainTextureFormat(gpu_device, window);
+    }
 
 
     // ImGui 초기화
@@ -170,7 +359,10 @@ void App::Initialize()
     IO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Enable Keyboard Controls
     IO.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;  // Enable Gamepad Controls
     IO.ConfigFlags |= ImGuiConfigFlags_DockingEnable;     // Enable Docking
-    IO.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;   // Enable Multi-Viewport / Platform Windows
+    if (!options.is_headless)
+    {
+        IO.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport / Platform Windows
+    }
 
     ImGui::StyleColorsDark();
 
@@ -180,22 +372,48 @@ void App::Initialize()
     IO.ConfigDpiScaleFonts = true;
     IO.ConfigDpiScaleViewports = true;
 
-    ImGui_ImplSDL3_InitForSDLGPU(window);
+    if (window)
+    {
+        ImGui_ImplSDL3_InitForSDLGPU(window);
+    }
+    else
+    {
+        // 플랫폼 백엔드 없이 화면 크기와 시간만 Update에서 직접 채운다
+        IO.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        IO.IniFilename = nullptr;
+    }
     ImGui_ImplSDLGPU3_InitInfo init_info = {
         .Device = gpu_device,
-        .ColorTargetFormat = SDL_GetGPUSwapchainTextureFormat(gpu_device, window),
+        .ColorTargetFormat = color_target_format,
         .MSAASamples = SDL_GPU_SAMPLECOUNT_1,
     };
     ImGui_ImplSDLGPU3_Init(&init_info);
 
-    SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
-    SDL_ShowWindow(window);
+    if (window)
+    {
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
+        SDL_ShowWindow(window);
+    }
+
+    // 컴파일된 셰이더는 실행 파일 옆에 캐시해 두고 소스가 바뀌었을 때만 다시 컴파일한다
+    const std::filesystem::path shader_cache_dir = std::filesystem::path(SDL_GetBasePath()) / "ShaderCache";
+    shader_cache = std::make_unique<ShaderCache>(shader_cache_dir);
+    shader_library = std::make_unique<ShaderLibrary>(*shader_cache, shader_cache_dir / "RecordedShaders.txt");
+    const uint64 shader_start_counter = SDL_GetPerformanceCounter();
 
     pso_manager = std::make_unique<PSOManager>(gpu_device);
-    pso_manager->SetShaderCacheProvider<editor::CompilingShaderProvider>();
+    pso_manager->SetShaderCacheProvider<CachingShaderProvider>(*shader_library);
+
+    // 지난 실행에서 쓴 셰이더 모듈을 워커 스레드에서 미리 만들어 두면
+    // 아래 파이프라인 생성은 메모리에 있는 모듈을 가져다 쓰기만 한다
+    // (디스크 캐시 읽기만 병렬이고, 캐시에 없는 셰이더의 컴파일과 파이프라인 생성은 여전히 하나씩 한다)
+    shader_library->PrewarmRecorded();
 
-    // GPU Resource Manager 초기화
-    gpu_resource_manager = std::make_unique<GpuResourceManager>(gpu_device);
+    render_workers = std::make_unique<WorkerPool>(std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, 3u));
+    upload_ring = std::make_unique<UploadRing>(gpu_device, 64u * 1024 * 1024);
+
+    // 메쉬 지오메트리는 64MB 페이지에서 나눠 쓰고, 해제한 구간은 진행 중인 프레임이 끝난 뒤에 다시 쓴다
+    geometry_buffer = std::make_unique<GeometryBuffer>(gpu_device, *upload_ring, 64u * 1024 * 1024, MaxFramesInFlight);
 
     // 셰이더 컴파일때 사용하는 솔루션 경로
     const std::filesystem::path root = PROJECT_ROOT_DIR;
@@ -237,7 +455,7 @@ void App::Initialize()
     };
 
     SDL_GPUColorTargetDescription color_target_desc[] = {
-        { .format = SDL_GetGPUSwapchainTextureFormat(gpu_device, window) }
+        { .format = color_target_format }
     };
 
     // 파이프라인 생성
@@ -270,7 +488,7 @@ void App::Initialize()
         .target_info = {
             .color_target_descriptions = color_target_desc,
             .num_color_targets = std::size(color_target_desc),
-            .depth_stencil_format = SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT,
+            .depth_stencil_format = depth_target_format,
             .has_depth_stencil_target = true,
         },
     });
@@ -280,6 +498,78 @@ void App::Initialize()
         SDL_AssertBreakpoint();
     }
 
+    // 압축 정점(CompactVertex) 메쉬용 파이프라인, 상태는 위와 같고 정점 입력만 다르다
+    SDL_GPUVertexBufferDescription compact_vertex_buffer_desc[] = {
+        {
+            .slot = 0,
+            .pitch = sizeof(CompactVertex),
+            .input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX
+        }
+    };
+
+    SDL_GPUVertexAttribute compact_vertex_attributes[] = {
+        {
+            .location = 0, // POSITION
+            .buffer_slot = 0,
+            .format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM,
+            .offset = offsetof(CompactVertex, position)
+        },
+        {
+            .location = 1, // NORMAL
+            .buffer_slot = 0,
+            .format = SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM,
+            .offset = offsetof(CompactVertex, normal)
+        },
+        {
+            .location = 2, // TEXCOORD
+            .buffer_slot = 0,
+            .format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2,
+            .offset = offsetof(CompactVertex, tex_coord)
+        },
+    };
+
+    compact_pipeline = pso_manager->GetOrCreateGraphicsPipeline({
+        .vertex_shader_request = {
+            .source_path = root / "Shaders/Compact.vert.hlsl",
+        },
+        .fragment_shader_request = {
+            .source_path = root / "Shaders/Default.frag.hlsl",
+        },
+        .vertex_input_state = {
+            .vertex_buffer_descriptions = compact_vertex_buffer_desc,
+            .num_vertex_buffers = std::size(compact_vertex_buffer_desc),
+            .vertex_attributes = compact_vertex_attributes,
+            .num_vertex_attributes = std::size(compact_vertex_attributes),
+        },
+        .primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST,
+        .rasterizer_state = {
+            .fill_mode = SDL_GPU_FILLMODE_FILL,
+            .cull_mode = SDL_GPU_CULLMODE_BACK,
+            .front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE
+        },
+        .multisample_state = {},
+        .depth_stencil_state = {
+            .compare_op = SDL_GPU_COMPAREOP_LESS,
+            .enable_depth_test = true,
+            .enable_depth_write = true,
+            .enable_stencil_test = false,
+        },
+        .target_info = {
+            .color_target_descriptions = color_target_desc,
+            .num_color_targets = std::size(color_target_desc),
+            .depth_stencil_format = depth_target_format,
+            .has_depth_stencil_target = true,
+        },
+    });
+
+    if (!compact_pipeline)
+    {
+        // 셰이더를 못 만들면 기존 형식으로 올린다
+        SDL_Log("Compact vertex pipeline unavailable, meshes will use the full vertex format");
+        is_compact_vertex_enabled = false;
+    }
+    UpdateMeshProcessor();
+
     // 선 렌더링용 파이프라인 생성
     line_pipeline = pso_manager->GetOrCreateGraphicsPipeline({
         .vertex_shader_request = {
@@ -310,7 +600,7 @@ void App::Initialize()
         .target_info = {
             .color_target_descriptions = color_target_desc,
             .num_color_targets = std::size(color_target_desc),
-            .depth_stencil_format = SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT,
+            .depth_stencil_format = depth_target_format,
             .has_depth_stencil_target = true,
         },
     });
@@ -331,23 +621,27 @@ void App::Initialize()
         .target_info = {
             .color_target_descriptions = color_target_desc,
             .num_color_targets = std::size(color_target_desc),
-            .depth_stencil_format = SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT,
+            .depth_stencil_format = depth_target_format,
             .has_depth_stencil_target = true,
         },
     });
 
-    // 뎁스 텍스처 생성
-    constexpr SDL_GPUTextureCreateInfo texture_info = {
-        .type = SDL_GPU_TEXTURETYPE_2D,
-        .format = SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT,
-        .usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET,
-        .width = width,
-        .height = height,
-        .layer_count_or_depth = 1,
-        .num_levels = 1,
-        .sample_count = SDL_GPU_SAMPLECOUNT_1,
-    };
-    depth_texture = SDL_CreateGPUTexture(gpu_device, &texture_info);
+    {
+        const double shader_seconds = static_cast<double>(SDL_GetPerformanceCounter() - shader_start_counter)
+                                    / static_cast<double>(SDL_GetPerformanceFrequency());
+        shader_library->SaveRecorded();
+
+        const ShaderCacheStats cache_stats = shader_cache->GetStats();
+        const ShaderLibraryStats library_stats = shader_library->GetStats();
+        SDL_Log(
+            "Shader cache: %u hits, %u misses (%u corrupted), %u stored, pipelines ready in %.1f ms",
+            cache_stats.hits, cache_stats.misses, cache_stats.corrupted, cache_stats.stores, shader_seconds * 1000.0
+        );
+        SDL_Log(
+            "Shader modules: %u unique, %u shared, %u compiled, %u prewarmed",
+            library_stats.unique_modules, library_stats.shared_hits, library_stats.compiled, library_stats.prewarmed
+        );
+    }
 
     // 단위 큐브(0~1) 정점 데이터 (선 렌더링용)
     Vertex unit_cube_vertices[] = {
@@ -367,26 +661,9 @@ void App::Initialize()
     debug_unit_cube_vbuf = SDL_CreateGPUBuffer(gpu_device, &vbuf_info);
     debug_unit_cube_ibuf = SDL_CreateGPUBuffer(gpu_device, &ibuf_info);
 
-    SDL_GPUTransferBufferCreateInfo transfer_info = { .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD, .size = sizeof(unit_cube_vertices) + sizeof(unit_cube_indices) };
-    SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer(gpu_device, &transfer_info);
-    
-    void* map = SDL_MapGPUTransferBuffer(gpu_device, transfer_buffer, false);
-    SDL_memcpy(map, unit_cube_vertices, sizeof(unit_cube_vertices));
-    SDL_memcpy((uint8*)map + sizeof(unit_cube_vertices), unit_cube_indices, sizeof(unit_cube_indices));
-    SDL_UnmapGPUTransferBuffer(gpu_device, transfer_buffer);
-
-    SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(gpu_device);
-    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
-    SDL_GPUTransferBufferLocation src_v = { .transfer_buffer = transfer_buffer, .offset = 0 };
-    SDL_GPUBufferRegion dst_v = { .buffer = debug_unit_cube_vbuf, .offset = 0, .size = sizeof(unit_cube_vertices) };
-    SDL_UploadToGPUBuffer(copy_pass, &src_v, &dst_v, false);
-
-    SDL_GPUTransferBufferLocation src_i = { .transfer_buffer = transfer_buffer, .offset = sizeof(unit_cube_vertices) };
-    SDL_GPUBufferRegion dst_i = { .buffer = debug_unit_cube_ibuf, .offset = 0, .size = sizeof(unit_cube_indices) };
-    SDL_UploadToGPUBuffer(copy_pass, &src_i, &dst_i, false);
-    SDL_EndGPUCopyPass(copy_pass);
-    SDL_SubmitGPUCommandBuffer(cmd);
-    SDL_ReleaseGPUTransferBuffer(gpu_device, transfer_buffer);
+    upload_ring->UploadToBuffer(debug_unit_cube_vbuf, 0, unit_cube_vertices, sizeof(unit_cube_vertices));
+    upload_ring->UploadToBuffer(debug_unit_cube_ibuf, 0, unit_cube_indices, sizeof(unit_cube_indices));
+    upload_ring->Flush();
 }
 
 void App::Run()
@@ -401,11 +678,18 @@ void App::Run()
 
     CurrentTime = static_cast<double>(SDL_GetPerformanceCounter()) / performance_frequency;
 
+    // --frames 지정 시 Update + Render에 쓴 CPU 시간을 모아 종료할 때 출력
+    uint64 frame_start_ns = 0;
+    uint32 frame_count = 0;
+    double total_cpu_seconds = 0.0;
+    double max_cpu_seconds = 0.0;
+
     while (is_running && !quit_requested)
     {
         {
             ZoneScopedN("FrameLoop");
 
+            frame_start_ns = SDL_GetTicksNS();
             const double frame_start = static_cast<double>(SDL_GetPerformanceCounter()) / performance_frequency;
 
             // Calculate Delta Time
@@ -414,25 +698,69 @@ void App::Run()
             DeltaTime = CurrentTime - LastTime;
             TotalElapsedTime += static_cast<uint64>(DeltaTime * 1000.0);
 
-            ProcessPlatformEvents();
+            {
+                ScopedFrameStage stage(frame_telemetry, FrameStage::PlatformEvents);
+                ProcessPlatformEvents();
+            }
+
+            {
+                ScopedFrameStage stage(frame_telemetry, FrameStage::Update);
+                Update(static_cast<float>(DeltaTime));
+            }
+
+            {
+                ScopedFrameStage stage(frame_telemetry, FrameStage::Render);
+
+                // 이번 프레임 업로드를 한 번에 제출 (같은 큐이므로 렌더링보다 먼저 실행된다)
+                upload_ring->Flush();
 
-            Update(static_cast<float>(DeltaTime));
+                Render();
+            }
 
-            Render();
+            const double cpu_seconds = static_cast<double>(SDL_GetPerformanceCounter()) / performance_frequency - frame_start;
+            total_cpu_seconds += cpu_seconds;
+            max_cpu_seconds = std::max(max_cpu_seconds, cpu_seconds);
+            ++frame_count;
         }
 
         {
             ZoneScopedN("FrameSleep");
+            ScopedFrameStage stage(frame_telemetry, FrameStage::FrameSleep);
 
-            double frame_duration;
-            do
-            {
-                SDL_Delay(0);
-                const double frame_end = static_cast<double>(SDL_GetPerformanceCounter()) / performance_frequency;
-                frame_duration = frame_end - CurrentTime;
-            } while (frame_duration < TargetFrameTime);
+            UpdateFramePacer();
+            frame_pacer.WaitForNextFrame();
         }
+        frame_telemetry.Record(FrameStage::Frame, SDL_GetTicksNS() - frame_start_ns);
+        frame_telemetry.EndFrame();
         FrameMark;
+
+        if (options.max_frames > 0 && frame_count >= options.max_frames)
+        {
+            RequestQuit();
+        }
+    }
+
+    if (frame_count > 0)
+    {
+        SDL_Log(
+            "Ran %u frames (%s, %s): CPU Update+Render avg %.3f ms, max %.3f ms",
+            frame_count,
+            SDL_GetGPUDeviceDriver(gpu_device),
+            options.is_headless ? "headless" : "windowed",
+            total_cpu_seconds * 1000.0 / frame_count,
+            max_cpu_seconds * 1000.0
+        );
+
+        std::array<FrameStageStats, NumFrameStages> stage_stats;
+        frame_telemetry.ComputeStats(stage_stats);
+        for (uint32 stage = 0; stage < NumFrameStages; ++stage)
+        {
+            const FrameStageStats& stats = stage_stats[stage];
+            SDL_Log(
+                "  %-16s p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms",
+                GetFrameStageName(static_cast<FrameStage>(stage)), stats.p50_ms, stats.p95_ms, stats.p99_ms, stats.max_ms
+            );
+        }
     }
 }
 
@@ -440,14 +768,29 @@ void App::Release()
 {
     ZoneScoped;
 
+    // 파싱 중인 워커가 끝날 때까지 기다린 뒤 나머지를 정리
+    mesh_importer->CancelAll();
+    mesh_importer.reset();
+    cooked_mesh_cache.reset();
+    mesh_asset_registry.reset();
+
     SDL_WaitForGPUIdle(gpu_device);
+    ReleaseFrameFences();
 
-    gpu_resource_manager.reset();
+    upload_ring.reset(); // 예약된 복사를 제출한 뒤에 지오메트리 버퍼를 놓는다
+    geometry_buffer.reset();
+    view_contexts.clear();
+    render_workers.reset();
     pso_manager.reset();
+    shader_library.reset();
+    shader_cache.reset();
 
     // ImGui Release
     ImGui_ImplSDLGPU3_Shutdown();
-    ImGui_ImplSDL3_Shutdown();
+    if (!options.is_headless)
+    {
+        ImGui_ImplSDL3_Shutdown();
+    }
     ImGui::DestroyContext();
 
     // Windows Release
@@ -459,13 +802,17 @@ void App::Release()
     windows.clear();
 
     SDL_ReleaseGPUGraphicsPipeline(gpu_device, pipeline);
+    if (compact_pipeline)
+    {
+        SDL_ReleaseGPUGraphicsPipeline(gpu_device, compact_pipeline);
+    }
+
+    render_target_pool.reset();
 
     // GPU Device Release
     SDL_DestroyGPUDevice(gpu_device);
     gpu_device = nullptr;
 
-    asset_importer.reset();
-
     SDL_ShaderCross_Quit();
     SDL_Quit();
 }
@@ -477,7 +824,10 @@ void App::ProcessPlatformEvents()
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
-        ImGui_ImplSDL3_ProcessEvent(&event);
+        if (!options.is_headless)
+        {
+            ImGui_ImplSDL3_ProcessEvent(&event);
+        }
         switch (event.type)
         {
         case SDL_EVENT_QUIT:
@@ -495,6 +845,22 @@ void App::ProcessPlatformEvents()
             DestroyWindow(event.window.windowID);
             break;
         }
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        {
+            // 다음 Render에서 새 크기로 다시 얻는다 (같은 크기의 반납된 타겟이 있으면 재사용)
+            render_target_pool->ReleaseOwner(event.window.windowID);
+            break;
+        }
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        {
+            if (event.button.button == SDL_BUTTON_LEFT && event.button.windowID == main_window_id)
+            {
+                pick_requested = true;
+                pick_mouse_x = event.button.x;
+                pick_mouse_y = event.button.y;
+            }
+            break;
+        }
         case SDL_EVENT_WINDOW_FOCUS_GAINED:
         {
             if (SDL_Window* window = SDL_GetWindowFromID(event.window.windowID))
@@ -520,84 +886,16 @@ void App::Update(float delta_time)
     SDL_MouseButtonFlags m_buttons = SDL_GetRelativeMouseState(&x_delta, &y_delta);
     const bool* keys = SDL_GetKeyboardState(nullptr);
 
-    // Picking logic
-    if (!ImGui::GetIO().WantCaptureMouse && (SDL_GetMouseState(nullptr, nullptr) & SDL_BUTTON_MASK(SDL_BUTTON_LEFT)))
+    // Picking logic (클릭한 프레임에만 수행)
+    if (pick_requested && !ImGui::GetIO().WantCaptureMouse)
     {
-        float mouse_x, mouse_y;
-        SDL_GetMouseState(&mouse_x, &mouse_y);
-
-        int w, h;
-        SDL_GetWindowSize(GetMainWindow(), &w, &h);
-
-        Matrix4x4 view_mat = math::TransformUtility::MakeViewMatrix(
-            my_camera.position, my_camera.position + my_camera.rotation.GetForwardVector(), Vector3::UnitZ()
-        );
-        Matrix4x4 projection_mat = math::TransformUtility::MakePerspectiveMatrix(
-            Radian{ my_camera.fov },
-            static_cast<double>(w) / h,
-            0.1, 10000.0
-        );
-
-        se::Ray ray = ScreenToWorldRay(mouse_x, mouse_y, static_cast<float>(w), static_cast<float>(h), view_mat, projection_mat);
-
-        double closest_dist = std::numeric_limits<double>::max();
-        Entity closest_entity = Entity{};
-
-        for (auto [entity, transform, mesh_comp] : world.QueryEntities<Entity, const TransformComponent&, const MeshComponent&>())
-        {
-            if (!mesh_comp.mesh || !mesh_comp.mesh->mesh_data) continue;
-
-            Matrix4x4 model = math::TransformUtility::MakeModelMatrix(
-                transform.position, transform.rotation, transform.scale
-            );
-            Matrix4x4 inv_model = model.Inverse();
-
-            // Transform Ray to local space
-            Vector4 local_origin_v4 = Vector4(ray.origin.x, ray.origin.y, ray.origin.z, 1.0f) * inv_model;
-            Vector3 local_origin = Vector3(local_origin_v4.x, local_origin_v4.y, local_origin_v4.z) / local_origin_v4.w;
-
-            Vector4 local_dir_v4 = Vector4(ray.direction.x, ray.direction.y, ray.direction.z, 0.0f) * inv_model;
-            Vector3 local_dir = Vector3(local_dir_v4.x, local_dir_v4.y, local_dir_v4.z).GetNormalized();
-
-            se::Ray local_ray(local_origin, local_dir);
-
-            const AABBf& mesh_bounds = mesh_comp.mesh->mesh_data->bounds;
-            const AABB bounds_d(
-                Vector3(mesh_bounds.min.x, mesh_bounds.min.y, mesh_bounds.min.z),
-                Vector3(mesh_bounds.max.x, mesh_bounds.max.y, mesh_bounds.max.z)
-            );
-
-            double dist;
-            if (local_ray.Intersects(bounds_d, dist))
-            {
-                // To be precise, calculate world space distance
-                Vector3 hit_local = local_ray.GetPoint(dist);
-                Vector4 hit_world_v4 = Vector4(hit_local.x, hit_local.y, hit_local.z, 1.0f) * model;
-                Vector3 hit_world = Vector3(hit_world_v4.x, hit_world_v4.y, hit_world_v4.z) / hit_world_v4.w;
-
-                double world_dist = (hit_world - ray.origin).Length();
-
-                if (world_dist < closest_dist)
-                {
-                    closest_dist = world_dist;
-                    closest_entity = entity;
-                }
-            }
-        }
-
-        if (closest_entity.IsValid())
+        if (const Entity picked = PickEntity(pick_mouse_x, pick_mouse_y); picked.IsValid())
         {
-            Array<Entity> entities = world.GetAliveEntities();
-            for (int i = 0; i < static_cast<int>(entities.Len()); ++i)
-            {
-                if (entities[i] == closest_entity)
-                {
-                    selected_entity = i;
-                    break;
-                }
-            }
+            selected_entity = picked;
+            is_entity_scroll_requested = true;
         }
     }
+    pick_requested = false;
 
     if (m_buttons & SDL_BUTTON_MASK(SDL_BUTTON_RIGHT))
     {
@@ -642,9 +940,21 @@ void App::Update(float delta_time)
         SDL_SetWindowRelativeMouseMode(focused_window, false);
     }
 
+    // 이전 프레임들이 다 읽은 구간을 돌려받고 조각 모음을 진행한 뒤 이번 프레임 업로드를 받는다
+    geometry_buffer->Update(render_frame_index, 8ull * 1024 * 1024);
+    UploadImportedMeshes();
+    UpdateMeshResidency();
+
     // Start the Dear ImGui frame
     ImGui_ImplSDLGPU3_NewFrame();
-    ImGui_ImplSDL3_NewFrame();
+    if (options.is_headless)
+    {
+        ImGui::GetIO().DeltaTime = std::max(delta_time, 1.0f / 10000.0f);
+    }
+    else
+    {
+        ImGui_ImplSDL3_NewFrame();
+    }
     ImGui::NewFrame();
 
     ImGui::ShowDemoWindow();
@@ -653,54 +963,163 @@ void App::Update(float delta_time)
     {
         if (ImGui::Button("Load Mesh"))
         {
+            // 콜백은 다른 스레드에서 불릴 수 있으므로 큐에 넣기만 한다
             FileDialog::OpenFile([this](const Path& path)
             {
-                auto assets = asset_importer->Import(path);
-                if (assets.HasError())
-                {
-                    return;
-                }
-
-                for (const auto& asset : *assets)
-                {
-                    if (auto mesh = std::dynamic_pointer_cast<asset::StaticMesh>(asset))
-                    {
-                        auto loaded_mesh = std::make_shared<LoadedMesh>();
-                        loaded_mesh->id = asset::AssetId(Guid::NewGuid());
-                        loaded_mesh->name = path.FileName().ValueOr("Unknown"); // Use filename as name
-                        loaded_mesh->mesh_data = mesh;
-
-                        SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(gpu_device);
-                        if (gpu_resource_manager->UploadMesh(
-                            cmd, loaded_mesh->id,
-                            mesh->vertices.Data(), static_cast<uint32>(mesh->vertices.Len() * sizeof(Vertex)),
-                            mesh->indices.Data(), static_cast<uint32>(mesh->indices.Len() * sizeof(uint32))
-                        ))
-                        {
-                            loaded_meshes.Push(loaded_mesh);
-
-                            // Automatically spawn an entity with this mesh
-                            world.SpawnEntity()
-                                 .AddComponent<TransformComponent>()
-                                 .AddComponent<MeshComponent>(loaded_mesh);
-
-                            SDL_SubmitGPUCommandBuffer(cmd);
-                        }
-                        else
-                        {
-                             // Failed to upload
-                            SDL_CancelGPUCommandBuffer(cmd);
-                        }
-                    }
-                }
+                mesh_importer->Enqueue(path);
             });
         }
-    }
-    ImGui::End();
+        ImGui::SameLine();
+        bool is_processor_changed = ImGui::Checkbox("Optimize Meshes", &is_mesh_optimize_enabled);
+        ImGui::SameLine();
+        is_processor_changed |= ImGui::Checkbox("Generate LODs", &is_lod_generation_enabled);
+        ImGui::SameLine();
+        ImGui::BeginDisabled(compact_pipeline == nullptr);
+        is_processor_changed |= ImGui::Checkbox("Compact Vertices", &is_compact_vertex_enabled);
+        ImGui::EndDisabled();
+        if (is_processor_changed)
+        {
+            UpdateMeshProcessor();
+        }
+        if (mesh_full_bytes > 0)
+        {
+            ImGui::Text(
+                "Mesh GPU Memory: %.2f MB (%.0f%% of full format)",
+                static_cast<double>(mesh_gpu_bytes) / (1024.0 * 1024.0),
+                100.0 * static_cast<double>(mesh_gpu_bytes) / static_cast<double>(mesh_full_bytes)
+            );
+        }
 
-    ImGui::Begin("Window Pannal");
-    {
-        static FixedArray<char, 256> window_title = {};
+        // 예산을 넘으면 이 프레임 수 이상 안 그린 메쉬부터 GPU에서 내린다 (다시 보이면 쿠킹 캐시에서 올린다)
+        int32 mesh_budget_mb = static_cast<int32>(mesh_residency.GetBudget() / (1024 * 1024));
+        if (ImGui::SliderInt("Mesh Budget (MB)", &mesh_budget_mb, 16, 8192))
+        {
+            mesh_residency.SetBudget(static_cast<uint64>(mesh_budget_mb) * 1024 * 1024);
+        }
+        int32 evict_after_frames = static_cast<int32>(mesh_residency.GetMinUnusedFrames());
+        if (ImGui::SliderInt("Evict After (frames)", &evict_after_frames, static_cast<int32>(MaxFramesInFlight) + 1, 3600))
+        {
+            mesh_residency.SetMinUnusedFrames(static_cast<uint32>(evict_after_frames), MaxFramesInFlight + 1);
+        }
+
+        const MeshResidencyStats residency_stats = mesh_residency.GetStats();
+        if (residency_stats.num_resident + residency_stats.num_evicted > 0)
+        {
+            ImGui::Text(
+                "Mesh Residency: %.1f / %.1f MB%s, %u resident, %u evicted (%u reloading), %llu evictions, %llu reloads",
+                static_cast<double>(residency_stats.resident_bytes) / (1024.0 * 1024.0),
+                static_cast<double>(residency_stats.budget_bytes) / (1024.0 * 1024.0),
+                residency_stats.is_over_budget ? " (over budget)" : "",
+                residency_stats.num_resident, residency_stats.num_evicted, residency_stats.num_reloading,
+                static_cast<unsigned long long>(residency_stats.total_evictions),
+                static_cast<unsigned long long>(residency_stats.total_reloads)
+            );
+        }
+
+        const GeometryBufferStats geometry_stats = geometry_buffer->GetStats();
+        if (geometry_stats.num_buffers > 0)
+        {
+            ImGui::Text(
+                "Geometry Buffer: %.1f / %.1f MB in %u buffers, %.0f%% fragmented (%u free blocks, %.1f MB pending free)",
+                static_cast<double>(geometry_stats.used_bytes) / (1024.0 * 1024.0),
+                static_cast<double>(geometry_stats.capacity_bytes) / (1024.0 * 1024.0),
+                geometry_stats.num_buffers, geometry_stats.fragmentation * 100.0f, geometry_stats.num_free_blocks,
+                static_cast<double>(geometry_stats.pending_free_bytes) / (1024.0 * 1024.0)
+            );
+            ImGui::Text(
+                "Geometry Compaction: %u moves, %.1f MB moved",
+                geometry_stats.num_moves, static_cast<double>(geometry_stats.moved_bytes) / (1024.0 * 1024.0)
+            );
+        }
+
+        const MeshAssetRegistryStats registry_stats = mesh_asset_registry->GetStats();
+        if (registry_stats.num_assets + registry_stats.released_assets > 0)
+        {
+            ImGui::Text(
+                "Mesh Assets: %u files, %u meshes, %u shared imports (%.2f MB not re-uploaded), %u released",
+                registry_stats.num_assets, registry_stats.num_meshes, registry_stats.shared_imports,
+                static_cast<double>(registry_stats.shared_bytes) / (1024.0 * 1024.0),
+                registry_stats.released_assets
+            );
+        }
+
+        const CookedMeshCacheStats cooked_stats = cooked_mesh_cache->GetStats();
+        if (cooked_stats.hits + cooked_stats.misses > 0)
+        {
+            ImGui::Text(
+                "Mesh Cache: %u hits, %u misses (%u corrupted), %u stored, %.1f MB mapped in %.1f ms",
+                cooked_stats.hits, cooked_stats.misses, cooked_stats.corrupted, cooked_stats.stores,
+                static_cast<double>(cooked_stats.loaded_bytes) / (1024.0 * 1024.0),
+                cooked_stats.load_seconds * 1000.0
+            );
+        }
+
+        mesh_importer->GetStatuses(import_statuses);
+        if (!import_statuses.empty())
+        {
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel All"))
+            {
+                mesh_importer->CancelAll();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Clear Finished"))
+            {
+                mesh_importer->ClearFinished();
+            }
+
+            ImGui::Text("Workers: %u", mesh_importer->GetNumWorkers());
+            ImGui::Text(
+                "Upload Ring: %.1f / %.1f MB, %u in flight, %llu stalls",
+                upload_ring->GetUsedBytes() / (1024.0 * 1024.0),
+                upload_ring->GetCapacity() / (1024.0 * 1024.0),
+                upload_ring->GetNumInFlight(),
+                static_cast<unsigned long long>(upload_ring->GetNumStalls())
+            );
+            ImGui::Separator();
+
+            for (const MeshImportStatus& status : import_statuses)
+            {
+                ImGui::PushID(static_cast<int>(status.job_id));
+
+                // 파싱 진행률은 알 수 없으므로 단계 기준으로 표시
+                const char* stage_name = "";
+                float progress = 0.0f;
+                switch (status.stage)
+                {
+                case MeshImportStage::Queued:    stage_name = "Queued";    progress = 0.0f;  break;
+                case MeshImportStage::Importing: stage_name = "Importing"; progress = 0.33f; break;
+                case MeshImportStage::Ready:     stage_name = "Uploading"; progress = 0.66f; break;
+                case MeshImportStage::Done:      stage_name = "Done";      progress = 1.0f;  break;
+                case MeshImportStage::Failed:    stage_name = "Failed";    progress = 1.0f;  break;
+                case MeshImportStage::Cancelled: stage_name = "Cancelled"; progress = 1.0f;  break;
+                }
+
+                ImGui::TextUnformatted(status.name.CStr());
+                const std::string overlay = std::format("{} ({:.2f}s)", stage_name, status.elapsed_seconds);
+                ImGui::ProgressBar(progress, ImVec2(-80.0f, 0.0f), overlay.c_str());
+
+                const bool is_cancelable = status.stage == MeshImportStage::Queued
+                                        || status.stage == MeshImportStage::Importing
+                                        || status.stage == MeshImportStage::Ready;
+                if (is_cancelable)
+                {
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancel"))
+                    {
+                        mesh_importer->Cancel(status.job_id);
+                    }
+                }
+
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::End();
+
+    ImGui::Begin("Window Pannal");
+    {
+        static FixedArray<char, 256> window_title = {};
         static int32 window_x = 100;
         static int32 window_y = 100;
         static int32 window_width = 1280;
@@ -735,36 +1154,70 @@ void App::Update(float delta_time)
     {
         ImGui::Text("FPS: %.3f", ImGui::GetIO().Framerate);
         ImGui::Text("FPS: %.3f", 1 / delta_time);
+        ImGui::Text(
+            "Transforms: %u cached, %u recomputed",
+            transform_cache.GetNumCached(),
+            transform_cache.GetNumRecomputed()
+        );
+        ImGui::Text("Frustum Culling: %u visible, %u culled", cull_stats.visible, cull_stats.culled);
+
+        const RenderTargetPoolStats target_stats = render_target_pool->GetStats();
+        ImGui::Text(
+            "Render Targets: %u active (%.1f MB), %u free (%.1f MB), %u created, %u reused",
+            target_stats.num_active, static_cast<double>(target_stats.active_bytes) / (1024.0 * 1024.0),
+            target_stats.num_free, static_cast<double>(target_stats.free_bytes) / (1024.0 * 1024.0),
+            target_stats.num_created, target_stats.num_reused
+        );
 
         static Array component_names {
              "TransformComponent", "MeshComponent"
         };
-        Array<Entity> entities = world.GetAliveEntities();
+
+        // 목록은 엔티티가 바뀐 프레임에만 다시 받는다. 선택은 핸들로 들고 있다가 지워졌으면 해제한다
+        entity_list.Sync(world);
+        if (!entity_list.Contains(selected_entity))
+        {
+            selected_entity = Entity{};
+        }
 
         ImGui::SeparatorText("Entity Pannal");
         static int count = 0;
         ImGui::InputInt("##Count", &count);
         ImGui::SameLine();
-        if (ImGui::Button("Create Entities"))
+        if (ImGui::Button("Create Entities") && count > 0)
         {
+            // 새 엔티티는 다음 프레임에 한꺼번에 들어오므로 앱 쪽 엔티티별 배열을 미리 늘려 둔다
+            // id로 찾는 배열은 엔티티 수가 아니라 새로 나올 수 있는 가장 큰 id까지 잡아야 다시 늘지 않는다
+            const size_t id_bound = static_cast<size_t>(entity_list.GetIdBound()) + static_cast<size_t>(count);
+            transform_cache.Reserve(id_bound, entity_list.Len() + static_cast<size_t>(count));
+            picking_proxies.reserve(id_bound);
+
             for (int i = 0; i < count; ++i)
             {
                 world.SpawnEntity()
                      .AddComponent<TransformComponent>();
             }
+            entity_list.MarkDirty();
         }
         if (ImGui::Button("Create Entity"))
         {
             world.SpawnEntity()
                  .AddComponent<TransformComponent>();
+            entity_list.MarkDirty();
         }
         ImGui::SameLine();
         if (ImGui::Button("Delete Entity") || keys[SDL_SCANCODE_DELETE])
         {
-            if (selected_entity >= 0 && selected_entity < entities.Len())
+            if (selected_entity.IsValid())
             {
-                world.DestroyEntity(entities[selected_entity]);
-                selected_entity = -1;
+                if (Optional<MeshComponent&> mesh_comp_opt = world.TryGetComponent<MeshComponent>(selected_entity))
+                {
+                    ReleaseMeshAsset(mesh_comp_opt.Value().mesh);
+                }
+                transform_cache.MarkRemoved(selected_entity);
+                world.DestroyEntity(selected_entity);
+                selected_entity = Entity{};
+                entity_list.MarkDirty();
             }
         }
 
@@ -772,62 +1225,90 @@ void App::Update(float delta_time)
         ImGui::SameLine();
         if (ImGui::Button("Add Component"))
         {
-            if (selected_entity >= 0 && selected_entity < entities.Len())
+            if (selected_entity.IsValid())
             {
                 if (selected_component == 0)
                 {
-                    world.AddComponent<TransformComponent>(entities[selected_entity]);
+                    world.AddComponent<TransformComponent>(selected_entity);
                 }
                 else if (selected_component == 1)
                 {
                     // Use the first loaded mesh if available
-                    std::shared_ptr<LoadedMesh> default_mesh = loaded_meshes.IsEmpty() ? nullptr : loaded_meshes[0];
-                    world.AddComponent<MeshComponent>(entities[selected_entity], default_mesh);
+                    // 같은 메쉬로 바꿀 때 참조가 0이 되지 않도록 새 메쉬를 먼저 잡고 이전 메쉬를 놓는다
+                    std::shared_ptr<LoadedMesh> default_mesh = mesh_asset_registry->GetFirstMesh();
+                    if (default_mesh)
+                    {
+                        mesh_asset_registry->Acquire(default_mesh->asset_key);
+                    }
+                    if (Optional<MeshComponent&> mesh_comp_opt = world.TryGetComponent<MeshComponent>(selected_entity))
+                    {
+                        MeshComponent& mesh_comp = mesh_comp_opt.Value();
+                        ReleaseMeshAsset(mesh_comp.mesh);
+                        mesh_comp.mesh = std::move(default_mesh);
+                    }
+                    else
+                    {
+                        world.AddComponent<MeshComponent>(selected_entity, default_mesh);
+                    }
                 }
+                transform_cache.MarkDirty(selected_entity);
             }
         }
 
-        Array<String> entity_names;
-        Array<const char*> temp_entity_names;
-
-        entity_names.Reserve(entities.Len());
-        temp_entity_names.Reserve(entity_names.Len());
-        std::ranges::for_each(entities, [&entity_names, &temp_entity_names](Entity entity)
+        ImGui::SeparatorText("Entity List");
+        ImGui::Text("Entity Count: %u", entity_list.Len());
+        if (ImGui::BeginListBox("##EntityList", ImVec2(-FLT_MIN, 10.25f * ImGui::GetTextLineHeightWithSpacing())))
         {
-            String name = String::Format("Entity {}, Gen: {}", entity.GetId(), entity.GetGeneration());
-            temp_entity_names.Push(name.CStr());
-            entity_names.Push(std::move(name));
-        });
+            // 보이는 줄의 이름만 만든다. 피킹으로 선택이 바뀌면 그 줄까지 포함시켜 스크롤한다
+            const std::optional<uint32> scroll_index = is_entity_scroll_requested ? entity_list.FindIndex(selected_entity) : std::nullopt;
+            is_entity_scroll_requested = false;
 
-        ImGui::SeparatorText("Entity List");
-        ImGui::Text("Entity Count: %d", static_cast<int>(entities.Len()));
-        ImGui::ListBox(
-            "##EntityList",
-            &selected_entity,
-            temp_entity_names.Data(),
-            static_cast<int>(entity_names.Len()),
-            10
-        );
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(entity_list.Len()));
+            if (scroll_index)
+            {
+                clipper.IncludeItemByIndex(static_cast<int>(*scroll_index));
+            }
+            while (clipper.Step())
+            {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+                {
+                    const Entity entity = entity_list[static_cast<uint32>(i)];
+                    const bool is_selected = entity == selected_entity;
+                    if (ImGui::Selectable(std::format("Entity {}, Gen: {}", entity.GetId(), entity.GetGeneration()).c_str(), is_selected))
+                    {
+                        selected_entity = entity;
+                    }
+                    if (is_selected && scroll_index)
+                    {
+                        ImGui::SetScrollHereY();
+                    }
+                }
+            }
+            ImGui::EndListBox();
+        }
 
         ImGui::SeparatorText("Entity Property");
-        if (selected_entity >= 0 && selected_entity < entities.Len())
+        if (selected_entity.IsValid())
         {
-            const Entity entity = entities[selected_entity];
+            const Entity entity = selected_entity;
             ImGui::TextUnformatted(std::format("Selected Entity ID: {}", entity.GetId()).c_str());
 
             if (Optional<TransformComponent&> transform_comp_opt = world.TryGetComponent<TransformComponent>(entity))
             {
                 auto& [quat, position, scale] = transform_comp_opt.Value();
-                ImGui::DragScalarN("Position", ImGuiDataType_Double, &position.x, 3, 1.0f);
+                bool is_transform_edited = ImGui::DragScalarN("Position", ImGuiDataType_Double, &position.x, 3, 1.0f);
 
                 const Rotator old_rotator = quat.ToRotator();
 
                 Degree<double> refl[] = { old_rotator.pitch, old_rotator.roll, old_rotator.yaw };
-                ImGui::DragScalarN("Rotation", ImGuiDataType_Double, &refl[0].value, 3, 1.0f);
+                const bool is_rotation_edited = ImGui::DragScalarN("Rotation", ImGuiDataType_Double, &refl[0].value, 3, 1.0f);
 
                 static bool local_rotation = false;
                 ImGui::Checkbox("Local Rotation", &local_rotation);
 
+                // 값이 그대로일 때 다시 정규화하면 캐시가 모르는 사이 쿼터니언이 조금씩 바뀐다
+                if (is_rotation_edited)
                 {
                     Vector3 axis_x, axis_y, axis_z;
                     if (local_rotation)
@@ -850,7 +1331,13 @@ void App::Update(float delta_time)
                 }
 
                 constexpr double min_value = 0.0;
-                ImGui::DragScalarN("Scale", ImGuiDataType_Double, &scale.x, 3, 1.0f, &min_value);
+                is_transform_edited |= is_rotation_edited;
+                is_transform_edited |= ImGui::DragScalarN("Scale", ImGuiDataType_Double, &scale.x, 3, 1.0f, &min_value);
+
+                if (is_transform_edited)
+                {
+                    transform_cache.MarkDirty(entity);
+                }
             }
 
             if (Optional<MeshComponent&> mesh_comp_opt = world.TryGetComponent<MeshComponent>(entity))
@@ -873,6 +1360,164 @@ void App::Update(float delta_time)
     }
     ImGui::End();
 
+    ImGui::Begin("Frame Pacing");
+    {
+        static constexpr const char* mode_names[] = { "Unlimited", "Fixed", "VSync", "Adaptive" };
+        int32 mode_index = static_cast<int32>(frame_pacer.GetMode());
+        if (ImGui::Combo("Mode", &mode_index, mode_names, static_cast<int>(std::size(mode_names))))
+        {
+            SetFramePacingMode(static_cast<FramePacingMode>(mode_index));
+        }
+
+        if (frame_pacer.GetMode() == FramePacingMode::Fixed)
+        {
+            int32 target_fps = static_cast<int32>(TargetFps);
+            if (ImGui::DragInt("Target FPS", &target_fps, 1.0f, 10, 1000))
+            {
+                SetTargetFps(static_cast<uint32>(target_fps));
+            }
+        }
+
+        // 1은 지연이 가장 짧고, 3은 CPU와 GPU가 가장 많이 겹친다
+        int32 frames_in_flight_value = static_cast<int32>(frames_in_flight);
+        if (ImGui::SliderInt("Frames In Flight", &frames_in_flight_value, 1, static_cast<int32>(MaxFramesInFlight)))
+        {
+            SetFramesInFlight(static_cast<uint32>(frames_in_flight_value));
+        }
+        ImGui::Text(
+            "Skipped: %llu frames (GPU behind), %llu windows (no image), %llu hidden",
+            static_cast<unsigned long long>(present_stats.skipped_frames),
+            static_cast<unsigned long long>(present_stats.skipped_windows),
+            static_cast<unsigned long long>(present_stats.hidden_windows)
+        );
+
+        const FramePacingStats stats = frame_pacer.GetStats();
+        ImGui::Text("Frame: %.3f ms (target %.3f ms)", stats.mean_frame_ms, stats.target_ms);
+        ImGui::Text(
+            "Jitter: mean %.3f ms, p99 %.3f ms, max %.3f ms",
+            stats.mean_abs_error_ms, stats.p99_abs_error_ms, stats.max_abs_error_ms
+        );
+        ImGui::Text(
+            "Sleep %.0f%%, Spin %.1f%% (threshold %.2f ms)",
+            stats.sleep_ratio * 100.0, stats.spin_ratio * 100.0, stats.spin_threshold_ms
+        );
+    }
+    ImGui::End();
+
+    ImGui::Begin("Mesh LOD");
+    {
+        ImGui::SliderInt("Force LOD", &forced_lod, -1, static_cast<int32>(MaxMeshLods), forced_lod < 0 ? "Auto" : "%d");
+
+        // LOD i -> i+1 로 넘어가는 화면 높이 비율, 뒤 LOD일수록 작아야 한다
+        ImGui::TextUnformatted("Screen size thresholds (bounding sphere / screen height)");
+        for (uint32 i = 0; i < lod_screen_thresholds.size(); ++i)
+        {
+            const float max_value = i == 0 ? 4.0f : lod_screen_thresholds[i - 1];
+            const float min_value = i + 1 < lod_screen_thresholds.size() ? lod_screen_thresholds[i + 1] : 0.0f;
+            ImGui::DragFloat(
+                std::format("LOD{} -> LOD{}", i, i + 1).c_str(), &lod_screen_thresholds[i], 0.005f, min_value, max_value, "%.3f"
+            );
+        }
+
+        std::string counts;
+        for (uint32 i = 0; i < lod_instance_counts.size(); ++i)
+        {
+            counts += std::format("{}LOD{}: {}", i == 0 ? "" : ", ", i, lod_instance_counts[i]);
+        }
+        ImGui::Text("Instances (main view): %s", counts.c_str());
+
+        if (ImGui::BeginTable("Meshes", 3 + MaxMeshLods, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY))
+        {
+            ImGui::TableSetupColumn("Mesh");
+            ImGui::TableSetupColumn("Refs");
+            for (uint32 i = 0; i <= MaxMeshLods; ++i)
+            {
+                ImGui::TableSetupColumn(std::format("LOD{} tris", i).c_str());
+            }
+            ImGui::TableHeadersRow();
+
+            mesh_asset_registry->ForEachMesh([](const std::shared_ptr<LoadedMesh>& loaded_mesh, uint32 num_references)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(loaded_mesh->name.CStr());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", num_references);
+
+                const std::vector<GpuMeshLod>& lods = loaded_mesh->gpu_format.lods;
+                for (uint32 i = 0; i <= MaxMeshLods; ++i)
+                {
+                    ImGui::TableNextColumn();
+                    if (i < lods.size())
+                    {
+                        ImGui::Text("%u", lods[i].num_triangles);
+                        if (i > 0 && ImGui::IsItemHovered())
+                        {
+                            ImGui::SetTooltip("error %.4f", lods[i].error);
+                        }
+                    }
+                }
+            });
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+
+    ImGui::Begin("Frame Telemetry");
+    {
+        // 정렬 비용이 있으므로 통계는 0.25초마다 갱신
+        if (CurrentTime - telemetry_refresh_time >= 0.25)
+        {
+            telemetry_refresh_time = CurrentTime;
+            frame_telemetry.ComputeStats(telemetry_stats);
+        }
+
+        if (ImGui::BeginTable("Stages", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+        {
+            for (const char* header : { "Stage (ms)", "mean", "p50", "p95", "p99", "max" })
+            {
+                ImGui::TableSetupColumn(header);
+            }
+            ImGui::TableHeadersRow();
+
+            for (uint32 stage = 0; stage < NumFrameStages; ++stage)
+            {
+                const FrameStageStats& stats = telemetry_stats[stage];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(GetFrameStageName(static_cast<FrameStage>(stage)));
+                for (const double value : { stats.mean_ms, stats.p50_ms, stats.p95_ms, stats.p99_ms, stats.max_ms })
+                {
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", value);
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        // 실행 파일 옆에 프레임 번호를 붙여 저장
+        const std::filesystem::path export_stem = std::filesystem::path(SDL_GetBasePath())
+                                                / std::format("FrameTelemetry_{}", frame_telemetry.GetNumFramesRecorded());
+        if (ImGui::Button("Export CSV"))
+        {
+            std::filesystem::path path = export_stem;
+            path += ".csv";
+            if (frame_telemetry.ExportCsv(path))
+            {
+                SDL_Log("Frame telemetry exported: %s", path.string().c_str());
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export JSON"))
+        {
+            std::filesystem::path path = export_stem;
+            path += ".json";
+            if (frame_telemetry.ExportJson(path))
+            {
+                SDL_Log("Frame telemetry exported: %s", path.string().c_str());
+            }
+        }
+    }
+    ImGui::End();
+
     ImGui::Begin("Camera");
     {
         if (ImGui::Button("Reset Camera"))
@@ -905,238 +1550,857 @@ void App::Update(float delta_time)
         }
     }
     ImGui::End();
+
+    // 새로 만든 엔티티는 목록을 다시 받으면서 가려내 캐시에 알린다 (월드 전체를 다시 확인하지 않는다)
+    entity_list.Sync(world);
+    for (const Entity entity : entity_list.GetSpawnedEntities())
+    {
+        if (entity_list.Contains(entity))
+        {
+            transform_cache.MarkDirty(entity);
+        }
+    }
+    entity_list.ClearSpawnedEntities();
+
+    // 이번 프레임의 컴포넌트 수정이 끝난 뒤 바뀐 Transform만 다시 계산
+    transform_cache.Update(world);
+    SyncPickingTree();
 }
 
-void App::Render() const
+void App::UpdateMeshProcessor()
 {
-    ZoneScoped;
+    // 설정마다 쿠킹 결과가 다르므로 설정 조합을 캐시 키에 넣는다
+    const uint64 settings_key = (is_mesh_optimize_enabled ? 1u : 0u)
+                              | (is_lod_generation_enabled ? 2u : 0u)
+                              | (is_compact_vertex_enabled ? 4u : 0u);
+    mesh_importer->SetMeshProcessor(
+        MakeMeshProcessor(is_mesh_optimize_enabled, is_lod_generation_enabled, is_compact_vertex_enabled),
+        settings_key
+    );
+}
 
-    for (const auto& [window_id, window] : windows)
-    {
-        // Command Buffer 가져오기
-        SDL_GPUCommandBuffer* command_buffer = SDL_AcquireGPUCommandBuffer(gpu_device);
+void App::UploadImportedMeshes()
+{
+    ZoneScoped;
 
-        // Swapchain Texture 가져오기 (화면에 그릴 캔버스 역할)
-        SDL_GPUTexture* swapchain_texture;
-        SDL_WaitAndAcquireGPUSwapchainTexture(command_buffer, window, &swapchain_texture, nullptr, nullptr);
+    // 한 프레임에 올리는 양을 제한해 큰 파일이 여러 개 끝나도 프레임이 튀지 않게 한다
+    // (한 작업의 메쉬는 나눠 올리지 않으므로 예산을 넘는 작업도 한 프레임에 하나는 처리된다)
+    constexpr uint64 upload_budget_bytes = 32ull * 1024 * 1024;
 
-        // Rendering
-        ImGui::Render();
-        ImDrawData* draw_data = ImGui::GetDrawData();
-        const bool is_minimized = (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f);
+    uint64 uploaded_bytes = 0;
 
-        if (swapchain_texture && !is_minimized)
+    // 압축 정점 / 16비트 인덱스로 워커에서 인코딩됐거나 쿠킹 파일을 매핑한 바이트
+    // 후처리가 인코딩하지 않았으면 여기서 인코딩한다
+    // LOD 인덱스는 같은 슬라이스의 인덱스 영역 뒤에 붙는다
+    // 이번 프레임의 다른 업로드와 같은 Command Buffer로 제출되며, CPU 쪽 데이터는 result와 함께 버려진다
+    auto upload_mesh = [this](LoadedMesh& loaded_mesh, ImportedMesh& imported) -> bool
+    {
+        GpuMeshData& gpu = imported.gpu;
+        if (!gpu.IsValid() && imported.mesh)
         {
-            if (window_id == main_window_id)
-            {
-                ImGui_ImplSDLGPU3_PrepareDrawData(draw_data, command_buffer);
-            }
+            gpu = MakeGpuMeshData(*imported.mesh, imported.lods, is_compact_vertex_enabled);
+        }
 
-            constexpr SDL_FColor clear_color = { 0.25f, 0.25f, 0.25f, 1.0f };
-
-            SDL_GPUColorTargetInfo target_info = {};
-            target_info.texture = swapchain_texture;
-            target_info.clear_color = clear_color;
-            target_info.load_op = SDL_GPU_LOADOP_CLEAR;
-            target_info.store_op = SDL_GPU_STOREOP_STORE;
-            target_info.mip_level = 0;
-            target_info.layer_or_depth_plane = 0;
-            target_info.cycle = false;
-
-            SDL_GPUDepthStencilTargetInfo depth_stencil_target_info = {
-                .texture = depth_texture,
-                .clear_depth = 1.0f,
-                .load_op = SDL_GPU_LOADOP_CLEAR,
-                .store_op = SDL_GPU_STOREOP_STORE,
-                .cycle = false,
-            };
+        // 매핑한 경우에도 여기서 업로드 링으로 바로 복사된다
+        const uint32 vertex_stride = gpu.format.is_compact ? sizeof(CompactVertex) : sizeof(Vertex);
+        loaded_mesh.geometry = gpu.IsValid()
+            ? geometry_buffer->Upload(gpu.vertex_data, vertex_stride, gpu.index_data, gpu.format.index_element_size)
+            : GeometryBuffer::InvalidHandle;
+        if (loaded_mesh.geometry == GeometryBuffer::InvalidHandle)
+        {
+            return false;
+        }
+        loaded_mesh.bounds = gpu.bounds;
+        loaded_mesh.gpu_format = std::move(gpu.format);
+        loaded_mesh.gpu_bytes = gpu.vertex_data.size() + gpu.index_data.size();
+        loaded_mesh.full_format_bytes = gpu.full_format_bytes;
+
+        // 통계는 지금 GPU에 올라가 있는 메쉬만 센다. 내리거나 해제할 때 다시 뺀다
+        mesh_gpu_bytes += loaded_mesh.gpu_bytes;
+        mesh_full_bytes += loaded_mesh.full_format_bytes;
+        return true;
+    };
 
-            SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(command_buffer, &target_info, 1, &depth_stencil_target_info);
+    MeshImportResult result;
+    while (uploaded_bytes < upload_budget_bytes && mesh_importer->PopReady(result))
+    {
+        // 예산 때문에 내려갔던 메쉬를 같은 id로 다시 올린다. 엔티티들은 이미 같은 LoadedMesh를 들고 있다
+        // (같은 파일의 메쉬가 여러 번 요청됐으면 먼저 도착한 결과가 그 사이 요청된 것까지 채운다)
+        if (result.is_reload)
+        {
+            bool is_succeeded = !result.meshes.empty();
+            for (const std::shared_ptr<LoadedMesh>& loaded_mesh : mesh_asset_registry->Find(result.asset_key))
             {
-                SDL_BindGPUGraphicsPipeline(render_pass, pipeline);
+                if (loaded_mesh->residency != MeshResidencyState::Reloading) continue;
 
-                Matrix4x4 vp_mat;
+                const uint32 mesh_index = loaded_mesh->asset_mesh_index;
+                if (mesh_index < result.meshes.size() && upload_mesh(*loaded_mesh, result.meshes[mesh_index]))
                 {
-                    Matrix4x4 view_mat = math::TransformUtility::MakeViewMatrix(
-                        my_camera.position, my_camera.position + my_camera.rotation.GetForwardVector(), Vector3::UnitZ()
-                    );
-                    Matrix4x4 projection_mat = math::TransformUtility::MakePerspectiveMatrix(
-                        Radian{ my_camera.fov },
-                        static_cast<double>(draw_data->DisplaySize.x / draw_data->DisplaySize.y),
-                        0.1, 10000.0
-                    );
-
-                    vp_mat = view_mat * projection_mat;
+                    uploaded_bytes += loaded_mesh->gpu_bytes;
+                    mesh_residency.OnUploaded(loaded_mesh, render_frame_index);
                 }
-
-                auto render_mesh = [&](const Matrix4x4& model, const std::shared_ptr<LoadedMesh>& mesh)
+                else
                 {
-                    if (!mesh || !mesh->mesh_data) return;
+                    mesh_residency.OnReloadFailed(*loaded_mesh);
+                    is_succeeded = false;
+                }
+            }
+            mesh_importer->MarkDone(result.job_id, is_succeeded);
+            continue;
+        }
 
-                    const GpuBufferSlice& slice = gpu_resource_manager->GetSlice(mesh->id);
-                    if (!slice.IsValid()) return;
+        // 같은 내용 / 같은 설정의 원본이 이미 올라가 있으면 그 메쉬와 GPU 슬라이스를 같이 쓴다
+        // (동시에 임포트한 같은 파일은 워커가 둘 다 읽으므로 여기서 나중 것을 버린다)
+        const std::vector<std::shared_ptr<LoadedMesh>> shared_meshes = mesh_asset_registry->Share(result.asset_key);
+        if (!shared_meshes.empty() || result.is_registered)
+        {
+            for (const std::shared_ptr<LoadedMesh>& loaded_mesh : shared_meshes)
+            {
+                world.SpawnEntity()
+                     .AddComponent<TransformComponent>()
+                     .AddComponent<MeshComponent>(loaded_mesh);
+            }
+            if (!shared_meshes.empty())
+            {
+                mesh_asset_registry->Acquire(result.asset_key, static_cast<uint32>(shared_meshes.size()));
+            }
+            entity_list.MarkDirty();
+            mesh_importer->MarkDone(result.job_id, !shared_meshes.empty());
+            continue;
+        }
 
-                    Matrix4x4 mvp = model * vp_mat;
-                    Matrix4x4f mvpf;
-                    for (int i = 0; i < 16; ++i)
-                    {
-                        const double* value = mvp.GetData() + i;
-                        *(mvpf.GetData() + i) = static_cast<float>(*value);
-                    }
+        bool is_succeeded = true;
+        std::vector<std::shared_ptr<LoadedMesh>> new_meshes;
+        uint64 new_gpu_bytes = 0;
+        for (uint32 mesh_index = 0; mesh_index < result.meshes.size(); ++mesh_index)
+        {
+            ImportedMesh& imported = result.meshes[mesh_index];
 
-                    SDL_PushGPUVertexUniformData(command_buffer, 0, &mvpf, sizeof(mvpf));
-                    SDL_FColor color = { 0.0f, 0.0f, 0.0f, 0.0f };
-                    SDL_PushGPUFragmentUniformData(command_buffer, 0, &color, sizeof(color));
-
-                    // Vertex Buffer 바인딩
-                    const SDL_GPUBufferBinding vertex_binding = {
-                        .buffer = slice.buffer,
-                        .offset = slice.offset
-                    };
-                    SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
-
-                    // Index Buffer 바인딩
-                    const SDL_GPUBufferBinding index_binding = {
-                        .buffer = slice.buffer,
-                        .offset = slice.index_offset
-                    };
-                    SDL_BindGPUIndexBuffer(render_pass, &index_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-
-                    // Draw Sections
-                    for (const auto& section : mesh->mesh_data->sections)
-                    {
-                        SDL_DrawGPUIndexedPrimitives(render_pass, section.index_count, 1, section.index_start, 0, 0);
-                    }
-                };
+            auto loaded_mesh = std::make_shared<LoadedMesh>();
+            loaded_mesh->id = asset::AssetId(Guid::NewGuid());
+            loaded_mesh->name = result.name; // Use filename as name
+            loaded_mesh->source_path = result.path;
+            loaded_mesh->asset_key = result.asset_key;
+            loaded_mesh->asset_mesh_index = mesh_index;
 
-                // 임시 코드
-                static bool is_first = true;
-                if (is_first)
-                {
-                    world.AddSystem<UpdatePhase>([&](Query<const TransformComponent&, const MeshComponent&> query)
-                    {
-                        for (const auto& [transform_comp, mesh_comp] : query)
-                        {
-                            Matrix4x4 model = math::TransformUtility::MakeModelMatrix(
-                                transform_comp.position, transform_comp.rotation, transform_comp.scale
-                            );
-                            render_mesh(model, mesh_comp.mesh);
-                        }
-                    });
-                    is_first = false;
-                }
+            if (!upload_mesh(*loaded_mesh, imported))
+            {
+                // Failed to upload
+                is_succeeded = false;
+                continue;
+            }
+            uploaded_bytes += loaded_mesh->gpu_bytes;
 
-                // 임시 코드
-                world.RunPhase<UpdatePhase>();
+            new_gpu_bytes += loaded_mesh->gpu_bytes;
+            new_meshes.push_back(loaded_mesh);
+            mesh_residency.OnUploaded(loaded_mesh, render_frame_index);
 
-                // --- AABB 직접 렌더링 구현 ---
-                SDL_BindGPUGraphicsPipeline(render_pass, line_pipeline);
-                
-                const SDL_GPUBufferBinding v_binding = { .buffer = debug_unit_cube_vbuf, .offset = 0 };
-                SDL_BindGPUVertexBuffers(render_pass, 0, &v_binding, 1);
-                const SDL_GPUBufferBinding i_binding = { .buffer = debug_unit_cube_ibuf, .offset = 0 };
-                SDL_BindGPUIndexBuffer(render_pass, &i_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+            // Automatically spawn an entity with this mesh
+            world.SpawnEntity()
+                 .AddComponent<TransformComponent>()
+                 .AddComponent<MeshComponent>(loaded_mesh);
+        }
+        if (!new_meshes.empty())
+        {
+            entity_list.MarkDirty();
+        }
 
-                for (auto [transform, mesh_comp] : world.QueryEntities<const TransformComponent&, const MeshComponent&>())
-                {
-                    if (!mesh_comp.mesh || !mesh_comp.mesh->mesh_data) continue;
-
-                    const AABBf& bounds = mesh_comp.mesh->mesh_data->bounds;
-                    Matrix4x4 aabb_local = math::TransformUtility::MakeFromScale(Vector3(bounds.GetSize().x, bounds.GetSize().y, bounds.GetSize().z)) * 
-                                          math::TransformUtility::MakeFromTranslation(Vector3(bounds.min.x, bounds.min.y, bounds.min.z));
-                    Matrix4x4 model = math::TransformUtility::MakeModelMatrix(transform.position, transform.rotation, transform.scale);
-                    Matrix4x4 mvp = aabb_local * model * vp_mat;
-                    Matrix4x4f mvpf;
-                    for (int i = 0; i < 16; ++i) mvpf.GetData()[i] = (float)mvp.GetData()[i];
-
-                    SDL_PushGPUVertexUniformData(command_buffer, 0, &mvpf, sizeof(mvpf));
-                    
-                    // AABB 색상 (초록색, 투명도 조절용 a=1.0)
-                    SDL_FColor aabb_color = { 0.0f, 1.0f, 0.0f, 1.0f };
-                    SDL_PushGPUFragmentUniformData(command_buffer, 0, &aabb_color, sizeof(aabb_color));
-
-                    SDL_DrawGPUIndexedPrimitives(render_pass, 24, 1, 0, 0, 0); // Line indices
-                }
+        // 메쉬마다 엔티티를 하나씩 만들었으므로 참조 수는 메쉬 수
+        // 하나도 못 올렸으면 등록하지 않는다. 빈 항목이 남으면 이 파일을 다시 임포트해도 공유 경로로 빠져 아무것도 만들지 않는다
+        const uint32 num_spawned = static_cast<uint32>(new_meshes.size());
+        if (num_spawned > 0)
+        {
+            mesh_asset_registry->Register(result.asset_key, std::move(new_meshes), new_gpu_bytes);
+            mesh_asset_registry->Acquire(result.asset_key, num_spawned);
+        }
+        mesh_importer->MarkDone(result.job_id, is_succeeded);
+    }
+}
 
-                // --- 기즈모 렌더링 ---
-                if (selected_entity >= 0)
-                {
-                    Array<Entity> entities = world.GetAliveEntities();
-                    if (selected_entity < (int)entities.Len())
-                    {
-                        Entity entity = entities[selected_entity];
-                        if (auto transform_opt = world.TryGetComponent<TransformComponent>(entity))
-                        {
-                            SDL_BindGPUGraphicsPipeline(render_pass, gizmo_pipeline);
-
-                            auto& transform = transform_opt.Value();
-                            Vector3 pos = transform.position;
-                            float length = 3.0f;
-                            float thickness = 0.1f;
-
-                            auto draw_solid_axis = [&](const Vector3& scale, const SDL_FColor& color)
-                            {
-                                Matrix4x4 mat = math::TransformUtility::MakeFromScale(scale) * 
-                                                 math::TransformUtility::MakeFromTranslation(pos);
-                                Matrix4x4 mvp = mat * vp_mat;
-                                Matrix4x4f mvpf;
-                                for (int i = 0; i < 16; ++i) mvpf.GetData()[i] = (float)mvp.GetData()[i];
-
-                                SDL_PushGPUVertexUniformData(command_buffer, 0, &mvpf, sizeof(mvpf));
-                                SDL_PushGPUFragmentUniformData(command_buffer, 0, &color, sizeof(color));
-                                // Triangle indices는 24번 인덱스부터 36개
-                                SDL_DrawGPUIndexedPrimitives(render_pass, 36, 1, 24, 0, 0); 
-                            };
-
-                            // X축 (Red)
-                            draw_solid_axis(Vector3(length, thickness, thickness), { 1, 0, 0, 1 });
-                            // Y축 (Green)
-                            draw_solid_axis(Vector3(thickness, length, thickness), { 0, 1, 0, 1 });
-                            // Z축 (Blue)
-                            draw_solid_axis(Vector3(thickness, thickness, length), { 0, 0, 1, 1 });
-                        }
-                    }
-                }
+void App::UpdateMeshResidency()
+{
+    ZoneScoped;
 
-                // Render ImGui
-                if (window_id == main_window_id)
-                {
-                    ImGui_ImplSDLGPU3_RenderDrawData(draw_data, command_buffer, render_pass);
-                }
-            }
-            SDL_EndGPURenderPass(render_pass);
+    // 내린 메쉬의 구간은 GeometryBuffer가 진행 중인 프레임이 끝난 뒤에 다시 쓴다
+    mesh_reloads.clear();
+    mesh_residency.Update(render_frame_index, [this](LoadedMesh& mesh)
+    {
+        geometry_buffer->Free(mesh.geometry);
+        mesh.geometry = GeometryBuffer::InvalidHandle;
+        mesh_gpu_bytes -= mesh.gpu_bytes;
+        mesh_full_bytes -= mesh.full_format_bytes;
+    }, mesh_reloads);
+
+    // 같은 파일의 메쉬들은 작업 하나로 다시 읽는다
+    std::ranges::sort(mesh_reloads, {}, [](const std::shared_ptr<LoadedMesh>& mesh) { return mesh->asset_key; });
+    for (size_t i = 0; i < mesh_reloads.size(); ++i)
+    {
+        const LoadedMesh& mesh = *mesh_reloads[i];
+        if (i == 0 || mesh_reloads[i - 1]->asset_key != mesh.asset_key)
+        {
+            mesh_importer->EnqueueReload(mesh.source_path, mesh.asset_key);
         }
-
-        // Command Buffer 제출
-        SDL_SubmitGPUCommandBuffer(command_buffer);
     }
+}
 
-    // Update and Render additional Platform Windows
-    const ImGuiIO& IO = ImGui::GetIO();
-    if (IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+void App::ReleaseMeshAsset(const std::shared_ptr<LoadedMesh>& mesh)
+{
+    if (!mesh)
     {
-        ImGui::UpdatePlatformWindows();
-        ImGui::RenderPlatformWindowsDefault();
+        return;
     }
 
-    pso_manager->EndFrame();
+    // 마지막 엔티티였으면 이 원본의 메쉬를 모두 내린다. 구간은 진행 중인 프레임이 끝난 뒤에 다시 쓴다
+    mesh_asset_registry->Release(mesh->asset_key, [this](LoadedMesh& released)
+    {
+        if (released.geometry != GeometryBuffer::InvalidHandle)
+        {
+            geometry_buffer->Free(released.geometry);
+            released.geometry = GeometryBuffer::InvalidHandle;
+            mesh_gpu_bytes -= released.gpu_bytes;
+            mesh_full_bytes -= released.full_format_bytes;
+        }
+        mesh_residency.OnReleased(released);
+    });
 }
 
-SDL_WindowID App::CreateWindow(const char* title, int32 x, int32 y, int32 width, int32 height, uint32 flags)
+void App::SyncPickingTree()
 {
-    SDL_Window* window = SDL_CreateWindow(title, width, height, flags);
-    SDL_SetWindowPosition(window, x, y);
+    ZoneScoped;
 
-    SDL_WindowID window_id = SDL_GetWindowID(window);
-    windows.insert({ window_id, window });
+    auto find_proxy = [this](Entity entity) -> int32&
+    {
+        const uint32 id = entity.GetId();
+        if (id >= picking_proxies.size())
+        {
+            picking_proxies.resize(id + 1, DynamicAabbTree::NullNode);
+        }
+        return picking_proxies[id];
+    };
 
-    SDL_ClaimWindowForGPUDevice(gpu_device, window);
-    SDL_SetGPUSwapchainParameters(
-        gpu_device,
-        window,
-        SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
-        SDL_GPU_PRESENTMODE_MAILBOX
-    );
+    for (const Entity entity : transform_cache.GetRemovedEntities())
+    {
+        int32& proxy = find_proxy(entity);
+        // 같은 id를 새 세대가 이미 쓰고 있을 수 있으므로 엔티티까지 비교
+        if (proxy != DynamicAabbTree::NullNode && picking_tree.GetEntity(proxy) == entity)
+        {
+            picking_tree.DestroyProxy(proxy);
+            proxy = DynamicAabbTree::NullNode;
+        }
+    }
+
+    for (const Entity entity : transform_cache.GetChangedEntities())
+    {
+        const CachedTransform* cached = transform_cache.Find(entity);
+        int32& proxy = find_proxy(entity);
+
+        // 이전 세대의 프록시가 남아 있으면 정리
+        if (proxy != DynamicAabbTree::NullNode && picking_tree.GetEntity(proxy) != entity)
+        {
+            picking_tree.DestroyProxy(proxy);
+            proxy = DynamicAabbTree::NullNode;
+        }
+
+        if (cached && cached->has_bounds)
+        {
+            if (proxy == DynamicAabbTree::NullNode)
+            {
+                proxy = picking_tree.CreateProxy(cached->world_bounds, entity);
+            }
+            else
+            {
+                picking_tree.MoveProxy(proxy, cached->world_bounds);
+            }
+        }
+        else if (proxy != DynamicAabbTree::NullNode)
+        {
+            // MeshComponent가 빠진 경우
+            picking_tree.DestroyProxy(proxy);
+            proxy = DynamicAabbTree::NullNode;
+        }
+    }
+}
+
+Entity App::PickEntity(float mouse_x, float mouse_y) const
+{
+    ZoneScoped;
+
+    int w = 0, h = 0;
+    SDL_GetWindowSize(GetMainWindow(), &w, &h);
+    if (w <= 0 || h <= 0) return Entity{};
+
+    Matrix4x4 view_mat = math::TransformUtility::MakeViewMatrix(
+        my_camera.position, my_camera.position + my_camera.rotation.GetForwardVector(), Vector3::UnitZ()
+    );
+    Matrix4x4 projection_mat = math::TransformUtility::MakePerspectiveMatrix(
+        Radian{ my_camera.fov },
+        static_cast<double>(w) / h,
+        0.1, 10000.0
+    );
+
+    const se::Ray ray = ScreenToWorldRay(mouse_x, mouse_y, static_cast<float>(w), static_cast<float>(h), view_mat, projection_mat);
+
+    Entity closest_entity = Entity{};
+    picking_tree.RayCast(ray, std::numeric_limits<double>::max(), [&](Entity entity, double max_distance) -> double
+    {
+        const CachedTransform* cached = transform_cache.Find(entity);
+        Optional<MeshComponent&> mesh_comp_opt = world.TryGetComponent<MeshComponent>(entity);
+        if (!cached || !mesh_comp_opt) return max_distance;
+
+        const MeshComponent& mesh_comp = mesh_comp_opt.Value();
+        if (!mesh_comp.mesh) return max_distance;
+
+        const Matrix4x4& model = cached->world;
+        const Matrix4x4& inv_model = cached->inverse_world;
+
+        // Transform Ray to local space
+        Vector4 local_origin_v4 = Vector4(ray.origin.x, ray.origin.y, ray.origin.z, 1.0f) * inv_model;
+        Vector3 local_origin = Vector3(local_origin_v4.x, local_origin_v4.y, local_origin_v4.z) / local_origin_v4.w;
+
+        Vector4 local_dir_v4 = Vector4(ray.direction.x, ray.direction.y, ray.direction.z, 0.0f) * inv_model;
+        Vector3 local_dir = Vector3(local_dir_v4.x, local_dir_v4.y, local_dir_v4.z).GetNormalized();
+
+        se::Ray local_ray(local_origin, local_dir);
+
+        const AABBf& mesh_bounds = mesh_comp.mesh->bounds;
+        const AABB bounds_d(
+            Vector3(mesh_bounds.min.x, mesh_bounds.min.y, mesh_bounds.min.z),
+            Vector3(mesh_bounds.max.x, mesh_bounds.max.y, mesh_bounds.max.z)
+        );
+
+        double dist;
+        if (!local_ray.Intersects(bounds_d, dist)) return max_distance;
+
+        // To be precise, calculate world space distance
+        Vector3 hit_local = local_ray.GetPoint(dist);
+        Vector4 hit_world_v4 = Vector4(hit_local.x, hit_local.y, hit_local.z, 1.0f) * model;
+        Vector3 hit_world = Vector3(hit_world_v4.x, hit_world_v4.y, hit_world_v4.z) / hit_world_v4.w;
+
+        const double world_dist = (hit_world - ray.origin).Length();
+        if (world_dist >= max_distance) return max_distance;
+
+        closest_entity = entity;
+        return world_dist;
+    });
+
+    return closest_entity;
+}
+
+void App::Render()
+{
+    ZoneScoped;
+
+    // 인스턴스 데이터 수집 (모델 행렬은 윈도우와 무관하므로 프레임당 한 번만 계산)
+    // 그릴 대상 수집 (월드 행렬과 AABB는 TransformCache에서 바뀐 엔티티만 다시 계산된 값을 사용)
+    render_items.clear();
+    cull_bounds.Clear();
+    for (auto [entity, mesh_comp] : world.QueryEntities<Entity, const MeshComponent&>())
+    {
+        const CachedTransform* cached = transform_cache.Find(entity);
+        if (!cached || !cached->has_bounds) continue;
+
+        render_items.push_back({ &mesh_comp, cached });
+        cull_bounds.Push(cached->world_bounds);
+    }
+
+    // 기즈모 축 (X, Y, Z 순서)
+    gizmo_instance_count = 0;
+    if (transform_cache.Find(selected_entity))
+    {
+        if (auto transform_opt = world.TryGetComponent<TransformComponent>(selected_entity))
+        {
+            const Vector3 pos = transform_opt.Value().position;
+            constexpr double length = 3.0;
+            constexpr double thickness = 0.1;
+
+            for (const Vector3& scale : {
+                     Vector3(length, thickness, thickness),
+                     Vector3(thickness, length, thickness),
+                     Vector3(thickness, thickness, length)
+                 })
+            {
+                const Matrix4x4 mat = math::TransformUtility::MakeFromScale(scale) *
+                                      math::TransformUtility::MakeFromTranslation(pos);
+                gizmo_models[gizmo_instance_count++] = ToFloatMatrix(mat);
+            }
+        }
+    }
+
+    // ImGui 드로우 데이터는 메인 뷰에서만 쓰므로 프레임당 한 번 만든다
+    ImGui::Render();
+    ImDrawData* draw_data = ImGui::GetDrawData();
+
+    // 1. 타겟 준비 (메인 스레드)
+    //    스왑체인 텍스처는 윈도우를 만든 스레드에서만 얻을 수 있으므로 표시용 커맨드 버퍼와 함께 여기서 모두 얻어 둔다
+    view_targets.clear();
+
+    // GPU가 frames_in_flight 프레임만큼 밀려 있으면 기다리지 않고 이번 프레임은 기록하지 않는다
+    bool is_gpu_behind = false;
+    if (SDL_GPUFence*& frame_fence = frame_fences[render_frame_index % frames_in_flight])
+    {
+        is_gpu_behind = !SDL_QueryGPUFence(gpu_device, frame_fence);
+        if (!is_gpu_behind)
+        {
+            SDL_ReleaseGPUFence(gpu_device, frame_fence);
+            frame_fence = nullptr;
+        }
+    }
+
+    if (is_gpu_behind)
+    {
+        ++present_stats.skipped_frames;
+    }
+    else if (options.is_headless)
+    {
+        // 스왑체인 대신 오프스크린 타겟에 그린다 (ImGui도 같은 타겟에 합성)
+        view_targets.push_back({
+            .present_command_buffer = SDL_AcquireGPUCommandBuffer(gpu_device),
+            .color_texture = AcquireColorTarget(main_window_id, options.width, options.height),
+            .depth_texture = AcquireDepthTarget(main_window_id, options.width, options.height),
+            .width = options.width,
+            .height = options.height,
+            .is_main_view = true,
+            .context = &GetViewContext(main_window_id),
+        });
+    }
+    else
+    {
+        for (const auto& [window_id, window] : windows)
+        {
+            // 보이지 않는 윈도우는 커맨드 버퍼도 만들지 않는다
+            if (SDL_GetWindowFlags(window) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_OCCLUDED | SDL_WINDOW_HIDDEN))
+            {
+                ++present_stats.hidden_windows;
+                continue;
+            }
+
+            SDL_GPUCommandBuffer* command_buffer = SDL_AcquireGPUCommandBuffer(gpu_device);
+
+            // Swapchain Texture 가져오기 (화면에 그릴 캔버스 역할)
+            // 대기하지 않는 버전: 프레임이 너무 많이 밀려 있으면 텍스처가 nullptr로 온다
+            SDL_GPUTexture* swapchain_texture = nullptr;
+            uint32 swapchain_width = 0, swapchain_height = 0;
+            bool is_acquired;
+            {
+                ScopedFrameStage stage(frame_telemetry, FrameStage::SwapchainAcquire);
+                is_acquired = SDL_AcquireGPUSwapchainTexture(
+                    command_buffer, window, &swapchain_texture, &swapchain_width, &swapchain_height
+                );
+            }
+
+            if (!is_acquired || !swapchain_texture || swapchain_width == 0 || swapchain_height == 0)
+            {
+                // 스왑체인 텍스처를 얻지 못한 커맨드 버퍼는 제출하지 않고 취소할 수 있다
+                SDL_CancelGPUCommandBuffer(command_buffer);
+                ++present_stats.skipped_windows;
+                continue;
+            }
+
+            view_targets.push_back({
+                .present_command_buffer = command_buffer,
+                .swapchain_texture = swapchain_texture,
+                .color_texture = AcquireColorTarget(window_id, swapchain_width, swapchain_height),
+                .depth_texture = AcquireDepthTarget(window_id, swapchain_width, swapchain_height),
+                .width = swapchain_width,
+                .height = swapchain_height,
+                .is_main_view = window_id == main_window_id,
+                .context = &GetViewContext(window_id),
+            });
+        }
+    }
+
+    // 2. 뷰마다 워커가 자기 커맨드 버퍼를 얻어 오프스크린 타겟에 기록하고 제출한다 (씬 데이터는 읽기만 한다)
+    //    SDL은 커맨드 버퍼를 얻은 스레드에서만 쓰도록 요구하므로 메인 스레드의 커맨드 버퍼는 넘기지 않는다
+    render_workers->ParallelFor(static_cast<uint32>(view_targets.size()), [this](uint32 index)
+    {
+        // 타겟 생성에 실패한 뷰는 씬을 그리지 않는다
+        const ViewTarget& target = view_targets[index];
+        if (target.color_texture && target.depth_texture)
+        {
+            RenderView(target);
+        }
+    });
+
+    // 3. 메인 스레드에서 스왑체인으로 블릿하고 ImGui를 그린 뒤 윈도우 순서대로 제출
+    //    워커의 커맨드 버퍼가 모두 먼저 제출됐고 같은 큐에서 순서대로 실행되므로, 마지막 커맨드 버퍼의 펜스가 프레임 전체를 대표한다
+    if (!view_targets.empty())
+    {
+        for (const ViewTarget& target : view_targets)
+        {
+            ComposeView(target, draw_data);
+        }
+
+        ScopedFrameStage stage(frame_telemetry, FrameStage::Submit);
+        for (size_t i = 0; i + 1 < view_targets.size(); ++i)
+        {
+            SDL_SubmitGPUCommandBuffer(view_targets[i].present_command_buffer);
+        }
+        frame_fences[render_frame_index % frames_in_flight] = SDL_SubmitGPUCommandBufferAndAcquireFence(view_targets.back().present_command_buffer);
+        ++render_frame_index;
+    }
+
+    // Update and Render additional Platform Windows
+    const ImGuiIO& IO = ImGui::GetIO();
+    if (IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+    {
+        ImGui::UpdatePlatformWindows();
+        RenderImGuiViewports();
+    }
+
+    render_target_pool->EndFrame();
+    pso_manager->EndFrame();
+}
+
+uint32 App::SelectMeshLod(const CachedTransform& cached, const LoadedMesh& mesh, double projection_scale) const
+{
+    const uint32 num_lods = static_cast<uint32>(mesh.gpu_format.lods.size());
+    if (num_lods <= 1)
+    {
+        return 0;
+    }
+    if (forced_lod >= 0)
+    {
+        return std::min(static_cast<uint32>(forced_lod), num_lods - 1);
+    }
+
+    // 월드 AABB의 바운딩 구가 화면 높이에서 차지하는 비율 (카메라가 구 안에 있으면 1 이상)
+    const AABB& bounds = cached.world_bounds;
+    const double size_x = bounds.max.x - bounds.min.x;
+    const double size_y = bounds.max.y - bounds.min.y;
+    const double size_z = bounds.max.z - bounds.min.z;
+    const double radius = 0.5 * std::sqrt(size_x * size_x + size_y * size_y + size_z * size_z);
+
+    const double dx = (bounds.min.x + bounds.max.x) * 0.5 - my_camera.position.x;
+    const double dy = (bounds.min.y + bounds.max.y) * 0.5 - my_camera.position.y;
+    const double dz = (bounds.min.z + bounds.max.z) * 0.5 - my_camera.position.z;
+    const double distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), 1e-6);
+    const double screen_size = radius * projection_scale / distance;
+
+    uint32 lod = 0;
+    while (lod + 1 < num_lods && lod < lod_screen_thresholds.size() && screen_size < lod_screen_thresholds[lod])
+    {
+        ++lod;
+    }
+    return lod;
+}
+
+void App::RenderView(const ViewTarget& target)
+{
+    ZoneScoped;
+
+    SDL_GPUCommandBuffer* command_buffer = SDL_AcquireGPUCommandBuffer(gpu_device);
+    if (!command_buffer)
+    {
+        return;
+    }
+    ViewRenderContext& context = *target.context;
+
+    ViewUniform view_uniform;
+    {
+        Matrix4x4 view_mat = math::TransformUtility::MakeViewMatrix(
+            my_camera.position, my_camera.position + my_camera.rotation.GetForwardVector(), Vector3::UnitZ()
+        );
+        Matrix4x4 projection_mat = math::TransformUtility::MakePerspectiveMatrix(
+            Radian{ my_camera.fov },
+            static_cast<double>(target.width) / target.height,
+            0.1, 10000.0
+        );
+
+        view_uniform.view_proj = ToFloatMatrix(view_mat * projection_mat);
+    }
+
+    // 절두체 컬링 후 보이는 것만 인스턴스로 구성
+    const uint32 visible_count = cull_bounds.Cull(Frustum::FromViewProjection(view_uniform.view_proj), context.visibility);
+    if (target.is_main_view)
+    {
+        cull_stats = { .visible = visible_count, .culled = static_cast<uint32>(render_items.size()) - visible_count };
+    }
+
+    // 화면 크기 기반 LOD 선택 (같은 메쉬라도 LOD가 다르면 다른 배치)
+    const double projection_scale = 1.0 / std::tan(Radian{ my_camera.fov }.value * 0.5);
+    if (target.is_main_view)
+    {
+        lod_instance_counts.fill(0);
+    }
+
+    std::vector<Matrix4x4f>& instance_models = context.instance_models;
+    instance_models.clear();
+    context.mesh_batcher.Reset();
+    for (size_t i = 0; i < render_items.size(); ++i)
+    {
+        if (!context.visibility[i]) continue;
+
+        const RenderItem& item = render_items[i];
+        const uint32 lod = SelectMeshLod(*item.cached, *item.mesh_comp->mesh, projection_scale);
+        if (target.is_main_view)
+        {
+            ++lod_instance_counts[lod];
+        }
+        context.mesh_batcher.Add(item.mesh_comp->mesh, item.cached->world_f, lod);
+    }
+    context.mesh_batcher.Build(instance_models);
+
+    const uint32 aabb_first_instance = static_cast<uint32>(instance_models.size());
+    for (size_t i = 0; i < render_items.size(); ++i)
+    {
+        if (!context.visibility[i]) continue;
+        instance_models.push_back(render_items[i].cached->bounds_matrix);
+    }
+    const uint32 aabb_instance_count = static_cast<uint32>(instance_models.size()) - aabb_first_instance;
+
+    const uint32 gizmo_first_instance = static_cast<uint32>(instance_models.size());
+    instance_models.insert(instance_models.end(), gizmo_models, gizmo_models + gizmo_instance_count);
+
+    // 인스턴스 행렬 업로드 (Render Pass 시작 전에 Copy Pass로 기록)
+    context.instance_buffer.Upload(command_buffer, std::span<const Matrix4x4f>(instance_models));
+
+    constexpr SDL_FColor clear_color = { 0.25f, 0.25f, 0.25f, 1.0f };
+
+    SDL_GPUColorTargetInfo target_info = {};
+    target_info.texture = target.color_texture;
+    target_info.clear_color = clear_color;
+    target_info.load_op = SDL_GPU_LOADOP_CLEAR;
+    target_info.store_op = SDL_GPU_STOREOP_STORE;
+    target_info.mip_level = 0;
+    target_info.layer_or_depth_plane = 0;
+    target_info.cycle = false;
+
+    SDL_GPUDepthStencilTargetInfo depth_stencil_target_info = {
+        .texture = target.depth_texture,
+        .clear_depth = 1.0f,
+        .load_op = SDL_GPU_LOADOP_CLEAR,
+        .store_op = SDL_GPU_STOREOP_STORE,
+        .cycle = false,
+    };
+
+    SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(command_buffer, &target_info, 1, &depth_stencil_target_info);
+    {
+        SDL_GPUBuffer* instance_storage = context.instance_buffer.GetBuffer();
+        auto bind_pipeline = [&](SDL_GPUGraphicsPipeline* target_pipeline)
+        {
+            SDL_BindGPUGraphicsPipeline(render_pass, target_pipeline);
+            SDL_BindGPUVertexStorageBuffers(render_pass, 0, &instance_storage, 1);
+        };
+
+        auto push_instance_offset = [&](uint32 first_instance, const SDL_FColor& color)
+        {
+            view_uniform.instance_offset = first_instance;
+            SDL_PushGPUVertexUniformData(command_buffer, 0, &view_uniform, sizeof(view_uniform));
+            SDL_PushGPUFragmentUniformData(command_buffer, 0, &color, sizeof(color));
+        };
+
+        // --- 메쉬 렌더링 (메쉬 섹션당 인스턴스 드로우 1회) ---
+        // 메쉬들은 공용 버퍼를 나눠 쓰므로 버퍼는 페이지가 바뀔 때만 바인딩하고 base vertex / first index만 바꾼다
+        SDL_GPUGraphicsPipeline* bound_pipeline = nullptr;
+        SDL_GPUBuffer* bound_vertex_buffer = nullptr;
+        SDL_GPUBuffer* bound_index_buffer = nullptr;
+        SDL_GPUIndexElementSize bound_index_element_size = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+        for (const MeshInstanceBatch& batch : context.mesh_batcher.GetBatches())
+        {
+            // 내려간 메쉬도 그리려고 했다는 표시는 남겨서, 메인 스레드가 다시 올리게 한다
+            batch.mesh->last_used_frame.store(render_frame_index, std::memory_order_relaxed);
+            if (batch.mesh->residency != MeshResidencyState::Resident) continue;
+
+            const GeometrySlice slice = geometry_buffer->GetSlice(batch.mesh->geometry);
+            if (!slice.IsValid()) continue;
+
+            // 메쉬가 올라간 정점 형식에 맞는 파이프라인
+            const MeshGpuFormat& gpu_format = batch.mesh->gpu_format;
+            SDL_GPUGraphicsPipeline* mesh_pipeline = gpu_format.is_compact ? compact_pipeline : pipeline;
+            if (mesh_pipeline != bound_pipeline)
+            {
+                bind_pipeline(mesh_pipeline);
+                bound_pipeline = mesh_pipeline;
+            }
+            if (gpu_format.is_compact)
+            {
+                SDL_PushGPUVertexUniformData(command_buffer, 1, &gpu_format.dequantize, sizeof(gpu_format.dequantize));
+            }
+
+            // a가 0이면 노멀 기반 색상 사용
+            push_instance_offset(batch.first_instance, { 0.0f, 0.0f, 0.0f, 0.0f });
+
+            // Vertex Buffer 바인딩
+            if (slice.vertex_buffer != bound_vertex_buffer)
+            {
+                const SDL_GPUBufferBinding vertex_binding = { .buffer = slice.vertex_buffer, .offset = 0 };
+                SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
+                bound_vertex_buffer = slice.vertex_buffer;
+            }
+
+            // Index Buffer 바인딩 (16비트와 32비트 인덱스가 같은 버퍼에 섞여 있다)
+            if (slice.index_buffer != bound_index_buffer || gpu_format.index_element_size != bound_index_element_size)
+            {
+                const SDL_GPUBufferBinding index_binding = { .buffer = slice.index_buffer, .offset = 0 };
+                SDL_BindGPUIndexBuffer(render_pass, &index_binding, gpu_format.index_element_size);
+                bound_index_buffer = slice.index_buffer;
+                bound_index_element_size = gpu_format.index_element_size;
+            }
+
+            // Draw Sections (16비트 인덱스는 섹션 안에서의 상대 번호이므로 base vertex를 더한다)
+            const GpuMeshLod& lod = gpu_format.lods[batch.lod];
+            for (size_t section_index = 0; section_index < lod.sections.size(); ++section_index)
+            {
+                const GpuIndexRange& section = lod.sections[section_index];
+                if (section.index_count == 0) continue;
+
+                SDL_DrawGPUIndexedPrimitives(
+                    render_pass, section.index_count, batch.instance_count, slice.first_index + section.index_start,
+                    static_cast<int32>(slice.first_vertex) + gpu_format.section_vertex_offsets[section_index], 0
+                );
+            }
+        }
+
+        // 디버그 큐브 버퍼 바인딩 (AABB, 기즈모 공용)
+        const SDL_GPUBufferBinding v_binding = { .buffer = debug_unit_cube_vbuf, .offset = 0 };
+        const SDL_GPUBufferBinding i_binding = { .buffer = debug_unit_cube_ibuf, .offset = 0 };
+
+        // --- AABB 렌더링 ---
+        if (aabb_instance_count > 0)
+        {
+            bind_pipeline(line_pipeline);
+            SDL_BindGPUVertexBuffers(render_pass, 0, &v_binding, 1);
+            SDL_BindGPUIndexBuffer(render_pass, &i_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+
+            // AABB 색상 (초록색, 투명도 조절용 a=1.0)
+            push_instance_offset(aabb_first_instance, { 0.0f, 1.0f, 0.0f, 1.0f });
+            SDL_DrawGPUIndexedPrimitives(render_pass, 24, aabb_instance_count, 0, 0, 0); // Line indices
+        }
+
+        // --- 기즈모 렌더링 ---
+        if (gizmo_instance_count > 0)
+        {
+            bind_pipeline(gizmo_pipeline);
+            SDL_BindGPUVertexBuffers(render_pass, 0, &v_binding, 1);
+            SDL_BindGPUIndexBuffer(render_pass, &i_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+
+            constexpr SDL_FColor axis_colors[] = {
+                { 1, 0, 0, 1 }, // X축 (Red)
+                { 0, 1, 0, 1 }, // Y축 (Green)
+                { 0, 0, 1, 1 }, // Z축 (Blue)
+            };
+            for (uint32 axis = 0; axis < gizmo_instance_count; ++axis)
+            {
+                push_instance_offset(gizmo_first_instance + axis, axis_colors[axis]);
+                // Triangle indices는 24번 인덱스부터 36개
+                SDL_DrawGPUIndexedPrimitives(render_pass, 36, 1, 24, 0, 0);
+            }
+        }
+    }
+    SDL_EndGPURenderPass(render_pass);
+
+    SDL_SubmitGPUCommandBuffer(command_buffer);
+}
+
+void App::ComposeView(const ViewTarget& target, ImDrawData* draw_data)
+{
+    ZoneScoped;
+
+    SDL_GPUCommandBuffer* command_buffer = target.present_command_buffer;
+
+    // 헤드리스는 오프스크린 타겟이 곧 결과라 옮기지 않는다
+    SDL_GPUTexture* output_texture = target.swapchain_texture ? target.swapchain_texture : target.color_texture;
+    if (target.swapchain_texture && target.color_texture)
+    {
+        const SDL_GPUBlitInfo blit_info = {
+            .source = { .texture = target.color_texture, .w = target.width, .h = target.height },
+            .destination = { .texture = target.swapchain_texture, .w = target.width, .h = target.height },
+            .load_op = SDL_GPU_LOADOP_DONT_CARE,
+            .filter = SDL_GPU_FILTER_NEAREST,
+        };
+        SDL_BlitGPUTexture(command_buffer, &blit_info);
+    }
+
+    if (!target.is_main_view || !output_texture || draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+    {
+        return;
+    }
+
+    // ImGui 백엔드는 스레드 안전하지 않으므로 메인 스레드에서만 그린다
+    ImGui_ImplSDLGPU3_PrepareDrawData(draw_data, command_buffer);
+
+    SDL_GPUColorTargetInfo target_info = {};
+    target_info.texture = output_texture;
+    target_info.load_op = target.color_texture ? SDL_GPU_LOADOP_LOAD : SDL_GPU_LOADOP_CLEAR;
+    target_info.store_op = SDL_GPU_STOREOP_STORE;
+
+    SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(command_buffer, &target_info, 1, nullptr);
+    ImGui_ImplSDLGPU3_RenderDrawData(draw_data, command_buffer, render_pass);
+    SDL_EndGPURenderPass(render_pass);
+}
+
+void App::RenderImGuiViewports()
+{
+    ZoneScoped;
+
+    // RenderPlatformWindowsDefault는 백엔드에서 SDL_WaitAndAcquireGPUSwapchainTexture로 기다리므로 직접 그린다
+    const ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    for (int i = 1; i < platform_io.Viewports.Size; ++i) // 0번은 메인 뷰포트
+    {
+        ImGuiViewport* viewport = platform_io.Viewports[i];
+        SDL_Window* window = SDL_GetWindowFromID(static_cast<SDL_WindowID>(reinterpret_cast<uintptr_t>(viewport->PlatformHandle)));
+        ImDrawData* draw_data = viewport->DrawData;
+        if (!window || !draw_data)
+        {
+            continue;
+        }
+
+        if (SDL_GetWindowFlags(window) & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_OCCLUDED | SDL_WINDOW_HIDDEN))
+        {
+            ++present_stats.hidden_windows;
+            continue;
+        }
+
+        SDL_GPUCommandBuffer* command_buffer = SDL_AcquireGPUCommandBuffer(gpu_device);
+
+        SDL_GPUTexture* swapchain_texture = nullptr;
+        uint32 swapchain_width = 0, swapchain_height = 0;
+        bool is_acquired;
+        {
+            ScopedFrameStage stage(frame_telemetry, FrameStage::SwapchainAcquire);
+            is_acquired = SDL_AcquireGPUSwapchainTexture(
+                command_buffer, window, &swapchain_texture, &swapchain_width, &swapchain_height
+            );
+        }
+
+        if (!is_acquired || !swapchain_texture || swapchain_width == 0 || swapchain_height == 0)
+        {
+            SDL_CancelGPUCommandBuffer(command_buffer);
+            ++present_stats.skipped_windows;
+            continue;
+        }
+
+        ImGui_ImplSDLGPU3_PrepareDrawData(draw_data, command_buffer);
+
+        SDL_GPUColorTargetInfo target_info = {};
+        target_info.texture = swapchain_texture;
+        target_info.clear_color = { 0.0f, 0.0f, 0.0f, 1.0f };
+        target_info.load_op = (viewport->Flags & ImGuiViewportFlags_NoRendererClear) ? SDL_GPU_LOADOP_DONT_CARE : SDL_GPU_LOADOP_CLEAR;
+        target_info.store_op = SDL_GPU_STOREOP_STORE;
+
+        SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass(command_buffer, &target_info, 1, nullptr);
+        ImGui_ImplSDLGPU3_RenderDrawData(draw_data, command_buffer, render_pass);
+        SDL_EndGPURenderPass(render_pass);
+
+        SDL_SubmitGPUCommandBuffer(command_buffer);
+    }
+}
+
+SDL_WindowID App::CreateWindow(const char* title, int32 x, int32 y, int32 width, int32 height, uint32 flags)
+{
+    SDL_Window* window = SDL_CreateWindow(title, width, height, flags);
+    SDL_SetWindowPosition(window, x, y);
+
+    SDL_WindowID window_id = SDL_GetWindowID(window);
+    windows.insert({ window_id, window });
+
+    SDL_ClaimWindowForGPUDevice(gpu_device, window);
+    SDL_SetGPUSwapchainParameters(
+        gpu_device,
+        window,
+        SDL_GPU_SWAPCHAINCOMPOSITION_SDR,
+        GetPresentMode(window)
+    );
 
     return window_id;
 }
@@ -1147,9 +2411,120 @@ void App::DestroyWindow(SDL_WindowID window_id)
     SDL_ReleaseWindowFromGPUDevice(gpu_device, window);
     SDL_DestroyWindow(window);
     windows.erase(window_id);
+    view_contexts.erase(window_id);
+    render_target_pool->ReleaseOwner(window_id);
 }
 
 void App::DestroyWindow(SDL_Window* window)
 {
     DestroyWindow(SDL_GetWindowID(window));
 }
+
+void App::SetFramePacingMode(FramePacingMode mode)
+{
+    frame_pacer.SetMode(mode);
+
+    // VSync 모드에서만 스왑체인이 속도를 정한다
+    for (SDL_Window* window : windows | std::views::values)
+    {
+        SDL_SetGPUSwapchainParameters(gpu_device, window, SDL_GPU_SWAPCHAINCOMPOSITION_SDR, GetPresentMode(window));
+    }
+}
+
+SDL_GPUTexture* App::AcquireColorTarget(SDL_WindowID window_id, uint32 width, uint32 height) const
+{
+    // 스왑체인으로 블릿하므로 샘플러 용도도 켠다
+    return render_target_pool->Acquire(window_id, ColorTargetSlot, {
+        .format = color_target_format,
+        .usage = SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER,
+        .width = width,
+        .height = height,
+    });
+}
+
+SDL_GPUTexture* App::AcquireDepthTarget(SDL_WindowID window_id, uint32 width, uint32 height) const
+{
+    return render_target_pool->Acquire(window_id, DepthTargetSlot, {
+        .format = depth_target_format,
+        .usage = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET,
+        .width = width,
+        .height = height,
+    });
+}
+
+void App::SetFramesInFlight(uint32 count)
+{
+    count = std::clamp(count, 1u, MaxFramesInFlight);
+    if (count == frames_in_flight)
+    {
+        return;
+    }
+
+    // 펜스 슬롯 수가 바뀌므로 진행 중인 프레임을 모두 끝내고 비운다
+    SDL_WaitForGPUIdle(gpu_device);
+    ReleaseFrameFences();
+
+    frames_in_flight = count;
+    SDL_SetGPUAllowedFramesInFlight(gpu_device, frames_in_flight);
+}
+
+void App::ReleaseFrameFences()
+{
+    for (SDL_GPUFence*& fence : frame_fences)
+    {
+        if (fence)
+        {
+            SDL_ReleaseGPUFence(gpu_device, fence);
+            fence = nullptr;
+        }
+    }
+}
+
+ViewRenderContext& App::GetViewContext(SDL_WindowID window_id)
+{
+    std::unique_ptr<ViewRenderContext>& context = view_contexts[window_id];
+    if (!context)
+    {
+        context = std::make_unique<ViewRenderContext>(gpu_device);
+    }
+    return *context;
+}
+
+SDL_GPUPresentMode App::GetPresentMode(SDL_Window* window) const
+{
+    if (frame_pacer.GetMode() != FramePacingMode::VSync
+        && SDL_WindowSupportsGPUPresentMode(gpu_device, window, SDL_GPU_PRESENTMODE_MAILBOX))
+    {
+        return SDL_GPU_PRESENTMODE_MAILBOX;
+    }
+    return SDL_GPU_PRESENTMODE_VSYNC;
+}
+
+void App::UpdateFramePacer()
+{
+    double refresh_frame_time = TargetFrameTime;
+    if (const SDL_DisplayMode* display_mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(GetMainWindow())))
+    {
+        if (display_mode->refresh_rate > 0.0f)
+        {
+            refresh_frame_time = 1.0 / static_cast<double>(display_mode->refresh_rate);
+        }
+    }
+
+    switch (frame_pacer.GetMode())
+    {
+    case FramePacingMode::Fixed:
+        frame_pacer.SetTargetFrameTime(TargetFrameTime);
+        break;
+    case FramePacingMode::VSync:
+    case FramePacingMode::Adaptive:
+        frame_pacer.SetTargetFrameTime(refresh_frame_time);
+        break;
+    default:
+        break;
+    }
+
+    // 어느 창에도 포커스가 없거나 메인 창이 최소화되어 있으면 유휴 상태
+    const bool is_minimized = (SDL_GetWindowFlags(GetMainWindow()) & SDL_WINDOW_MINIMIZED) != 0;
+    frame_pacer.SetIdle(is_minimized || SDL_GetKeyboardFocus() == nullptr);
+}
@@ -1,6 +1,10 @@
 ﻿#pragma once
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "SDL3/SDL.h"
 #include "SimpleEngine/Core/HAL/PlatformTypes.h"
@@ -9,6 +13,17 @@
 
 #include "SimpleEngine/Asset/AssetId.h"
 #include "SimpleEngine/Core/Container/String.h"
+#include "SimpleEngine/Core/Math/Math.h"
+
+#include "Asset/AsyncMeshImporter.h"
+#include "Rendering/FrustumCulling.h"
+#include "Rendering/MeshEncoding.h"
+#include "Rendering/MeshResidency.h"
+#include "Scene/DynamicAabbTree.h"
+#include "Scene/EntityList.h"
+#include "Scene/TransformCache.h"
+#include "Timing/FramePacer.h"
+#include "Timing/FrameTelemetry.h"
 
 
 namespace se
@@ -16,26 +31,64 @@ namespace se
 namespace graphics
 {
     class PSOManager;
-    class GpuResourceManager;
-}
-namespace asset
-{
-    class AssetImporter;
-    struct StaticMesh;
 }
 }
 
+struct ImDrawData;
+
+class CookedMeshCache;
+class GeometryBuffer;
+class MeshAssetRegistry;
+class ShaderCache;
+class ShaderLibrary;
+class RenderTargetPool;
+class UploadRing;
+class WorkerPool;
+struct ViewRenderContext;
+
+/// 올라간 메쉬의 메타데이터. CPU 쪽 정점 / 인덱스는 업로드 후 버리고, 내려간 뒤에는 원본 키로 다시 읽는다.
 struct LoadedMesh
 {
     se::asset::AssetId id;
     se::String name;
-    std::shared_ptr<se::asset::StaticMesh> mesh_data;
+    se::AABBf bounds;
+    MeshGpuFormat gpu_format; // GPU에 올라간 정점 / 인덱스 형식
+    uint32 geometry = 0;      // GeometryBuffer 핸들, 내려가 있으면 0
+
+    // 다시 올릴 때 쿠킹 캐시 / 원본에서 찾는 정보
+    se::Path source_path;
+    uint64 asset_key = 0;         // MeshAssetRegistry / CookedMeshCache 키
+    uint32 asset_mesh_index = 0;  // 임포트 결과 안에서의 순서
+    uint64 gpu_bytes = 0;         // 정점 + 인덱스
+    uint64 full_format_bytes = 0; // se::Vertex / 32비트 인덱스로 올렸을 때의 크기 (통계용)
+
+    MeshResidencyState residency = MeshResidencyState::Resident; // 메인 스레드에서만 바꾼다
+    mutable std::atomic<uint64> last_used_frame = 0;             // 렌더 스레드가 그릴 때 갱신
+};
+
+struct MeshComponent
+{
+    std::shared_ptr<LoadedMesh> mesh;
+};
+
+/// 명령줄에서 정하는 실행 옵션
+struct AppOptions
+{
+    bool is_headless = false; // 윈도우 / 스왑체인 없이 오프스크린 타겟에 그린다
+    std::string gpu_driver;   // SDL_HINT_GPU_DRIVER 값 (비어 있으면 플랫폼 기본값)
+    uint32 width = 1600;
+    uint32 height = 900;
+    uint32 max_frames = 0;    // 0이면 종료 요청이 올 때까지 실행
+    uint32 frames_in_flight = 2; // 1 ~ 3. 작을수록 입력 지연이, 클수록 처리량이 좋다
+
+    /// --headless, --gpu-driver=NAME, --frames=N, --size=WxH, --frames-in-flight=N
+    static AppOptions FromCommandLine(int argc, char* argv[]);
 };
 
 class App
 {
 public:
-    App();
+    explicit App(AppOptions options = {});
     virtual ~App();
 
     App(const App&) = delete;
@@ -52,7 +105,65 @@ public:
 protected:
     void ProcessPlatformEvents();
     void Update(float delta_time);
-    void Render() const;
+    void Render();
+
+    /// 한 뷰가 그릴 타겟. 씬은 워커가 오프스크린 color_texture에 그리고, 메인 스레드가 스왑체인으로 옮긴다.
+    struct ViewTarget
+    {
+        SDL_GPUCommandBuffer* present_command_buffer = nullptr; // 메인 스레드 전용 (스왑체인, 블릿, ImGui)
+        SDL_GPUTexture* swapchain_texture = nullptr;            // 헤드리스면 nullptr
+        SDL_GPUTexture* color_texture = nullptr;
+        SDL_GPUTexture* depth_texture = nullptr;
+        uint32 width = 0;
+        uint32 height = 0;
+        bool is_main_view = false;
+        ViewRenderContext* context = nullptr;
+    };
+
+    /// 씬(메쉬, AABB, 기즈모)을 color_texture에 그린다.
+    /// 워커 스레드에서 불리며, 커맨드 버퍼는 그 스레드에서 얻고 제출한다. 뷰 컨텍스트 밖의 상태는 읽기만 한다.
+    void RenderView(const ViewTarget& target);
+
+    /// 메인 스레드에서 씬을 스왑체인으로 블릿하고, 메인 뷰면 그 위에 ImGui를 그린다.
+    void ComposeView(const ViewTarget& target, ImDrawData* draw_data);
+
+    /// 메인 윈도우 밖으로 나간 ImGui 뷰포트를 그린다. 메인 윈도우처럼 스왑체인을 기다리지 않고, 못 얻으면 건너뛴다.
+    void RenderImGuiViewports();
+
+    /// 바운딩 구의 화면 크기로 LOD를 고른다. projection_scale = 1 / tan(fov / 2)
+    uint32 SelectMeshLod(const CachedTransform& cached, const LoadedMesh& mesh, double projection_scale) const;
+
+    void ReleaseFrameFences();
+
+    /// 윈도우 크기에 맞는 컬러 / 뎁스 타겟을 풀에서 얻는다.
+    SDL_GPUTexture* AcquireColorTarget(SDL_WindowID window_id, uint32 width, uint32 height) const;
+    SDL_GPUTexture* AcquireDepthTarget(SDL_WindowID window_id, uint32 width, uint32 height) const;
+
+    /// 윈도우의 뷰 컨텍스트를 가져오거나 만든다. 메인 스레드에서만 호출한다.
+    ViewRenderContext& GetViewContext(SDL_WindowID window_id);
+
+    /// 모드에 맞는 목표 프레임 시간과 유휴 여부를 페이서에 반영한다.
+    void UpdateFramePacer();
+    [[nodiscard]] SDL_GPUPresentMode GetPresentMode(SDL_Window* window) const;
+
+    /// 현재 최적화 / LOD / 압축 정점 설정으로 임포트 후처리를 다시 지정한다.
+    void UpdateMeshProcessor();
+
+    /// 임포트가 끝난 메쉬를 프레임당 업로드 예산 안에서 GPU에 올리고 엔티티를 만든다.
+    /// 다시 읽은 결과는 엔티티를 만들지 않고 내려가 있던 LoadedMesh를 채운다.
+    void UploadImportedMeshes();
+
+    /// 메쉬 GPU 예산을 넘었으면 오래 안 그린 메쉬를 내리고, 다시 그려질 메쉬의 재로드를 요청한다.
+    void UpdateMeshResidency();
+
+    /// 엔티티가 더 이상 mesh를 쓰지 않는다. 그 원본을 쓰는 마지막 엔티티였으면 GPU 슬라이스를 내리고 레지스트리에서 지운다.
+    void ReleaseMeshAsset(const std::shared_ptr<LoadedMesh>& mesh);
+
+    /// TransformCache의 변경 사항을 피킹용 AABB 트리에 반영한다.
+    void SyncPickingTree();
+
+    /// 메인 윈도우 좌표에서 가장 가까운 메쉬 엔티티를 찾는다. 없으면 invalid 엔티티
+    [[nodiscard]] se::ecs::Entity PickEntity(float mouse_x, float mouse_y) const;
 
 public:
     [[nodiscard]] bool IsRunning() const { return is_running; }
@@ -76,6 +187,13 @@ public:
         TargetFrameTime = 1.0 / static_cast<double>(TargetFps);
     }
 
+    void SetFramePacingMode(FramePacingMode mode);
+    [[nodiscard]] FramePacingMode GetFramePacingMode() const { return frame_pacer.GetMode(); }
+
+    /// CPU가 GPU보다 앞서 기록할 수 있는 프레임 수 (1 ~ MaxFramesInFlight)
+    void SetFramesInFlight(uint32 count);
+    [[nodiscard]] uint32 GetFramesInFlight() const { return frames_in_flight; }
+
     [[nodiscard]] SDL_Window* GetWindow(SDL_WindowID window_id) const
     {
         if (const auto it = windows.find(window_id); it != windows.end())
@@ -105,32 +223,117 @@ private:
     static uint32 TargetFps;       // 목표 FPS
     static double TargetFrameTime; // 목표 FPS 시간
 
+    AppOptions options;
+
     // Loop 제어 변수
     bool is_running = false;
     bool quit_requested = false;
 
+    FramePacer frame_pacer;
+
+    // 단계별 프레임 시간
+    FrameTelemetry frame_telemetry;
+    std::array<FrameStageStats, NumFrameStages> telemetry_stats = {};
+    double telemetry_refresh_time = 0.0;
+
 private:
-    std::unique_ptr<se::asset::AssetImporter> asset_importer;
+    std::unique_ptr<AsyncMeshImporter> mesh_importer;
+    std::shared_ptr<CookedMeshCache> cooked_mesh_cache; // 인코딩까지 끝난 메쉬를 디스크에 두고 매핑해서 다시 읽는다
+    std::shared_ptr<MeshAssetRegistry> mesh_asset_registry; // 올라간 메쉬 전부, 같은 원본은 한 번만 올린다
+    std::vector<MeshImportStatus> import_statuses;
+    bool is_mesh_optimize_enabled = true; // 임포트 시 weld / 캐시 / 오버드로우 / fetch 최적화
+    bool is_compact_vertex_enabled = true; // 업로드 시 CompactVertex로 인코딩
+    bool is_lod_generation_enabled = true; // 임포트 시 LOD 체인 생성
+
+    // 지금 GPU에 올라가 있는 메쉬의 크기와, se::Vertex + 32비트 인덱스였다면의 크기 (내리거나 해제하면 뺀다)
+    uint64 mesh_gpu_bytes = 0;
+    uint64 mesh_full_bytes = 0;
+    MeshResidency mesh_residency{ 512ull * 1024 * 1024, 300 }; // 메쉬 GPU 예산, 이만큼 안 그린 메쉬부터 내린다
+    std::vector<std::shared_ptr<LoadedMesh>> mesh_reloads;    // 이번 프레임에 다시 올릴 메쉬 (스크래치)
+    std::unique_ptr<ShaderCache> shader_cache;
+    std::unique_ptr<ShaderLibrary> shader_library;
     std::unique_ptr<se::graphics::PSOManager> pso_manager;
     mutable se::ecs::World world;
+    TransformCache transform_cache;
 
 private:
     SDL_WindowID main_window_id = 0;
     std::unordered_map<SDL_WindowID, SDL_Window*> windows;
 
     SDL_GPUDevice* gpu_device = nullptr;
+    SDL_GPUTextureFormat color_target_format = SDL_GPU_TEXTUREFORMAT_INVALID;
 
     SDL_GPUGraphicsPipeline* pipeline = nullptr;
+    SDL_GPUGraphicsPipeline* compact_pipeline = nullptr; // CompactVertex 메쉬용
     SDL_GPUGraphicsPipeline* line_pipeline = nullptr;
     SDL_GPUGraphicsPipeline* gizmo_pipeline = nullptr;
 
     SDL_GPUBuffer* debug_unit_cube_vbuf = nullptr;
     SDL_GPUBuffer* debug_unit_cube_ibuf = nullptr;
 
-    SDL_GPUTexture* depth_texture = nullptr;
+    // 윈도우별 렌더 타겟 (헤드리스의 오프스크린 컬러 타겟 포함)
+    static constexpr uint32 ColorTargetSlot = 0;
+    static constexpr uint32 DepthTargetSlot = 1;
+    std::unique_ptr<RenderTargetPool> render_target_pool;
+    SDL_GPUTextureFormat depth_target_format = SDL_GPU_TEXTUREFORMAT_D24_UNORM_S8_UINT;
+
+    std::unique_ptr<UploadRing> upload_ring; // 프레임 단위로 모아서 제출하는 업로드
+    std::unique_ptr<GeometryBuffer> geometry_buffer; // 모든 메쉬의 정점 / 인덱스를 나눠 쓰는 큰 버퍼들
+
+    // 윈도우별 커맨드 버퍼 병렬 기록
+    std::unique_ptr<WorkerPool> render_workers;
+    std::unordered_map<SDL_WindowID, std::unique_ptr<ViewRenderContext>> view_contexts;
+    std::vector<ViewTarget> view_targets;
+
+    // Frames In Flight: 프레임마다 마지막 제출의 펜스를 슬롯에 보관하고, 슬롯이 돌아왔을 때 끝나지 않았으면 건너뛴다
+    static constexpr uint32 MaxFramesInFlight = 3;
+    uint32 frames_in_flight = 2;
+    std::array<SDL_GPUFence*, MaxFramesInFlight> frame_fences = {};
+    uint64 render_frame_index = 0; // 실제로 제출한 프레임 수
+
+    struct PresentStats
+    {
+        uint64 skipped_frames = 0;  // GPU가 밀려 건너뛴 프레임
+        uint64 skipped_windows = 0; // 스왑체인 이미지가 없어 건너뛴 윈도우
+        uint64 hidden_windows = 0;  // 최소화 / 가려짐으로 기록하지 않은 윈도우
+    };
+    PresentStats present_stats;
+
+    // 절두체 컬링
+    struct RenderItem
+    {
+        const MeshComponent* mesh_comp;
+        const CachedTransform* cached;
+    };
+
+    struct CullStats
+    {
+        uint32 visible = 0;
+        uint32 culled = 0;
+    };
+
+    std::vector<RenderItem> render_items;
+    CullingBounds cull_bounds;
+    CullStats cull_stats; // 메인 윈도우 기준
+
+    // LOD 선택: 화면 높이 대비 바운딩 구 크기가 lod_screen_thresholds[i] 아래면 LOD i+1
+    static constexpr uint32 MaxMeshLods = 4; // LOD0 제외, MeshLodSettings::max_lods와 같다
+    std::array<float, MaxMeshLods> lod_screen_thresholds = { 0.5f, 0.25f, 0.12f, 0.06f };
+    int32 forced_lod = -1; // 0 이상이면 모든 메쉬에 이 LOD를 쓴다
+    std::array<uint32, MaxMeshLods + 1> lod_instance_counts = {}; // 메인 윈도우 기준
+
+    // 선택된 엔티티의 기즈모 축 (X, Y, Z 순서)
+    se::Matrix4x4f gizmo_models[3];
+    uint32 gizmo_instance_count = 0;
 
-    std::unique_ptr<se::graphics::GpuResourceManager> gpu_resource_manager;
-    se::Array<std::shared_ptr<LoadedMesh>> loaded_meshes;
+    se::ecs::Entity selected_entity;
+    EntityList entity_list;
+    bool is_entity_scroll_requested = false; // 피킹으로 선택이 바뀌면 목록을 그 줄로 스크롤한다
 
-    int32 selected_entity = -1;
+    // 뷰포트 피킹
+    DynamicAabbTree picking_tree;
+    std::vector<int32> picking_proxies; // 엔티티 id -> 트리 프록시
+    bool pick_requested = false;
+    float pick_mouse_x = 0.0f;
+    float pick_mouse_y = 0.0f;
 };
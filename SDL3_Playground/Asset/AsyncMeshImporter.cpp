@@ -0,0 +1,372 @@
+﻿#include "AsyncMeshImporter.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+
+#include "SimpleEngine/Asset/Pipeline/AssetImporter.h"
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+
+#include "Asset/ContentHash.h"
+#include "Asset/CookedMeshCache.h"
+#include "Asset/MeshAssetRegistry.h"
+
+#include "SDL3/SDL_timer.h"
+#include "tracy/Tracy.hpp"
+
+using namespace se;
+
+
+namespace
+{
+    std::filesystem::path ToStdPath(const Path& path)
+    {
+        return std::filesystem::path(std::u8string_view(reinterpret_cast<const char8_t*>(path.ToString().CStr())));
+    }
+}
+
+AsyncMeshImporter::AsyncMeshImporter(const ImporterFactory& factory, uint32 num_workers)
+{
+    if (num_workers == 0)
+    {
+        // 메인 스레드 몫을 하나 남겨두고, 파일 IO 위주라 너무 많이는 띄우지 않는다
+        const uint32 hardware_threads = std::max(std::thread::hardware_concurrency(), 2u);
+        num_workers = std::clamp(hardware_threads - 1, 1u, 4u);
+    }
+
+    importers.reserve(num_workers);
+    workers.reserve(num_workers);
+    for (uint32 i = 0; i < num_workers; ++i)
+    {
+        importers.push_back(factory());
+        workers.emplace_back([this, importer = importers.back().get()]
+        {
+            WorkerMain(*importer);
+        });
+    }
+}
+
+AsyncMeshImporter::~AsyncMeshImporter()
+{
+    {
+        std::lock_guard lock(mutex);
+        is_stopping = true;
+        pending.clear();
+    }
+    queue_cv.notify_all();
+
+    // 파싱 중인 작업은 끝날 때까지 기다린다
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+uint32 AsyncMeshImporter::Enqueue(const Path& path)
+{
+    uint32 job_id;
+    {
+        std::lock_guard lock(mutex);
+        job_id = next_job_id++;
+
+        Job& job = jobs.emplace_back();
+        job.id = job_id;
+        job.path = path;
+        job.name = path.FileName().ValueOr("Unknown");
+        pending.push_back(job_id);
+    }
+    queue_cv.notify_one();
+    return job_id;
+}
+
+uint32 AsyncMeshImporter::EnqueueReload(const Path& path, uint64 asset_key)
+{
+    uint32 job_id;
+    {
+        std::lock_guard lock(mutex);
+        job_id = next_job_id++;
+
+        Job& job = jobs.emplace_back();
+        job.id = job_id;
+        job.path = path;
+        job.name = path.FileName().ValueOr("Unknown");
+        job.asset_key = asset_key;
+        job.is_reload = true;
+        pending.push_back(job_id);
+    }
+    queue_cv.notify_one();
+    return job_id;
+}
+
+void AsyncMeshImporter::SetMeshProcessor(MeshProcessor processor, uint64 settings_key)
+{
+    std::lock_guard lock(mutex);
+    mesh_processor = std::move(processor);
+    mesh_processor_key = settings_key;
+}
+
+void AsyncMeshImporter::SetCookedMeshCache(std::shared_ptr<CookedMeshCache> cache)
+{
+    std::lock_guard lock(mutex);
+    cooked_mesh_cache = std::move(cache);
+}
+
+void AsyncMeshImporter::SetMeshAssetRegistry(std::shared_ptr<const MeshAssetRegistry> registry)
+{
+    std::lock_guard lock(mutex);
+    mesh_asset_registry = std::move(registry);
+}
+
+void AsyncMeshImporter::Cancel(uint32 job_id)
+{
+    std::lock_guard lock(mutex);
+
+    Job* job = FindJob(job_id);
+    if (!job || IsFinished(job->stage) || job->is_reload) return;
+
+    job->is_cancel_requested = true;
+    switch (job->stage)
+    {
+    case MeshImportStage::Queued:
+        std::erase(pending, job_id);
+        job->stage = MeshImportStage::Cancelled;
+        break;
+    case MeshImportStage::Ready:
+        std::erase(ready, job_id);
+        job->meshes.clear();
+        job->stage = MeshImportStage::Cancelled;
+        break;
+    default:
+        // Importing: 워커가 끝나면서 결과를 버린다
+        break;
+    }
+}
+
+void AsyncMeshImporter::CancelAll()
+{
+    std::vector<uint32> job_ids;
+    {
+        std::lock_guard lock(mutex);
+        for (const Job& job : jobs)
+        {
+            job_ids.push_back(job.id);
+        }
+    }
+
+    for (const uint32 job_id : job_ids)
+    {
+        Cancel(job_id);
+    }
+}
+
+bool AsyncMeshImporter::PopReady(MeshImportResult& out_result)
+{
+    std::lock_guard lock(mutex);
+    if (ready.empty()) return false;
+
+    const uint32 job_id = ready.front();
+    ready.pop_front();
+
+    Job* job = FindJob(job_id);
+    out_result.job_id = job->id;
+    out_result.name = job->name;
+    out_result.path = job->path;
+    out_result.asset_key = job->asset_key;
+    out_result.is_registered = job->is_registered;
+    out_result.is_reload = job->is_reload;
+    out_result.meshes = std::move(job->meshes);
+    job->meshes.clear();
+    return true;
+}
+
+void AsyncMeshImporter::MarkDone(uint32 job_id, bool is_succeeded)
+{
+    std::lock_guard lock(mutex);
+    const auto it = std::ranges::lower_bound(jobs, job_id, {}, &Job::id);
+    if (it == jobs.end() || it->id != job_id) return;
+
+    // 긴 세션에서 재로드가 목록에 쌓이지 않게 성공한 것은 바로 지운다 (실패는 UI에 남긴다)
+    if (it->is_reload && is_succeeded)
+    {
+        jobs.erase(it);
+        return;
+    }
+    it->stage = is_succeeded ? MeshImportStage::Done : MeshImportStage::Failed;
+}
+
+void AsyncMeshImporter::ClearFinished()
+{
+    std::lock_guard lock(mutex);
+    std::erase_if(jobs, [](const Job& job) { return IsFinished(job.stage); });
+}
+
+void AsyncMeshImporter::GetStatuses(std::vector<MeshImportStatus>& out_statuses) const
+{
+    const uint64 now = SDL_GetTicksNS();
+
+    std::lock_guard lock(mutex);
+    out_statuses.clear();
+    out_statuses.reserve(jobs.size());
+    for (const Job& job : jobs)
+    {
+        MeshImportStatus& status = out_statuses.emplace_back();
+        status.job_id = job.id;
+        status.name = job.name;
+        status.stage = job.stage;
+        if (job.start_ticks != 0)
+        {
+            const uint64 end = job.end_ticks != 0 ? job.end_ticks : now;
+            status.elapsed_seconds = static_cast<double>(end - job.start_ticks) / SDL_NS_PER_SECOND;
+        }
+    }
+}
+
+void AsyncMeshImporter::WorkerMain(asset::AssetImporter& importer)
+{
+    while (true)
+    {
+        Path path;
+        uint32 job_id;
+        bool is_reload;
+        uint64 reload_key;
+        MeshProcessor processor;
+        uint64 processor_key;
+        std::shared_ptr<CookedMeshCache> cache;
+        std::shared_ptr<const MeshAssetRegistry> registry;
+        {
+            std::unique_lock lock(mutex);
+            queue_cv.wait(lock, [this] { return is_stopping || !pending.empty(); });
+            if (is_stopping) return;
+
+            job_id = pending.front();
+            pending.pop_front();
+
+            Job* job = FindJob(job_id);
+            job->stage = MeshImportStage::Importing;
+            job->start_ticks = SDL_GetTicksNS();
+            path = job->path;
+            is_reload = job->is_reload;
+            reload_key = job->asset_key;
+            processor = mesh_processor;
+            processor_key = mesh_processor_key;
+            cache = cooked_mesh_cache;
+            registry = mesh_asset_registry;
+        }
+
+        std::vector<ImportedMesh> meshes;
+        bool is_succeeded = false;
+
+        // 원본을 읽지 못하면 파싱도 실패하므로 해시가 없으면 임포트하지 않는다
+        // 재로드는 처음 올릴 때의 키를 그대로 쓴다 (그 뒤에 원본이나 설정이 바뀌었어도 같은 쿠킹 파일을 찾는다)
+        std::optional<uint64> content_hash;
+        if (!is_reload)
+        {
+            ZoneScopedN("AsyncMeshImporter::Hash");
+            content_hash = HashSourceFiles(ToStdPath(path));
+        }
+        const uint64 asset_key = is_reload ? reload_key
+                               : content_hash ? MeshAssetRegistry::MakeKey(*content_hash, processor_key) : 0;
+        const bool has_key = is_reload || content_hash.has_value();
+
+        // 이미 올라가 있으면 메인 스레드가 레지스트리에서 꺼내 쓴다
+        const bool is_registered = !is_reload && content_hash && registry && registry->Contains(asset_key);
+        is_succeeded = is_registered;
+
+        // 같은 내용 / 같은 설정으로 쿠킹해 둔 파일이 있으면 파싱과 후처리를 건너뛴다
+        if (has_key && !is_registered && cache)
+        {
+            ZoneScopedN("AsyncMeshImporter::LoadCooked");
+
+            if (auto cooked = cache->Load(asset_key))
+            {
+                for (GpuMeshData& gpu : *cooked)
+                {
+                    meshes.push_back({ .gpu = std::move(gpu) });
+                }
+                is_succeeded = !meshes.empty();
+            }
+        }
+
+        const bool is_imported = has_key && !is_succeeded;
+        if (is_imported)
+        {
+            ZoneScopedN("AsyncMeshImporter::Import");
+
+            auto assets = importer.Import(path);
+            if (!assets.HasError())
+            {
+                for (const auto& asset : *assets)
+                {
+                    if (auto mesh = std::dynamic_pointer_cast<asset::StaticMesh>(asset))
+                    {
+                        meshes.push_back({ .mesh = std::move(mesh) });
+                    }
+                }
+                is_succeeded = !meshes.empty();
+            }
+        }
+
+        if (is_imported && is_succeeded && processor)
+        {
+            ZoneScopedN("AsyncMeshImporter::Process");
+
+            for (ImportedMesh& mesh : meshes)
+            {
+                processor(mesh);
+            }
+        }
+
+        // 모든 메쉬가 인코딩까지 끝났을 때만 저장한다 (일부만 저장하면 다음에 메쉬가 빠진다)
+        // 재로드에서 다시 임포트한 결과는 키와 내용이 다를 수 있으므로 저장하지 않는다
+        if (is_imported && is_succeeded && !is_reload && cache
+            && std::ranges::all_of(meshes, [](const ImportedMesh& mesh) { return mesh.gpu.IsValid(); }))
+        {
+            ZoneScopedN("AsyncMeshImporter::StoreCooked");
+
+            std::vector<GpuMeshData> cooked;
+            cooked.reserve(meshes.size());
+            for (const ImportedMesh& mesh : meshes)
+            {
+                cooked.push_back(mesh.gpu);
+            }
+            cache->Store(asset_key, cooked);
+        }
+
+        std::lock_guard lock(mutex);
+        Job* job = FindJob(job_id);
+        if (!job) continue; // ClearFinished로 지워질 수는 없지만 방어
+
+        job->end_ticks = SDL_GetTicksNS();
+        if (job->is_cancel_requested)
+        {
+            job->stage = MeshImportStage::Cancelled;
+        }
+        else if (!is_succeeded && !is_reload)
+        {
+            job->stage = MeshImportStage::Failed;
+        }
+        else
+        {
+            // 재로드는 실패해도 빈 결과로 넘겨 메인 스레드가 메쉬 상태를 정리하게 한다
+            job->asset_key = asset_key;
+            job->is_registered = is_registered;
+            job->meshes = std::move(meshes);
+            job->stage = MeshImportStage::Ready;
+            ready.push_back(job_id);
+        }
+    }
+}
+
+AsyncMeshImporter::Job* AsyncMeshImporter::FindJob(uint32 job_id)
+{
+    // 작업 id는 증가 순서로 들어가므로 이분 탐색
+    const auto it = std::ranges::lower_bound(jobs, job_id, {}, &Job::id);
+    return (it != jobs.end() && it->id == job_id) ? &*it : nullptr;
+}
+
+bool AsyncMeshImporter::IsFinished(MeshImportStage stage)
+{
+    return stage == MeshImportStage::Done
+        || stage == MeshImportStage::Failed
+        || stage == MeshImportStage::Cancelled;
+}
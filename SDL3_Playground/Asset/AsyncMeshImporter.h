@@ -0,0 +1,163 @@
+﻿#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/FileDialog.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Container/String.h"
+
+#include "Asset/MeshSimplifier.h"
+#include "Rendering/MeshEncoding.h"
+
+
+namespace se::asset
+{
+class AssetImporter;
+struct StaticMesh;
+}
+
+class CookedMeshCache;
+class MeshAssetRegistry;
+
+enum class MeshImportStage : uint8
+{
+    Queued,    // 워커 대기 중
+    Importing, // 워커에서 파싱 / 후처리 중
+    Ready,     // 메인 스레드 업로드 대기 중
+    Done,
+    Failed,
+    Cancelled,
+};
+
+/// 워커에서 임포트 / 후처리가 끝난 메쉬 하나
+struct ImportedMesh
+{
+    std::shared_ptr<se::asset::StaticMesh> mesh; // 쿠킹 캐시에서 읽었으면 nullptr
+    std::vector<MeshLod> lods;                   // LOD1부터, 후처리에서 만든 경우에만
+    GpuMeshData gpu;                             // 후처리에서 인코딩했거나 쿠킹 캐시에서 매핑한 업로드 데이터
+};
+
+/// 워커에서 만들어진 메쉬 묶음. 메인 스레드가 PopReady로 꺼내 GPU에 올린다.
+struct MeshImportResult
+{
+    uint32 job_id = 0;
+    se::String name;
+    se::Path path;
+    uint64 asset_key = 0;       // 원본 내용 해시 + 후처리 설정 (MeshAssetRegistry::MakeKey)
+    bool is_registered = false; // 레지스트리에 이미 있어 임포트를 건너뛰었다 (meshes는 비어 있다)
+    bool is_reload = false;     // EnqueueReload로 요청한 작업. 실패해도 빈 meshes로 돌려준다
+    std::vector<ImportedMesh> meshes;
+};
+
+/// UI 표시용 작업 상태 스냅샷
+struct MeshImportStatus
+{
+    uint32 job_id = 0;
+    se::String name;
+    MeshImportStage stage = MeshImportStage::Queued;
+    double elapsed_seconds = 0.0; // Importing 이후 경과 시간
+};
+
+/**
+ * 메쉬 파일을 워커 스레드 풀에서 임포트(Assimp 파싱 + StaticMeshFactory)하는 큐
+ *
+ * AssetImporter는 스레드 안전하지 않으므로 워커마다 하나씩 만들어 쓴다.
+ * GPU 업로드는 하지 않으며, 끝난 결과는 메인 스레드가 PopReady로 가져가 프레임 예산 안에서 올린다.
+ * 이미 파싱 중인 작업은 중간에 끊을 수 없으므로, 취소하면 결과를 버린다.
+ *
+ * 워커는 먼저 원본 내용을 해시한다. 같은 내용 / 같은 설정이 레지스트리에 있으면 아무것도 읽지 않고,
+ * 쿠킹 캐시에 있으면 파싱 / 후처리 없이 캐시 파일을 매핑해서 돌려준다.
+ * 둘 다 없으면 임포트 + 후처리한 GpuMeshData를 쿠킹 캐시에 저장해 둔다.
+ */
+class AsyncMeshImporter
+{
+public:
+    using ImporterFactory = std::function<std::unique_ptr<se::asset::AssetImporter>()>;
+    using MeshProcessor = std::function<void(ImportedMesh&)>;
+
+    /// num_workers가 0이면 하드웨어 스레드 수에 맞춰 정한다.
+    explicit AsyncMeshImporter(const ImporterFactory& factory, uint32 num_workers = 0);
+    ~AsyncMeshImporter();
+
+    AsyncMeshImporter(const AsyncMeshImporter&) = delete;
+    AsyncMeshImporter& operator=(const AsyncMeshImporter&) = delete;
+    AsyncMeshImporter(AsyncMeshImporter&&) = delete;
+    AsyncMeshImporter& operator=(AsyncMeshImporter&&) = delete;
+
+public:
+    /// 아무 스레드에서나 호출할 수 있다. 작업 id를 반환한다.
+    uint32 Enqueue(const se::Path& path);
+
+    /// GPU 예산 때문에 내려간 메쉬를 다시 읽는다. 해시 / 레지스트리 확인 없이 asset_key로 쿠킹 캐시를 찾고,
+    /// 없으면 원본을 다시 임포트한다. (쿠킹 캐시에는 저장하지 않는다)
+    /// 그려야 하는 메쉬이므로 취소되지 않고, 성공하면 MarkDone에서 목록에서 바로 지운다.
+    uint32 EnqueueReload(const se::Path& path, uint64 asset_key);
+
+    /// 임포트 직후 워커에서 메쉬마다 실행할 후처리 단계 (최적화 등). 이후 시작하는 작업부터 적용된다.
+    /// 여러 워커에서 동시에 불리므로 processor는 스레드 안전해야 한다. 빈 함수를 넘기면 해제된다.
+    /// settings_key는 processor의 설정을 나타내는 값으로, 쿠킹 캐시 키에 섞인다.
+    void SetMeshProcessor(MeshProcessor processor, uint64 settings_key = 0);
+
+    /// 쿠킹 캐시를 쓴다. processor가 ImportedMesh::gpu를 채운 결과만 저장된다. nullptr이면 쓰지 않는다.
+    void SetCookedMeshCache(std::shared_ptr<CookedMeshCache> cache);
+
+    /// 이미 올라간 원본인지 확인할 레지스트리. nullptr이면 항상 임포트한다.
+    void SetMeshAssetRegistry(std::shared_ptr<const MeshAssetRegistry> registry);
+
+    void Cancel(uint32 job_id);
+    void CancelAll();
+
+    /// Ready 상태의 결과를 최대 하나 꺼낸다. 메인 스레드에서 호출한다.
+    bool PopReady(MeshImportResult& out_result);
+
+    /// PopReady로 꺼낸 작업의 업로드가 끝났음을 알린다.
+    void MarkDone(uint32 job_id, bool is_succeeded);
+
+    /// Done / Failed / Cancelled 상태의 작업을 목록에서 지운다.
+    void ClearFinished();
+
+    void GetStatuses(std::vector<MeshImportStatus>& out_statuses) const;
+    [[nodiscard]] uint32 GetNumWorkers() const { return static_cast<uint32>(workers.size()); }
+
+private:
+    struct Job
+    {
+        uint32 id = 0;
+        se::Path path;
+        se::String name;
+        MeshImportStage stage = MeshImportStage::Queued;
+        uint64 start_ticks = 0;
+        uint64 end_ticks = 0;
+        bool is_cancel_requested = false;
+        uint64 asset_key = 0;
+        bool is_registered = false;
+        bool is_reload = false;
+        std::vector<ImportedMesh> meshes;
+    };
+
+    void WorkerMain(se::asset::AssetImporter& importer);
+    Job* FindJob(uint32 job_id);
+    static bool IsFinished(MeshImportStage stage);
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable queue_cv;
+
+    std::deque<Job> jobs;          // 등록 순서, 상태 표시용
+    std::deque<uint32> pending;    // Queued
+    std::deque<uint32> ready;      // Ready
+    uint32 next_job_id = 1;
+    bool is_stopping = false;
+    MeshProcessor mesh_processor;
+    uint64 mesh_processor_key = 0;
+    std::shared_ptr<CookedMeshCache> cooked_mesh_cache;
+    std::shared_ptr<const MeshAssetRegistry> mesh_asset_registry;
+
+    std::vector<std::unique_ptr<se::asset::AssetImporter>> importers;
+    std::vector<std::thread> workers;
+};
@@ -0,0 +1,44 @@
+﻿#include "CacheFile.h"
+
+#include <format>
+#include <fstream>
+
+#include "SDL3/SDL.h"
+
+
+double SecondsSince(uint64 start_counter)
+{
+    return static_cast<double>(SDL_GetPerformanceCounter() - start_counter)
+         / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+bool WriteFileAtomically(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write)
+{
+    std::filesystem::path temp_path = path;
+    temp_path += std::format(".{}.tmp", SDL_GetCurrentThreadID());
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+
+        write(file);
+        if (!file)
+        {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
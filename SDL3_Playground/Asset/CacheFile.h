@@ -0,0 +1,15 @@
+﻿#pragma once
+#include <filesystem>
+#include <functional>
+#include <ostream>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/// SDL_GetPerformanceCounter로 잰 시작 시점부터 지난 초
+double SecondsSince(uint64 start_counter);
+
+/* 다른 스레드나 프로세스가 쓰는 중인 파일을 읽지 않도록 임시 파일에 쓴 뒤 이름을 바꿔 path에 놓는다.
+ * write가 스트림을 실패 상태로 남기거나 이름을 바꾸지 못하면 임시 파일을 지우고 false
+ */
+bool WriteFileAtomically(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write);
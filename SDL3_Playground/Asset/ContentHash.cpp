@@ -0,0 +1,261 @@
+﻿#include "ContentHash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "Asset/CookedMeshCache.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    constexpr uint64 Prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64 Prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64 Prime3 = 0x165667B19E3779F9ull;
+    constexpr uint64 Prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64 Prime5 = 0x27D4EB2F165667C5ull;
+
+    uint64 Read64(const uint8* bytes)
+    {
+        uint64 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32 Read32(const uint8* bytes)
+    {
+        uint32 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint64 Round(uint64 acc, uint64 input)
+    {
+        acc += input * Prime2;
+        acc = std::rotl(acc, 31);
+        return acc * Prime1;
+    }
+
+    uint64 MergeRound(uint64 acc, uint64 value)
+    {
+        acc ^= Round(0, value);
+        return acc * Prime1 + Prime4;
+    }
+
+    std::string_view ToStringView(std::span<const uint8> bytes)
+    {
+        return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+    }
+
+    std::string_view Trim(std::string_view text)
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+        return text;
+    }
+
+    /// uri의 %XX를 풀어 쓴다. (glTF uri는 퍼센트 인코딩이다)
+    std::string DecodeUri(std::string_view uri)
+    {
+        std::string decoded;
+        decoded.reserve(uri.size());
+        for (size_t i = 0; i < uri.size(); ++i)
+        {
+            if (uri[i] == '%' && i + 2 < uri.size()
+                && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) && std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+            {
+                decoded += static_cast<char>(std::stoi(std::string(uri.substr(i + 1, 2)), nullptr, 16));
+                i += 2;
+            }
+            else
+            {
+                decoded += uri[i];
+            }
+        }
+        return decoded;
+    }
+
+    /// glTF에서 "uri" 값은 buffers와 images에만 있다. JSON 전체를 파싱하지 않고 키만 찾는다.
+    void FindGltfDependencies(std::string_view json, std::vector<std::string>& out_names)
+    {
+        constexpr std::string_view UriKey = "\"uri\"";
+        for (size_t pos = json.find(UriKey); pos != std::string_view::npos; pos = json.find(UriKey, pos))
+        {
+            pos += UriKey.size();
+            while (pos < json.size() && (std::isspace(static_cast<unsigned char>(json[pos])) || json[pos] == ':')) ++pos;
+            if (pos >= json.size() || json[pos] != '"') continue;
+
+            std::string value;
+            for (++pos; pos < json.size() && json[pos] != '"'; ++pos)
+            {
+                // \/, \\ 같은 이스케이프는 뒤 글자만 남긴다
+                if (json[pos] == '\\' && pos + 1 < json.size()) ++pos;
+                value += json[pos];
+            }
+
+            if (!value.empty() && !value.starts_with("data:"))
+            {
+                out_names.push_back(DecodeUri(value));
+            }
+        }
+    }
+
+    /// OBJ의 "mtllib a.mtl b.mtl" 줄
+    void FindObjDependencies(std::string_view text, const std::filesystem::path& directory, std::vector<std::string>& out_names)
+    {
+        constexpr std::string_view MtlLib = "mtllib";
+        for (size_t line_start = 0; line_start < text.size();)
+        {
+            size_t line_end = text.find('\n', line_start);
+            if (line_end == std::string_view::npos) line_end = text.size();
+
+            const std::string_view line = Trim(text.substr(line_start, line_end - line_start));
+            line_start = line_end + 1;
+            if (!line.starts_with(MtlLib) || line.size() == MtlLib.size() || !std::isspace(static_cast<unsigned char>(line[MtlLib.size()])))
+            {
+                continue;
+            }
+
+            // 공백이 든 파일 이름일 수 있으므로 줄 전체가 파일 이름인지 먼저 본다
+            const std::string_view names = Trim(line.substr(MtlLib.size()));
+            std::error_code ec;
+            if (std::filesystem::exists(directory / std::string(names), ec))
+            {
+                out_names.emplace_back(names);
+                continue;
+            }
+
+            for (size_t pos = 0; pos < names.size();)
+            {
+                const size_t end = std::min(names.find_first_of(" \t", pos), names.size());
+                if (end > pos)
+                {
+                    out_names.emplace_back(names.substr(pos, end - pos));
+                }
+                pos = end + 1;
+            }
+        }
+    }
+
+    std::vector<std::filesystem::path> FindDependencies(const std::filesystem::path& source_path, std::span<const uint8> source_bytes)
+    {
+        std::string extension = source_path.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        std::vector<std::string> names;
+        if (extension == ".gltf")
+        {
+            FindGltfDependencies(ToStringView(source_bytes), names);
+        }
+        else if (extension == ".obj")
+        {
+            FindObjDependencies(ToStringView(source_bytes), source_path.parent_path(), names);
+        }
+
+        std::vector<std::filesystem::path> dependencies;
+        for (const std::string& name : names)
+        {
+            std::filesystem::path path = (source_path.parent_path() / std::filesystem::path(name)).lexically_normal();
+            if (std::ranges::find(dependencies, path) == dependencies.end())
+            {
+                dependencies.push_back(std::move(path));
+            }
+        }
+        return dependencies;
+    }
+}
+
+uint64 HashBytes(std::span<const uint8> bytes, uint64 seed)
+{
+    const uint8* p = bytes.data();
+    const uint8* const end = p + bytes.size();
+
+    uint64 hash;
+    if (bytes.size() >= 32)
+    {
+        // 독립된 누산기 4개로 32바이트씩 처리한다
+        uint64 v1 = seed + Prime1 + Prime2;
+        uint64 v2 = seed + Prime2;
+        uint64 v3 = seed;
+        uint64 v4 = seed - Prime1;
+
+        do
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + Prime5;
+    }
+
+    hash += bytes.size();
+
+    for (; end - p >= 8; p += 8)
+    {
+        hash ^= Round(0, Read64(p));
+        hash = std::rotl(hash, 27) * Prime1 + Prime4;
+    }
+    if (end - p >= 4)
+    {
+        hash ^= static_cast<uint64>(Read32(p)) * Prime1;
+        hash = std::rotl(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+    {
+        hash ^= *p * Prime5;
+        hash = std::rotl(hash, 11) * Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::vector<std::filesystem::path> FindSourceDependencies(const std::filesystem::path& source_path)
+{
+    const MappedFile source(source_path);
+    if (!source.IsValid())
+    {
+        return {};
+    }
+    return FindDependencies(source_path, source.GetBytes());
+}
+
+std::optional<uint64> HashSourceFiles(const std::filesystem::path& source_path)
+{
+    ZoneScoped;
+
+    const MappedFile source(source_path);
+    if (!source.IsValid())
+    {
+        return std::nullopt;
+    }
+
+    uint64 hash = HashBytes(source.GetBytes());
+    for (const std::filesystem::path& dependency : FindDependencies(source_path, source.GetBytes()))
+    {
+        // 없거나 비어 있는 파일도 빈 내용으로 섞어, 나중에 생기면 키가 바뀌게 한다
+        const MappedFile file(dependency);
+        hash = HashBytes(file.IsValid() ? file.GetBytes() : std::span<const uint8>{}, hash);
+    }
+    return hash;
+}
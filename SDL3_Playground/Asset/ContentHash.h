@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/// XXH64. 8바이트씩 처리하므로 디스크보다 빨라서 해시가 병목이 되지 않는다.
+uint64 HashBytes(std::span<const uint8> bytes, uint64 seed = 0);
+
+/* 원본이 참조해 임포트할 때 같이 읽히는 파일 (glTF의 buffer / image uri, OBJ의 mtllib)
+ * 원본 폴더 기준 경로를 참조 순서대로 중복 없이 돌려준다. 없는 파일도 그대로 넣는다.
+ * data: uri나 GLB / FBX처럼 원본 안에 들어 있는 데이터는 없다. 원본을 읽지 못하면 빈 목록
+ */
+std::vector<std::filesystem::path> FindSourceDependencies(const std::filesystem::path& source_path);
+
+/* 임포트 원본의 내용 해시
+ * 원본 뒤에 FindSourceDependencies의 파일들을 참조 순서대로 이어서 해시하고, 없는 파일은 빈 내용으로 친다.
+ * 파일 이름과 경로는 넣지 않으므로 복사한 파일도 같은 해시가 된다. 원본을 읽지 못하면 nullopt
+ */
+std::optional<uint64> HashSourceFiles(const std::filesystem::path& source_path);
@@ -0,0 +1,411 @@
+﻿#include "CookedMeshCache.h"
+
+#include <cstring>
+#include <format>
+
+#include "Asset/CacheFile.h"
+#include "Asset/ContentHash.h"
+#include "SDL3/SDL.h"
+#include "tracy/Tracy.hpp"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#if defined(_WIN32)
+    const HANDLE file = CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+    data = static_cast<const uint8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    struct stat file_stat = {};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        close(fd);
+        return;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 매핑은 파일 디스크립터가 닫혀도 유지된다
+    if (view == MAP_FAILED) return;
+
+    // 곧 전부 Transfer Buffer로 복사하므로 미리 읽기를 요청한다
+    madvise(view, static_cast<size_t>(file_stat.st_size), MADV_WILLNEED);
+
+    data = static_cast<const uint8*>(view);
+    size = static_cast<size_t>(file_stat.st_size);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    if (!data) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+#else
+    munmap(const_cast<uint8*>(data), size);
+#endif
+}
+
+
+namespace
+{
+    constexpr uint32 CacheMagic = 0x4D434553; // "SECM"
+    constexpr uint32 CacheVersion = 2;        // 저장 형식이나 MeshGpuFormat / 정점 형식이 바뀌면 올린다
+    constexpr uint64 PayloadAlignment = 16;
+
+    /* 파일 배치
+     * [CookedFileHeader][CookedMeshEntry x num_meshes][메쉬별 테이블][패딩][메쉬별 정점 / 인덱스 바이트 ...]
+     *
+     * 메쉬별 테이블: int32 section_vertex_offsets[num_sections],
+     *               LOD마다 CookedLodEntry + GpuIndexRange[num_sections]
+     * 헤더와 테이블만 체크섬을 둔다. 정점 / 인덱스는 임시 파일에 다 쓴 뒤 이름을 바꾸므로
+     * 잘린 파일은 생기지 않고, 전체를 해시하면 읽기가 IO가 아니라 해시에 묶인다.
+     */
+    struct CookedFileHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 key;
+        uint32 num_meshes;
+        uint32 reserved;
+        uint64 table_size;     // 헤더 뒤 엔트리 + 테이블 바이트 수
+        uint64 table_checksum;
+    };
+
+    struct CookedMeshEntry
+    {
+        uint64 vertex_offset;
+        uint64 vertex_size;
+        uint64 index_offset;
+        uint64 index_size;
+        uint64 full_format_bytes;
+        float bounds_min[3];
+        float bounds_max[3];
+        PositionDequantize dequantize;
+        uint32 is_compact;
+        uint32 index_element_size; // SDL_GPUIndexElementSize
+        uint32 num_sections;
+        uint32 num_lods;
+    };
+
+    struct CookedLodEntry
+    {
+        uint32 num_triangles;
+        float error;
+    };
+
+    /// 테이블을 앞에서부터 읽는다. 범위를 넘으면 이후 읽기는 모두 실패한다.
+    struct TableReader
+    {
+        std::span<const uint8> bytes;
+        size_t offset = 0;
+        bool is_valid = true;
+
+        template <typename T>
+        bool Read(T* out_values, size_t count)
+        {
+            const size_t size = sizeof(T) * count;
+            if (!is_valid || size > bytes.size() - offset)
+            {
+                is_valid = false;
+                return false;
+            }
+            std::memcpy(out_values, bytes.data() + offset, size);
+            offset += size;
+            return true;
+        }
+    };
+
+    template <typename T>
+    void AppendBytes(std::vector<uint8>& out_bytes, const T* values, size_t count)
+    {
+        const auto* bytes = reinterpret_cast<const uint8*>(values);
+        out_bytes.insert(out_bytes.end(), bytes, bytes + sizeof(T) * count);
+    }
+
+    uint64 AlignUp(uint64 value, uint64 alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /// 매핑에서 메쉬 목록을 만든다. 구조가 맞지 않으면 nullopt
+    std::optional<std::vector<GpuMeshData>> ParseCookedFile(const std::shared_ptr<const MappedFile>& file, uint64 key)
+    {
+        const std::span<const uint8> bytes = file->GetBytes();
+        if (bytes.size() < sizeof(CookedFileHeader)) return std::nullopt;
+
+        CookedFileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != CacheMagic || header.version != CacheVersion || header.key != key
+            || header.table_size > bytes.size() - sizeof(header))
+        {
+            return std::nullopt;
+        }
+
+        const std::span<const uint8> table = bytes.subspan(sizeof(header), header.table_size);
+        if (HashBytes(table) != header.table_checksum) return std::nullopt;
+
+        // 개수는 테이블 크기로 먼저 걸러서 큰 값으로 할당하지 않게 한다
+        if (header.num_meshes == 0 || header.num_meshes > table.size() / sizeof(CookedMeshEntry)) return std::nullopt;
+
+        TableReader reader{ .bytes = table };
+        std::vector<CookedMeshEntry> entries(header.num_meshes);
+        if (!reader.Read(entries.data(), entries.size())) return std::nullopt;
+
+        std::vector<GpuMeshData> meshes;
+        meshes.reserve(entries.size());
+        for (const CookedMeshEntry& entry : entries)
+        {
+            const bool is_payload_valid = entry.vertex_size > 0 && entry.index_size > 0
+                                       && entry.vertex_offset <= bytes.size() && entry.vertex_size <= bytes.size() - entry.vertex_offset
+                                       && entry.index_offset <= bytes.size() && entry.index_size <= bytes.size() - entry.index_offset;
+            const bool is_table_valid = entry.num_lods > 0
+                                     && entry.num_sections <= table.size() / sizeof(int32)
+                                     && entry.num_lods <= table.size() / sizeof(CookedLodEntry);
+            if (!is_payload_valid || !is_table_valid) return std::nullopt;
+
+            GpuMeshData& mesh = meshes.emplace_back();
+            mesh.vertex_data = bytes.subspan(entry.vertex_offset, entry.vertex_size);
+            mesh.index_data = bytes.subspan(entry.index_offset, entry.index_size);
+            mesh.full_format_bytes = entry.full_format_bytes;
+            mesh.bounds.min.x = entry.bounds_min[0];
+            mesh.bounds.min.y = entry.bounds_min[1];
+            mesh.bounds.min.z = entry.bounds_min[2];
+            mesh.bounds.max.x = entry.bounds_max[0];
+            mesh.bounds.max.y = entry.bounds_max[1];
+            mesh.bounds.max.z = entry.bounds_max[2];
+            mesh.storage = file;
+
+            MeshGpuFormat& format = mesh.format;
+            format.is_compact = entry.is_compact != 0;
+            format.index_element_size = static_cast<SDL_GPUIndexElementSize>(entry.index_element_size);
+            format.dequantize = entry.dequantize;
+
+            format.section_vertex_offsets.resize(entry.num_sections);
+            reader.Read(format.section_vertex_offsets.data(), entry.num_sections);
+
+            format.lods.resize(entry.num_lods);
+            for (GpuMeshLod& lod : format.lods)
+            {
+                CookedLodEntry lod_entry = {};
+                reader.Read(&lod_entry, 1);
+                lod.num_triangles = lod_entry.num_triangles;
+                lod.error = lod_entry.error;
+
+                lod.sections.resize(entry.num_sections);
+                reader.Read(lod.sections.data(), entry.num_sections);
+            }
+
+            if (!reader.is_valid) return std::nullopt;
+        }
+        return meshes;
+    }
+}
+
+CookedMeshCache::CookedMeshCache(std::filesystem::path cache_dir)
+    : cache_dir(std::move(cache_dir))
+{
+    std::error_code ec;
+    std::filesystem::create_directories(this->cache_dir, ec);
+}
+
+std::optional<std::vector<GpuMeshData>> CookedMeshCache::Load(uint64 key)
+{
+    ZoneScoped;
+    const uint64 start = SDL_GetPerformanceCounter();
+
+    std::optional<std::vector<GpuMeshData>> result;
+    bool is_corrupted = false;
+
+    const std::filesystem::path entry_path = MakeEntryPath(key);
+    std::error_code ec;
+    if (std::filesystem::exists(entry_path, ec))
+    {
+        auto file = std::make_shared<const MappedFile>(entry_path);
+        if (file->IsValid())
+        {
+            result = ParseCookedFile(file, key);
+        }
+        is_corrupted = !result.has_value();
+    }
+
+    uint64 loaded_bytes = 0;
+    if (result)
+    {
+        for (const GpuMeshData& mesh : *result)
+        {
+            loaded_bytes += mesh.vertex_data.size() + mesh.index_data.size();
+        }
+    }
+
+    std::lock_guard lock(stats_mutex);
+    stats.load_seconds += SecondsSince(start);
+    if (result)
+    {
+        ++stats.hits;
+        stats.loaded_bytes += loaded_bytes;
+    }
+    else
+    {
+        ++stats.misses;
+        stats.corrupted += is_corrupted ? 1 : 0;
+    }
+    return result;
+}
+
+void CookedMeshCache::Store(uint64 key, std::span<const GpuMeshData> meshes)
+{
+    ZoneScoped;
+    const uint64 start = SDL_GetPerformanceCounter();
+
+    // 테이블 크기를 먼저 알아야 페이로드 위치가 정해진다
+    uint64 table_size = sizeof(CookedMeshEntry) * meshes.size();
+    for (const GpuMeshData& mesh : meshes)
+    {
+        const uint64 num_sections = mesh.format.section_vertex_offsets.size();
+        table_size += sizeof(int32) * num_sections;
+        table_size += (sizeof(CookedLodEntry) + sizeof(GpuIndexRange) * num_sections) * mesh.format.lods.size();
+    }
+
+    std::vector<uint8> table;
+    table.reserve(table_size);
+
+    std::vector<CookedMeshEntry> entries(meshes.size());
+    uint64 payload_offset = AlignUp(sizeof(CookedFileHeader) + table_size, PayloadAlignment);
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        const GpuMeshData& mesh = meshes[i];
+        CookedMeshEntry& entry = entries[i];
+        entry = {
+            .vertex_offset = payload_offset,
+            .vertex_size = mesh.vertex_data.size(),
+            .index_offset = AlignUp(payload_offset + mesh.vertex_data.size(), PayloadAlignment),
+            .index_size = mesh.index_data.size(),
+            .full_format_bytes = mesh.full_format_bytes,
+            .bounds_min = { mesh.bounds.min.x, mesh.bounds.min.y, mesh.bounds.min.z },
+            .bounds_max = { mesh.bounds.max.x, mesh.bounds.max.y, mesh.bounds.max.z },
+            .dequantize = mesh.format.dequantize,
+            .is_compact = mesh.format.is_compact ? 1u : 0u,
+            .index_element_size = static_cast<uint32>(mesh.format.index_element_size),
+            .num_sections = static_cast<uint32>(mesh.format.section_vertex_offsets.size()),
+            .num_lods = static_cast<uint32>(mesh.format.lods.size()),
+        };
+        payload_offset = AlignUp(entry.index_offset + entry.index_size, PayloadAlignment);
+
+        // LOD마다 섹션 수가 같아야 테이블을 다시 읽을 수 있다
+        for (const GpuMeshLod& lod : mesh.format.lods)
+        {
+            if (lod.sections.size() != entry.num_sections) return;
+        }
+    }
+
+    AppendBytes(table, entries.data(), entries.size());
+    for (const GpuMeshData& mesh : meshes)
+    {
+        AppendBytes(table, mesh.format.section_vertex_offsets.data(), mesh.format.section_vertex_offsets.size());
+        for (const GpuMeshLod& lod : mesh.format.lods)
+        {
+            const CookedLodEntry lod_entry = { .num_triangles = lod.num_triangles, .error = lod.error };
+            AppendBytes(table, &lod_entry, 1);
+            AppendBytes(table, lod.sections.data(), lod.sections.size());
+        }
+    }
+
+    const CookedFileHeader header = {
+        .magic = CacheMagic,
+        .version = CacheVersion,
+        .key = key,
+        .num_meshes = static_cast<uint32>(meshes.size()),
+        .reserved = 0,
+        .table_size = table.size(),
+        .table_checksum = HashBytes(table),
+    };
+
+    const bool is_written = WriteFileAtomically(MakeEntryPath(key), [&](std::ostream& file)
+    {
+        uint64 written = 0;
+        const auto write = [&file, &written](const void* data, uint64 size)
+        {
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written += size;
+        };
+        const auto pad_to = [&file, &written](uint64 offset)
+        {
+            static constexpr char zeros[PayloadAlignment] = {};
+            file.write(zeros, static_cast<std::streamsize>(offset - written));
+            written = offset;
+        };
+
+        write(&header, sizeof(header));
+        write(table.data(), table.size());
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            pad_to(entries[i].vertex_offset);
+            write(meshes[i].vertex_data.data(), meshes[i].vertex_data.size());
+            pad_to(entries[i].index_offset);
+            write(meshes[i].index_data.data(), meshes[i].index_data.size());
+        }
+    });
+    if (!is_written)
+    {
+        return;
+    }
+
+    std::lock_guard lock(stats_mutex);
+    ++stats.stores;
+    stats.store_seconds += SecondsSince(start);
+}
+
+CookedMeshCacheStats CookedMeshCache::GetStats() const
+{
+    std::lock_guard lock(stats_mutex);
+    return stats;
+}
+
+std::filesystem::path CookedMeshCache::MakeEntryPath(uint64 key) const
+{
+    return cache_dir / std::format("{:016x}.mesh", key);
+}
@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+#include "Rendering/MeshEncoding.h"
+
+
+/**
+ * 읽기 전용으로 메모리에 매핑한 파일
+ *
+ * 페이지는 처음 접근할 때 읽히므로 여는 비용은 파일 크기와 무관하다.
+ * 매핑은 객체가 살아 있는 동안 유지된다.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+public:
+    [[nodiscard]] bool IsValid() const { return data != nullptr; }
+    [[nodiscard]] std::span<const uint8> GetBytes() const { return { data, size }; }
+
+private:
+    const uint8* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+struct CookedMeshCacheStats
+{
+    uint32 hits = 0;
+    uint32 misses = 0;
+    uint32 stores = 0;
+    uint32 corrupted = 0;     // 헤더/테이블이 맞지 않아 버린 항목
+    uint64 loaded_bytes = 0;  // 매핑한 정점 / 인덱스 바이트
+    double load_seconds = 0.0;
+    double store_seconds = 0.0;
+};
+
+/**
+ * 임포트 + 후처리 + GPU 인코딩까지 끝난 메쉬를 디스크에 저장해 두는 캐시
+ *
+ * 파일에는 GeometryBuffer::Upload가 받는 정점 / 인덱스 바이트가 그대로 들어 있어서,
+ * 다시 읽을 때는 파일을 매핑하고 GpuMeshData가 매핑 안을 가리키게만 한다.
+ * (StaticMesh / se::Array를 거치지 않고 매핑에서 바로 Transfer Buffer로 복사된다)
+ *
+ * 키는 MeshAssetRegistry::MakeKey(원본 내용 해시 + 후처리 설정)를 그대로 쓴다. 원본이 바뀌면 다른 항목이 된다.
+ * 여러 스레드에서 동시에 호출해도 된다.
+ */
+class CookedMeshCache
+{
+public:
+    explicit CookedMeshCache(std::filesystem::path cache_dir);
+
+public:
+    /// 반환된 GpuMeshData들은 매핑을 공유해서 붙잡고 있다.
+    [[nodiscard]] std::optional<std::vector<GpuMeshData>> Load(uint64 key);
+    void Store(uint64 key, std::span<const GpuMeshData> meshes);
+
+    [[nodiscard]] CookedMeshCacheStats GetStats() const;
+    [[nodiscard]] const std::filesystem::path& GetCacheDir() const { return cache_dir; }
+
+private:
+    [[nodiscard]] std::filesystem::path MakeEntryPath(uint64 key) const;
+
+private:
+    std::filesystem::path cache_dir;
+
+    mutable std::mutex stats_mutex;
+    CookedMeshCacheStats stats;
+};
@@ -0,0 +1,123 @@
+﻿#include "MeshAssetRegistry.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "tracy/Tracy.hpp"
+
+
+uint64 MeshAssetRegistry::MakeKey(uint64 content_hash, uint64 settings_key)
+{
+    // boost::hash_combine의 64비트 버전
+    return content_hash ^ (settings_key + 0x9E3779B97F4A7C15ull + (content_hash << 12) + (content_hash >> 4));
+}
+
+bool MeshAssetRegistry::Contains(uint64 key) const
+{
+    std::lock_guard lock(mutex);
+    return entries.contains(key);
+}
+
+std::vector<std::shared_ptr<LoadedMesh>> MeshAssetRegistry::Share(uint64 key)
+{
+    ZoneScoped;
+
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        return {};
+    }
+
+    ++stats.shared_imports;
+    stats.shared_bytes += it->second.gpu_bytes;
+    return it->second.meshes;
+}
+
+std::vector<std::shared_ptr<LoadedMesh>> MeshAssetRegistry::Find(uint64 key) const
+{
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(key);
+    return it != entries.end() ? it->second.meshes : std::vector<std::shared_ptr<LoadedMesh>>{};
+}
+
+void MeshAssetRegistry::Acquire(uint64 key, uint32 count)
+{
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(key);
+    assert(it != entries.end());
+    if (it != entries.end())
+    {
+        it->second.num_references += count;
+    }
+}
+
+void MeshAssetRegistry::Release(uint64 key, const ReleaseFunc& release)
+{
+    ZoneScoped;
+
+    Entry released;
+    {
+        std::lock_guard lock(mutex);
+        const auto it = entries.find(key);
+        assert(it != entries.end() && it->second.num_references > 0);
+        if (it == entries.end() || --it->second.num_references > 0)
+        {
+            return;
+        }
+
+        released = std::move(it->second);
+        entries.erase(it);
+        std::erase(order, key);
+
+        stats.num_assets = static_cast<uint32>(entries.size());
+        stats.num_meshes -= static_cast<uint32>(released.meshes.size());
+        ++stats.released_assets;
+    }
+
+    // release는 GeometryBuffer 등 레지스트리 밖을 건드리므로 잠금 밖에서 부른다
+    for (const std::shared_ptr<LoadedMesh>& mesh : released.meshes)
+    {
+        release(*mesh);
+    }
+}
+
+void MeshAssetRegistry::Register(uint64 key, std::vector<std::shared_ptr<LoadedMesh>> new_meshes, uint64 gpu_bytes)
+{
+    ZoneScoped;
+    assert(!new_meshes.empty());
+
+    std::lock_guard lock(mutex);
+    auto [it, is_inserted] = entries.try_emplace(key);
+    if (!is_inserted)
+    {
+        return; // 같은 파일을 동시에 임포트한 경우, 먼저 등록된 쪽을 쓴다 (보통은 호출 전에 Share로 걸러진다)
+    }
+
+    order.push_back(key);
+    stats.num_assets = static_cast<uint32>(entries.size());
+    stats.num_meshes += static_cast<uint32>(new_meshes.size());
+
+    it->second.meshes = std::move(new_meshes);
+    it->second.gpu_bytes = gpu_bytes;
+}
+
+std::shared_ptr<LoadedMesh> MeshAssetRegistry::GetFirstMesh() const
+{
+    std::lock_guard lock(mutex);
+    for (const uint64 key : order)
+    {
+        const Entry& entry = entries.at(key);
+        if (!entry.meshes.empty())
+        {
+            return entry.meshes.front();
+        }
+    }
+    return nullptr;
+}
+
+MeshAssetRegistryStats MeshAssetRegistry::GetStats() const
+{
+    std::lock_guard lock(mutex);
+    return stats;
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+struct LoadedMesh;
+
+struct MeshAssetRegistryStats
+{
+    uint32 num_assets = 0;      // 등록된 원본 파일 (키) 수
+    uint32 num_meshes = 0;
+    uint32 shared_imports = 0;  // 기존 항목을 돌려준 임포트 수
+    uint64 shared_bytes = 0;    // 공유 덕분에 다시 올리지 않은 GPU 바이트
+    uint32 released_assets = 0; // 쓰는 엔티티가 없어져 지운 항목 수
+};
+
+/**
+ * 원본 내용 해시 + 임포트 설정을 키로, 한 번 올린 LoadedMesh(와 GPU 슬라이스)를 공유하는 레지스트리
+ *
+ * 같은 파일을 다시 임포트하면 새로 파싱 / 업로드하지 않고 기존 LoadedMesh를 돌려준다.
+ * 키의 메쉬를 쓰는 엔티티 수는 엔티티를 만들고 지울 때 Acquire / Release로 직접 센다.
+ * 0이 되면 GPU 슬라이스를 내리고 항목을 지우므로, 다시 임포트하면 새로 올린다.
+ * Contains는 임포트 워커에서, 나머지는 메인 스레드에서 호출한다.
+ */
+class MeshAssetRegistry
+{
+public:
+    using ReleaseFunc = std::function<void(LoadedMesh&)>;
+
+
+    [[nodiscard]] static uint64 MakeKey(uint64 content_hash, uint64 settings_key);
+
+    /// 등록된 키인지 본다. 아무 스레드에서나 호출할 수 있다.
+    [[nodiscard]] bool Contains(uint64 key) const;
+
+    /// 등록된 메쉬들을 돌려주고 공유 통계를 올린다. 없으면 빈 배열
+    /// 참조 수는 바꾸지 않으므로 메쉬를 엔티티에 붙이면 Acquire를 따로 부른다.
+    [[nodiscard]] std::vector<std::shared_ptr<LoadedMesh>> Share(uint64 key);
+
+    /// Share와 같지만 공유 통계를 올리지 않는다. (내려간 메쉬를 다시 올릴 때)
+    [[nodiscard]] std::vector<std::shared_ptr<LoadedMesh>> Find(uint64 key) const;
+
+    /// 키의 메쉬를 쓰는 엔티티를 count개 만들었다. 등록된 키여야 한다.
+    void Acquire(uint64 key, uint32 count = 1);
+
+    /// 키의 메쉬를 쓰던 엔티티를 지웠다. 0이 되면 메쉬마다 release를 불러 GPU 슬라이스를 내리게 한 뒤 항목을 지운다.
+    void Release(uint64 key, const ReleaseFunc& release);
+
+    /// 새로 올린 메쉬들을 등록한다. gpu_bytes는 이 키의 메쉬들이 차지하는 GPU 바이트
+    /// 빈 항목은 아무도 Release하지 않으므로 하나 이상 올린 경우에만 부른다.
+    void Register(uint64 key, std::vector<std::shared_ptr<LoadedMesh>> meshes, uint64 gpu_bytes);
+
+    /// 등록 순서대로 모든 메쉬와, 레지스트리 밖에서 그 메쉬를 참조하는 수(엔티티, 그리는 중인 배치)를 넘긴다.
+    /// func(const std::shared_ptr<LoadedMesh>&, uint32 num_references)
+    template <typename Func>
+    void ForEachMesh(Func&& func) const
+    {
+        std::lock_guard lock(mutex);
+        for (const uint64 key : order)
+        {
+            for (const std::shared_ptr<LoadedMesh>& mesh : entries.at(key).meshes)
+            {
+                func(mesh, static_cast<uint32>(mesh.use_count() - 1));
+            }
+        }
+    }
+
+    /// 처음 등록된 메쉬. 없으면 nullptr
+    [[nodiscard]] std::shared_ptr<LoadedMesh> GetFirstMesh() const;
+
+    [[nodiscard]] MeshAssetRegistryStats GetStats() const;
+
+private:
+    struct Entry
+    {
+        std::vector<std::shared_ptr<LoadedMesh>> meshes;
+        uint64 gpu_bytes = 0;
+        uint32 num_references = 0; // 메쉬를 쓰는 엔티티 수
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<uint64, Entry> entries;
+    std::vector<uint64> order; // 등록 순서
+    MeshAssetRegistryStats stats;
+};
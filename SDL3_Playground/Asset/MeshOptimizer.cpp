@@ -0,0 +1,522 @@
+﻿#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    constexpr uint32 InvalidIndex = ~0u;
+
+    /* Forsyth, "Linear-Speed Vertex Cache Optimisation"의 점수 함수
+     * 캐시에 최근 들어온 정점일수록, 남은 삼각형이 적은 정점일수록 점수가 높다.
+     */
+    constexpr uint32 ForsythCacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+    constexpr uint32 MaxValenceTable = 32;
+
+    struct ForsythTables
+    {
+        std::array<float, ForsythCacheSize> cache_score;
+        std::array<float, MaxValenceTable> valence_score;
+
+        ForsythTables()
+        {
+            for (uint32 i = 0; i < ForsythCacheSize; ++i)
+            {
+                if (i < 3)
+                {
+                    cache_score[i] = LastTriangleScore;
+                }
+                else
+                {
+                    const float scaler = 1.0f / static_cast<float>(ForsythCacheSize - 3);
+                    cache_score[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, CacheDecayPower);
+                }
+            }
+            valence_score[0] = 0.0f;
+            for (uint32 i = 1; i < MaxValenceTable; ++i)
+            {
+                valence_score[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+            }
+        }
+    };
+
+    float GetVertexScore(const ForsythTables& tables, int32 cache_position, uint32 num_active_triangles)
+    {
+        if (num_active_triangles == 0)
+        {
+            return -1.0f; // 더 이상 쓰이지 않는 정점
+        }
+
+        const float cache = cache_position >= 0 ? tables.cache_score[cache_position] : 0.0f;
+        const float valence = num_active_triangles < MaxValenceTable
+                            ? tables.valence_score[num_active_triangles]
+                            : ValenceBoostScale * std::pow(static_cast<float>(num_active_triangles), -ValenceBoostPower);
+        return cache + valence;
+    }
+
+    struct Float3
+    {
+        float x, y, z;
+
+        Float3 operator-(const Float3& other) const { return { x - other.x, y - other.y, z - other.z }; }
+        Float3 operator+(const Float3& other) const { return { x + other.x, y + other.y, z + other.z }; }
+        Float3 operator*(float scale) const { return { x * scale, y * scale, z * scale }; }
+    };
+
+    Float3 Cross(const Float3& a, const Float3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    float Dot(const Float3& a, const Float3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    Float3 LoadPosition(const void* positions, size_t stride, uint32 index)
+    {
+        Float3 position;
+        std::memcpy(&position, static_cast<const uint8*>(positions) + index * stride, sizeof(position));
+        return position;
+    }
+}
+
+VertexCacheStats AnalyzeVertexCache(std::span<const uint32> indices, uint32 num_vertices, uint32 cache_size)
+{
+    VertexCacheStats stats;
+    stats.num_triangles = static_cast<uint32>(indices.size() / 3);
+    if (stats.num_triangles == 0 || num_vertices == 0)
+    {
+        return stats;
+    }
+
+    // 정점마다 캐시에 들어온 시각을 기록해 FIFO를 O(1)로 흉내낸다
+    std::vector<uint32> insert_time(num_vertices, 0);
+    uint32 time = cache_size + 1;
+    std::vector<uint8> is_used(num_vertices, 0);
+    uint32 num_used = 0;
+
+    for (const uint32 index : indices)
+    {
+        if (index >= num_vertices) continue;
+
+        if (time - insert_time[index] > cache_size)
+        {
+            insert_time[index] = time++;
+            ++stats.vertices_transformed;
+        }
+        if (!is_used[index])
+        {
+            is_used[index] = 1;
+            ++num_used;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.vertices_transformed) / static_cast<float>(stats.num_triangles);
+    stats.atvr = num_used > 0 ? static_cast<float>(stats.vertices_transformed) / static_cast<float>(num_used) : 0.0f;
+    return stats;
+}
+
+uint32 GenerateWeldRemap(const void* vertices, size_t num_vertices, size_t vertex_stride, std::vector<uint32>& out_remap)
+{
+    ZoneScoped;
+
+    const auto* bytes = static_cast<const char*>(vertices);
+
+    std::unordered_map<std::string_view, uint32> unique_vertices;
+    unique_vertices.reserve(num_vertices);
+
+    out_remap.resize(num_vertices);
+    uint32 num_unique = 0;
+    for (size_t i = 0; i < num_vertices; ++i)
+    {
+        const std::string_view key(bytes + i * vertex_stride, vertex_stride);
+        const auto [it, is_inserted] = unique_vertices.try_emplace(key, num_unique);
+        if (is_inserted)
+        {
+            ++num_unique;
+        }
+        out_remap[i] = it->second;
+    }
+    return num_unique;
+}
+
+uint32 GenerateFetchRemap(std::span<const uint32> indices, size_t num_vertices, std::vector<uint32>& out_remap)
+{
+    out_remap.assign(num_vertices, InvalidIndex);
+
+    uint32 next = 0;
+    for (const uint32 index : indices)
+    {
+        if (index < num_vertices && out_remap[index] == InvalidIndex)
+        {
+            out_remap[index] = next++;
+        }
+    }
+    return next;
+}
+
+void RemapIndices(std::span<uint32> indices, std::span<const uint32> remap)
+{
+    for (uint32& index : indices)
+    {
+        index = remap[index];
+    }
+}
+
+void RemapVertices(
+    void* out_vertices, const void* vertices, size_t num_vertices, size_t vertex_stride, std::span<const uint32> remap
+)
+{
+    auto* dst = static_cast<uint8*>(out_vertices);
+    const auto* src = static_cast<const uint8*>(vertices);
+    for (size_t i = 0; i < num_vertices; ++i)
+    {
+        if (remap[i] != InvalidIndex)
+        {
+            std::memcpy(dst + remap[i] * vertex_stride, src + i * vertex_stride, vertex_stride);
+        }
+    }
+}
+
+void OptimizeVertexCache(std::span<uint32> indices, uint32 num_vertices)
+{
+    ZoneScoped;
+
+    const uint32 num_triangles = static_cast<uint32>(indices.size() / 3);
+    if (num_triangles < 2)
+    {
+        return;
+    }
+
+    static const ForsythTables tables;
+
+    // 정점 -> 삼각형 인접 목록 (앞쪽 num_active개가 아직 내보내지 않은 삼각형)
+    std::vector<uint32> num_active(num_vertices, 0);
+    for (uint32 i = 0; i < num_triangles * 3; ++i)
+    {
+        ++num_active[indices[i]];
+    }
+
+    std::vector<uint32> adjacency_offsets(num_vertices + 1, 0);
+    for (uint32 v = 0; v < num_vertices; ++v)
+    {
+        adjacency_offsets[v + 1] = adjacency_offsets[v] + num_active[v];
+    }
+
+    std::vector<uint32> adjacency(num_triangles * 3);
+    {
+        std::vector<uint32> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (uint32 t = 0; t < num_triangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = t;
+            }
+        }
+    }
+
+    std::vector<int32> cache_position(num_vertices, -1);
+    std::vector<float> vertex_score(num_vertices);
+    for (uint32 v = 0; v < num_vertices; ++v)
+    {
+        vertex_score[v] = GetVertexScore(tables, -1, num_active[v]);
+    }
+
+    std::vector<float> triangle_score(num_triangles);
+    std::vector<uint8> is_emitted(num_triangles, 0);
+    uint32 best_triangle = 0;
+    for (uint32 t = 0; t < num_triangles; ++t)
+    {
+        triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+        if (triangle_score[t] > triangle_score[best_triangle])
+        {
+            best_triangle = t;
+        }
+    }
+
+    std::vector<uint32> result;
+    result.reserve(num_triangles * 3);
+
+    std::array<uint32, ForsythCacheSize + 3> cache;
+    std::array<uint32, ForsythCacheSize + 3> new_cache;
+    uint32 cache_count = 0;
+    uint32 scan_cursor = 0; // 캐시에서 후보를 못 찾았을 때 쓸 다음 삼각형
+
+    for (uint32 emitted = 0; emitted < num_triangles; ++emitted)
+    {
+        if (best_triangle == InvalidIndex)
+        {
+            while (is_emitted[scan_cursor]) ++scan_cursor;
+            best_triangle = scan_cursor;
+        }
+
+        const uint32 tri[3] = { indices[best_triangle * 3], indices[best_triangle * 3 + 1], indices[best_triangle * 3 + 2] };
+        result.insert(result.end(), tri, tri + 3);
+        is_emitted[best_triangle] = 1;
+
+        // 내보낸 삼각형을 각 정점의 활성 목록에서 뺀다
+        for (const uint32 v : tri)
+        {
+            uint32* begin = adjacency.data() + adjacency_offsets[v];
+            uint32* end = begin + num_active[v];
+            if (uint32* it = std::find(begin, end, best_triangle); it != end)
+            {
+                std::swap(*it, *(end - 1));
+                --num_active[v];
+            }
+        }
+
+        // 새 캐시 = 방금 쓴 세 정점 + 기존 캐시 (중복 제외)
+        uint32 new_count = 0;
+        for (const uint32 v : tri)
+        {
+            if (std::find(new_cache.begin(), new_cache.begin() + new_count, v) == new_cache.begin() + new_count)
+            {
+                new_cache[new_count++] = v;
+            }
+        }
+        for (uint32 i = 0; i < cache_count; ++i)
+        {
+            const uint32 v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+            {
+                new_cache[new_count++] = v;
+            }
+        }
+
+        // 캐시에서 밀려난 정점 포함, 위치가 바뀐 정점들의 점수를 다시 계산
+        for (uint32 i = 0; i < new_count; ++i)
+        {
+            const uint32 v = new_cache[i];
+            cache_position[v] = i < ForsythCacheSize ? static_cast<int32>(i) : -1;
+            vertex_score[v] = GetVertexScore(tables, cache_position[v], num_active[v]);
+        }
+
+        // 캐시에 있는 정점들의 삼각형 중에서 다음 후보를 고른다
+        best_triangle = InvalidIndex;
+        float best_score = -1.0f;
+        for (uint32 i = 0; i < new_count; ++i)
+        {
+            const uint32 v = new_cache[i];
+            const uint32* begin = adjacency.data() + adjacency_offsets[v];
+            for (uint32 j = 0; j < num_active[v]; ++j)
+            {
+                const uint32 t = begin[j];
+                const float score = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+                triangle_score[t] = score;
+                if (score > best_score)
+                {
+                    best_score = score;
+                    best_triangle = t;
+                }
+            }
+        }
+
+        cache_count = std::min(new_count, ForsythCacheSize);
+        std::copy_n(new_cache.begin(), cache_count, cache.begin());
+    }
+
+    std::ranges::copy(result, indices.begin());
+}
+
+void OptimizeOverdraw(
+    std::span<uint32> indices, const void* positions, size_t num_vertices, size_t position_stride, float threshold
+)
+{
+    ZoneScoped;
+
+    const uint32 num_triangles = static_cast<uint32>(indices.size() / 3);
+    if (num_triangles < 2)
+    {
+        return;
+    }
+
+    /* 1. 클러스터 나누기
+     * 캐시 순서에서 세 정점이 모두 미스인 삼각형은 캐시가 사실상 비워진 지점이라, 여기서 잘라 순서를 바꿔도 손해가 거의 없다.
+     * 이런 지점 중 지금까지 클러스터의 ACMR이 전체 ACMR * threshold 이하인 곳에서만 자른다.
+     */
+    constexpr uint32 cache_size = 16;
+    const float max_cluster_acmr = AnalyzeVertexCache(indices, static_cast<uint32>(num_vertices), cache_size).acmr * threshold;
+
+    std::vector<uint32> cluster_starts = { 0 };
+    {
+        std::vector<uint32> insert_time(num_vertices, 0);
+        uint32 time = cache_size + 1;
+        uint32 cluster_misses = 0;
+
+        for (uint32 t = 0; t < num_triangles; ++t)
+        {
+            uint32 misses = 0;
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 v = indices[t * 3 + k];
+                if (time - insert_time[v] > cache_size)
+                {
+                    insert_time[v] = time++;
+                    ++misses;
+                }
+            }
+
+            const uint32 cluster_triangles = t - cluster_starts.back();
+            if (misses == 3 && cluster_triangles > 0
+                && static_cast<float>(cluster_misses) / static_cast<float>(cluster_triangles) <= max_cluster_acmr)
+            {
+                cluster_starts.push_back(t);
+                cluster_misses = 0;
+            }
+            cluster_misses += misses;
+        }
+    }
+
+    const uint32 num_clusters = static_cast<uint32>(cluster_starts.size());
+    if (num_clusters < 2)
+    {
+        return;
+    }
+    cluster_starts.push_back(num_triangles);
+
+    // 2. 클러스터마다 면적 가중 중심과 법선을 구하고, 메쉬 중심에서 바깥을 향한 정도로 정렬한다
+    struct Cluster
+    {
+        uint32 start;
+        uint32 end;
+        Float3 centroid;
+        Float3 normal;
+        float sort_key;
+    };
+    std::vector<Cluster> clusters(num_clusters);
+
+    Float3 mesh_centroid = { 0, 0, 0 };
+    float mesh_area = 0.0f;
+    for (uint32 c = 0; c < num_clusters; ++c)
+    {
+        Cluster& cluster = clusters[c];
+        cluster = { cluster_starts[c], cluster_starts[c + 1], { 0, 0, 0 }, { 0, 0, 0 }, 0.0f };
+
+        float cluster_area = 0.0f;
+        for (uint32 t = cluster.start; t < cluster.end; ++t)
+        {
+            const Float3 p0 = LoadPosition(positions, position_stride, indices[t * 3]);
+            const Float3 p1 = LoadPosition(positions, position_stride, indices[t * 3 + 1]);
+            const Float3 p2 = LoadPosition(positions, position_stride, indices[t * 3 + 2]);
+
+            const Float3 normal = Cross(p1 - p0, p2 - p0); // 길이 = 면적 * 2
+            const float area = std::sqrt(Dot(normal, normal));
+
+            cluster.centroid = cluster.centroid + (p0 + p1 + p2) * (area / 3.0f);
+            cluster.normal = cluster.normal + normal;
+            cluster_area += area;
+        }
+
+        mesh_centroid = mesh_centroid + cluster.centroid;
+        mesh_area += cluster_area;
+        cluster.centroid = cluster_area > 0.0f ? cluster.centroid * (1.0f / cluster_area) : cluster.centroid;
+    }
+    mesh_centroid = mesh_area > 0.0f ? mesh_centroid * (1.0f / mesh_area) : mesh_centroid;
+
+    for (Cluster& cluster : clusters)
+    {
+        const float length = std::sqrt(Dot(cluster.normal, cluster.normal));
+        const Float3 normal = length > 0.0f ? cluster.normal * (1.0f / length) : cluster.normal;
+        cluster.sort_key = Dot(cluster.centroid - mesh_centroid, normal);
+    }
+
+    // 바깥을 향한 클러스터가 먼저 그려져야 안쪽이 깊이 테스트에서 걸러진다
+    std::ranges::stable_sort(clusters, std::greater{}, &Cluster::sort_key);
+
+    std::vector<uint32> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters)
+    {
+        result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+    }
+    std::ranges::copy(result, indices.begin());
+}
+
+MeshOptimizeStats OptimizeStaticMesh(se::asset::StaticMesh& mesh, const MeshOptimizeSettings& settings)
+{
+    ZoneScoped;
+
+    using se::Vertex;
+    static_assert(sizeof(Vertex::position) == sizeof(float) * 3, "OptimizeOverdraw는 float3 위치를 가정한다");
+
+    MeshOptimizeStats stats;
+    std::vector<Vertex> vertices(mesh.vertices.Data(), mesh.vertices.Data() + mesh.vertices.Len());
+    const std::span<uint32> indices(mesh.indices.Data(), mesh.indices.Len());
+
+    stats.vertices_before = static_cast<uint32>(vertices.size());
+    stats.cache_before = AnalyzeVertexCache(indices, stats.vertices_before);
+
+    if (vertices.empty() || indices.empty()
+        || std::ranges::any_of(indices, [&](uint32 index) { return index >= vertices.size(); }))
+    {
+        stats.vertices_after = stats.vertices_before;
+        stats.cache_after = stats.cache_before;
+        return stats;
+    }
+
+    std::vector<uint32> remap;
+    if (settings.weld)
+    {
+        const uint32 num_unique = GenerateWeldRemap(vertices.data(), vertices.size(), sizeof(Vertex), remap);
+        if (num_unique < vertices.size())
+        {
+            std::vector<Vertex> welded(num_unique);
+            RemapVertices(welded.data(), vertices.data(), vertices.size(), sizeof(Vertex), remap);
+            RemapIndices(indices, remap);
+            vertices = std::move(welded);
+        }
+    }
+
+    // 삼각형 순서는 섹션 안에서만 바꾼다
+    for (const auto& section : mesh.sections)
+    {
+        if (section.index_start + section.index_count > indices.size()) continue;
+
+        const std::span<uint32> section_indices = indices.subspan(section.index_start, section.index_count);
+        if (settings.vertex_cache)
+        {
+            OptimizeVertexCache(section_indices, static_cast<uint32>(vertices.size()));
+        }
+        if (settings.overdraw)
+        {
+            OptimizeOverdraw(
+                section_indices, &vertices[0].position, vertices.size(), sizeof(Vertex), settings.overdraw_threshold
+            );
+        }
+    }
+
+    if (settings.vertex_fetch)
+    {
+        const uint32 num_used = GenerateFetchRemap(indices, vertices.size(), remap);
+        std::vector<Vertex> fetched(num_used);
+        RemapVertices(fetched.data(), vertices.data(), vertices.size(), sizeof(Vertex), remap);
+        RemapIndices(indices, remap);
+        vertices = std::move(fetched);
+    }
+
+    se::Array<Vertex> optimized_vertices;
+    optimized_vertices.Reserve(vertices.size());
+    for (const Vertex& vertex : vertices)
+    {
+        optimized_vertices.Push(vertex);
+    }
+    mesh.vertices = std::move(optimized_vertices);
+
+    stats.vertices_after = static_cast<uint32>(vertices.size());
+    stats.cache_after = AnalyzeVertexCache(indices, stats.vertices_after);
+    return stats;
+}
@@ -0,0 +1,78 @@
+﻿#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+namespace se::asset
+{
+struct StaticMesh;
+}
+
+/// 정점 캐시 시뮬레이션 결과
+struct VertexCacheStats
+{
+    uint32 vertices_transformed = 0; // 캐시 미스 수
+    uint32 num_triangles = 0;
+    float acmr = 0.0f; // 삼각형당 변환 정점 수 (0.5 ~ 3, 낮을수록 좋음)
+    float atvr = 0.0f; // 정점당 변환 횟수 (1이 최적)
+};
+
+struct MeshOptimizeSettings
+{
+    bool weld = true;
+    bool vertex_cache = true;
+    bool overdraw = true;
+    bool vertex_fetch = true;
+    float overdraw_threshold = 1.05f; // 캐시 효율을 이 비율까지 포기하고 오버드로우를 줄인다
+};
+
+struct MeshOptimizeStats
+{
+    uint32 vertices_before = 0;
+    uint32 vertices_after = 0;
+    VertexCacheStats cache_before;
+    VertexCacheStats cache_after;
+};
+
+/* 메쉬 최적화 단계
+ * 1. Weld: 바이트가 완전히 같은 정점을 합친다.
+ * 2. Vertex Cache: 섹션마다 삼각형 순서를 정점 캐시 재사용이 높게 바꾼다 (Forsyth).
+ * 3. Overdraw: 캐시 순서를 크게 깨지 않는 클러스터 단위로, 바깥을 향한 면이 먼저 그려지도록 정렬한다.
+ * 4. Vertex Fetch: 정점을 인덱스에서 처음 쓰이는 순서로 재배치한다.
+ * 섹션 경계는 유지하므로 섹션별 index_start / index_count는 그대로 쓸 수 있다.
+ */
+
+/// FIFO 캐시로 인덱스 버퍼의 정점 변환 횟수를 시뮬레이션한다.
+VertexCacheStats AnalyzeVertexCache(std::span<const uint32> indices, uint32 num_vertices, uint32 cache_size = 16);
+
+/// 바이트가 같은 정점을 같은 번호로 묶는 remap을 만든다. 고유 정점 수를 반환한다.
+uint32 GenerateWeldRemap(
+    const void* vertices, size_t num_vertices, size_t vertex_stride, std::vector<uint32>& out_remap
+);
+
+/// 인덱스가 처음 쓰이는 순서로 정점 번호를 다시 매기는 remap을 만든다. 쓰인 정점 수를 반환한다.
+/// 쓰이지 않는 정점의 remap은 ~0u
+uint32 GenerateFetchRemap(std::span<const uint32> indices, size_t num_vertices, std::vector<uint32>& out_remap);
+
+/// remap으로 인덱스를 바꾼다.
+void RemapIndices(std::span<uint32> indices, std::span<const uint32> remap);
+
+/// remap으로 정점을 새 위치로 옮긴다. out_vertices는 num_unique * vertex_stride 크기여야 한다.
+void RemapVertices(
+    void* out_vertices, const void* vertices, size_t num_vertices, size_t vertex_stride, std::span<const uint32> remap
+);
+
+/// 정점 캐시 재사용이 높도록 삼각형 순서를 바꾼다.
+void OptimizeVertexCache(std::span<uint32> indices, uint32 num_vertices);
+
+/// 캐시 최적화된 인덱스를 클러스터로 나누고, 바깥을 향한 클러스터가 먼저 오도록 정렬한다.
+/// positions는 정점마다 position_stride 바이트 간격의 float3
+void OptimizeOverdraw(
+    std::span<uint32> indices, const void* positions, size_t num_vertices, size_t position_stride, float threshold
+);
+
+/// 위 단계를 StaticMesh에 적용한다. 워커 스레드에서 호출할 수 있다.
+MeshOptimizeStats OptimizeStaticMesh(se::asset::StaticMesh& mesh, const MeshOptimizeSettings& settings = {});
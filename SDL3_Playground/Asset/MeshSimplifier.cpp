@@ -0,0 +1,434 @@
+﻿#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+#include "MeshOptimizer.h"
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    constexpr uint32 InvalidIndex = ~0u;
+
+    using Double3 = std::array<double, 3>;
+
+    Double3 Sub(const Double3& a, const Double3& b) { return { a[0] - b[0], a[1] - b[1], a[2] - b[2] }; }
+    double Dot(const Double3& a, const Double3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+    Double3 Cross(const Double3& a, const Double3& b)
+    {
+        return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    }
+
+    /// 평면까지 거리 제곱의 면적 가중 합 (대칭 4x4 행렬을 10개 값으로)
+    struct Quadric
+    {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double weight = 0;
+
+        static Quadric FromPlane(const Double3& normal, double distance, double weight)
+        {
+            const double x = normal[0], y = normal[1], z = normal[2];
+            return {
+                weight * x * x, weight * y * y, weight * z * z,
+                weight * x * y, weight * x * z, weight * y * z,
+                weight * x * distance, weight * y * distance, weight * z * distance,
+                weight * distance * distance,
+                weight,
+            };
+        }
+
+        void Add(const Quadric& other)
+        {
+            a00 += other.a00; a11 += other.a11; a22 += other.a22;
+            a01 += other.a01; a02 += other.a02; a12 += other.a12;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+        }
+
+        /// p에서의 평균 거리 제곱
+        [[nodiscard]] double Evaluate(const Double3& p) const
+        {
+            const double x = p[0], y = p[1], z = p[2];
+            const double rx = a00 * x + a01 * y + a02 * z;
+            const double ry = a01 * x + a11 * y + a12 * z;
+            const double rz = a02 * x + a12 * y + a22 * z;
+            const double r = rx * x + ry * y + rz * z + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return weight > 0.0 ? std::abs(r) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        double cost;
+        uint32 from;
+        uint32 to;
+    };
+}
+
+size_t SimplifyMesh(
+    std::span<const uint32> indices,
+    const void* positions, size_t num_vertices, size_t position_stride,
+    size_t target_index_count, float max_error, float error_extent,
+    std::vector<uint32>& out_indices, float* out_error
+)
+{
+    ZoneScoped;
+
+    out_indices.assign(indices.begin(), indices.end());
+    if (out_error)
+    {
+        *out_error = 0.0f;
+    }
+    if (indices.size() <= target_index_count || num_vertices == 0)
+    {
+        return out_indices.size();
+    }
+
+    // 1. 위치가 같은 정점을 한 그룹으로 묶는다 (seam이 벌어지지 않게)
+    const auto* bytes = static_cast<const char*>(positions);
+    std::vector<uint32> group_of(num_vertices, InvalidIndex);
+    std::vector<uint32> group_vertex;  // 그룹 -> 대표 정점
+    std::vector<Double3> group_position;
+    {
+        std::unordered_map<std::string_view, uint32> lookup;
+        for (const uint32 vertex : indices)
+        {
+            if (group_of[vertex] != InvalidIndex) continue;
+
+            const std::string_view key(bytes + vertex * position_stride, sizeof(float) * 3);
+            const auto [it, is_inserted] = lookup.try_emplace(key, static_cast<uint32>(group_vertex.size()));
+            if (is_inserted)
+            {
+                float p[3];
+                std::memcpy(p, key.data(), sizeof(p));
+                group_vertex.push_back(vertex);
+                group_position.push_back({ p[0], p[1], p[2] });
+            }
+            group_of[vertex] = it->second;
+        }
+    }
+    const uint32 num_groups = static_cast<uint32>(group_vertex.size());
+
+    // 오차는 메쉬 크기에 대한 비율로 다룬다
+    double extent = error_extent;
+    if (extent <= 0.0)
+    {
+        Double3 min = group_position[0], max = group_position[0];
+        for (const Double3& p : group_position)
+        {
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                min[axis] = std::min(min[axis], p[axis]);
+                max[axis] = std::max(max[axis], p[axis]);
+            }
+        }
+        extent = std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+    }
+    if (extent <= 0.0)
+    {
+        return out_indices.size();
+    }
+    const double max_error_sq = (max_error * extent) * (max_error * extent);
+
+    // 2. 그룹마다 주변 삼각형 평면의 Quadric
+    std::vector<Quadric> quadrics(num_groups);
+    for (size_t i = 0; i + 2 < out_indices.size(); i += 3)
+    {
+        const uint32 g0 = group_of[out_indices[i]], g1 = group_of[out_indices[i + 1]], g2 = group_of[out_indices[i + 2]];
+        const Double3& p0 = group_position[g0];
+        Double3 normal = Cross(Sub(group_position[g1], p0), Sub(group_position[g2], p0));
+        const double length = std::sqrt(Dot(normal, normal));
+        if (length <= 0.0) continue;
+
+        normal = { normal[0] / length, normal[1] / length, normal[2] / length };
+        const Quadric quadric = Quadric::FromPlane(normal, -Dot(normal, p0), length * 0.5);
+        quadrics[g0].Add(quadric);
+        quadrics[g1].Add(quadric);
+        quadrics[g2].Add(quadric);
+    }
+
+    std::vector<uint64> edges;
+    std::vector<Collapse> collapses;
+    std::vector<uint8> is_border(num_groups);
+    std::vector<uint8> is_touched(num_groups);
+    std::vector<uint32> collapse_to(num_groups);
+    std::vector<uint32> adjacency_offsets(num_groups + 1);
+    std::vector<uint32> adjacency;
+    double result_error_sq = 0.0;
+
+    // 3. 패스마다 비용이 낮은 엣지부터, 서로 겹치지 않는 것들을 한꺼번에 붕괴한다
+    while (out_indices.size() > target_index_count)
+    {
+        const size_t num_triangles = out_indices.size() / 3;
+
+        edges.clear();
+        edges.reserve(num_triangles * 3);
+        for (size_t t = 0; t < num_triangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 a = group_of[out_indices[t * 3 + k]];
+                const uint32 b = group_of[out_indices[t * 3 + (k + 1) % 3]];
+                edges.push_back((static_cast<uint64>(std::min(a, b)) << 32) | std::max(a, b));
+            }
+        }
+        std::ranges::sort(edges);
+
+        // 삼각형 하나만 쓰는 엣지의 정점은 열린 경계이므로 고정한다
+        std::ranges::fill(is_border, 0);
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j] == edges[i]) ++j;
+            if (j - i == 1)
+            {
+                is_border[edges[i] >> 32] = 1;
+                is_border[edges[i] & 0xFFFFFFFF] = 1;
+            }
+            i = j;
+        }
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        collapses.clear();
+        for (const uint64 edge : edges)
+        {
+            const uint32 a = static_cast<uint32>(edge >> 32);
+            const uint32 b = static_cast<uint32>(edge & 0xFFFFFFFF);
+
+            Quadric quadric = quadrics[a];
+            quadric.Add(quadrics[b]);
+
+            // 기존 정점으로만 붕괴하므로 두 방향 중 싼 쪽을 고른다
+            Collapse best = { std::numeric_limits<double>::max(), InvalidIndex, InvalidIndex };
+            if (!is_border[a])
+            {
+                best = { quadric.Evaluate(group_position[b]), a, b };
+            }
+            if (!is_border[b])
+            {
+                const double cost = quadric.Evaluate(group_position[a]);
+                if (cost < best.cost)
+                {
+                    best = { cost, b, a };
+                }
+            }
+            if (best.from != InvalidIndex && best.cost <= max_error_sq)
+            {
+                collapses.push_back(best);
+            }
+        }
+        if (collapses.empty())
+        {
+            break;
+        }
+        std::ranges::sort(collapses, {}, &Collapse::cost);
+
+        // 뒤집힘 검사용 그룹 -> 삼각형 인접 목록
+        std::ranges::fill(adjacency_offsets, 0);
+        for (const uint32 vertex : out_indices)
+        {
+            ++adjacency_offsets[group_of[vertex] + 1];
+        }
+        std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+        adjacency.resize(out_indices.size());
+        {
+            std::vector<uint32> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+            for (size_t i = 0; i < out_indices.size(); ++i)
+            {
+                adjacency[fill[group_of[out_indices[i]]]++] = static_cast<uint32>(i / 3);
+            }
+        }
+
+        const size_t triangles_to_remove = (out_indices.size() - target_index_count + 2) / 3;
+        size_t num_removed = 0;
+        bool is_collapsed = false;
+        std::ranges::fill(is_touched, 0);
+        std::iota(collapse_to.begin(), collapse_to.end(), 0u);
+
+        for (const Collapse& collapse : collapses)
+        {
+            if (num_removed >= triangles_to_remove) break;
+            if (is_touched[collapse.from] || is_touched[collapse.to]) continue;
+
+            // from을 to 위치로 옮겼을 때 면이 뒤집히는 삼각형이 있으면 건너뛴다
+            uint32 num_shared = 0;
+            bool is_flipped = false;
+            for (uint32 i = adjacency_offsets[collapse.from]; i < adjacency_offsets[collapse.from + 1]; ++i)
+            {
+                const uint32 t = adjacency[i];
+                uint32 g[3] = { group_of[out_indices[t * 3]], group_of[out_indices[t * 3 + 1]], group_of[out_indices[t * 3 + 2]] };
+                if (g[0] == collapse.to || g[1] == collapse.to || g[2] == collapse.to)
+                {
+                    ++num_shared; // 붕괴로 사라지는 삼각형
+                    continue;
+                }
+
+                const Double3 before = Cross(
+                    Sub(group_position[g[1]], group_position[g[0]]), Sub(group_position[g[2]], group_position[g[0]])
+                );
+                for (uint32& group : g)
+                {
+                    if (group == collapse.from) group = collapse.to;
+                }
+                const Double3 after = Cross(
+                    Sub(group_position[g[1]], group_position[g[0]]), Sub(group_position[g[2]], group_position[g[0]])
+                );
+                if (Dot(before, after) <= 0.0)
+                {
+                    is_flipped = true;
+                    break;
+                }
+            }
+            if (is_flipped) continue;
+
+            collapse_to[collapse.from] = collapse.to;
+            is_touched[collapse.from] = is_touched[collapse.to] = 1;
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            num_removed += num_shared;
+            result_error_sq = std::max(result_error_sq, collapse.cost);
+            is_collapsed = true;
+        }
+        if (!is_collapsed)
+        {
+            break;
+        }
+
+        // 붕괴를 인덱스에 반영하고 퇴화한 삼각형을 지운다
+        size_t write = 0;
+        for (size_t t = 0; t < num_triangles; ++t)
+        {
+            uint32 v[3];
+            uint32 g[3];
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                v[k] = out_indices[t * 3 + k];
+                g[k] = group_of[v[k]];
+                if (collapse_to[g[k]] != g[k])
+                {
+                    g[k] = collapse_to[g[k]];
+                    v[k] = group_vertex[g[k]];
+                }
+            }
+            if (g[0] == g[1] || g[1] == g[2] || g[0] == g[2]) continue;
+
+            out_indices[write++] = v[0];
+            out_indices[write++] = v[1];
+            out_indices[write++] = v[2];
+        }
+        out_indices.resize(write);
+    }
+
+    if (out_error)
+    {
+        *out_error = static_cast<float>(std::sqrt(result_error_sq) / extent);
+    }
+    return out_indices.size();
+}
+
+std::vector<MeshLod> GenerateMeshLods(const se::asset::StaticMesh& mesh, const MeshLodSettings& settings)
+{
+    ZoneScoped;
+
+    std::vector<MeshLod> lods;
+    const uint32 num_vertices = mesh.vertices.Len();
+    const uint32 num_indices = mesh.indices.Len();
+    if (num_vertices == 0 || mesh.sections.IsEmpty())
+    {
+        return lods;
+    }
+
+    // 이전 LOD의 섹션별 인덱스에서 이어서 줄인다 (LOD0은 원본 섹션)
+    std::vector<std::span<const uint32>> previous_sections;
+    uint32 previous_triangles = 0;
+    for (const auto& section : mesh.sections)
+    {
+        const bool is_valid = section.index_start + section.index_count <= num_indices;
+        previous_sections.emplace_back(
+            mesh.indices.Data() + (is_valid ? section.index_start : 0), is_valid ? section.index_count : 0
+        );
+        previous_triangles += static_cast<uint32>(previous_sections.back().size() / 3);
+    }
+
+    // previous_sections가 lods 안의 인덱스를 가리키므로 재할당되지 않게 한다
+    lods.reserve(settings.max_lods);
+
+    // 섹션마다 따로 줄여도 같은 절대 오차가 되도록 메쉬 전체 AABB를 기준으로 한다
+    const se::Vertex* vertices = mesh.vertices.Data();
+    float min[3] = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+    float max[3] = { min[0], min[1], min[2] };
+    for (uint32 i = 1; i < num_vertices; ++i)
+    {
+        const float p[3] = { vertices[i].position.x, vertices[i].position.y, vertices[i].position.z };
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            min[axis] = std::min(min[axis], p[axis]);
+            max[axis] = std::max(max[axis], p[axis]);
+        }
+    }
+    const float mesh_extent = std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+    if (mesh_extent <= 0.0f)
+    {
+        return lods;
+    }
+
+    const void* positions = &vertices[0].position;
+    std::vector<uint32> simplified;
+    float accumulated_error = 0.0f;
+    for (uint32 level = 0; level < settings.max_lods; ++level)
+    {
+        if (static_cast<float>(previous_triangles) * settings.reduction < static_cast<float>(settings.min_triangles))
+        {
+            break;
+        }
+
+        MeshLod lod;
+        float lod_error = 0.0f;
+        for (const std::span<const uint32> section_indices : previous_sections)
+        {
+            const size_t target = static_cast<size_t>(static_cast<float>(section_indices.size() / 3) * settings.reduction) * 3;
+
+            float section_error = 0.0f;
+            SimplifyMesh(
+                section_indices, positions, num_vertices, sizeof(se::Vertex),
+                target, settings.max_error, mesh_extent, simplified, &section_error
+            );
+            OptimizeVertexCache(simplified, num_vertices);
+
+            lod.section_index_counts.push_back(static_cast<uint32>(simplified.size()));
+            lod.indices.insert(lod.indices.end(), simplified.begin(), simplified.end());
+            lod_error = std::max(lod_error, section_error);
+        }
+
+        // 오차 제한이나 경계 때문에 거의 줄지 않았으면 더 만들 의미가 없다
+        lod.num_triangles = static_cast<uint32>(lod.indices.size() / 3);
+        if (lod.num_triangles == 0 || static_cast<float>(lod.num_triangles) > static_cast<float>(previous_triangles) * 0.9f)
+        {
+            break;
+        }
+
+        accumulated_error += lod_error;
+        lod.error = accumulated_error;
+        previous_triangles = lod.num_triangles;
+
+        const MeshLod& added = lods.emplace_back(std::move(lod));
+        uint32 offset = 0;
+        for (size_t s = 0; s < previous_sections.size(); ++s)
+        {
+            previous_sections[s] = std::span<const uint32>(added.indices.data() + offset, added.section_index_counts[s]);
+            offset += added.section_index_counts[s];
+        }
+    }
+    return lods;
+}
@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+namespace se::asset
+{
+struct StaticMesh;
+}
+
+/// 원본 정점 버퍼를 공유하는 단순화된 LOD 하나
+struct MeshLod
+{
+    std::vector<uint32> indices;              // 섹션 순서로 이어 붙인 인덱스
+    std::vector<uint32> section_index_counts; // StaticMesh::sections와 같은 순서, 섹션별 인덱스 수
+    uint32 num_triangles = 0;
+    float error = 0.0f; // 메쉬 AABB 최대 변 길이 대비 누적 오차
+};
+
+struct MeshLodSettings
+{
+    uint32 max_lods = 4;         // LOD0(원본)은 제외
+    float reduction = 0.5f;      // LOD마다 이전 LOD 대비 목표 삼각형 비율
+    float max_error = 0.05f;     // 이 오차를 넘는 붕괴는 하지 않는다
+    uint32 min_triangles = 64;   // 이보다 작아지면 더 만들지 않는다
+};
+
+/* QEM(Quadric Error Metric) 엣지 붕괴로 삼각형 수를 줄인다.
+ * 정점은 새로 만들지 않고 기존 정점으로만 붕괴하므로 결과 인덱스는 원래 정점 버퍼를 그대로 참조한다.
+ * 위치가 같은 정점(UV / 노멀 seam)은 한 정점으로 취급하고, 열린 경계의 정점은 움직이지 않는다.
+ *
+ * target_index_count: 목표 인덱스 수 (3의 배수)
+ * max_error: error_extent 대비 허용 오차
+ * error_extent: 오차의 기준 길이. 보통 메쉬 전체 AABB의 최대 변 길이이고, 0 이하면 indices가 쓰는 정점의 AABB로 구한다.
+ *               한 메쉬의 섹션을 따로 줄일 때 같은 값을 넘겨야 섹션마다 같은 절대 허용 오차가 된다.
+ * 반환값: out_indices의 인덱스 수, out_error에 실제 최대 오차 (error_extent 대비 상대값)
+ */
+size_t SimplifyMesh(
+    std::span<const uint32> indices,
+    const void* positions, size_t num_vertices, size_t position_stride,
+    size_t target_index_count, float max_error, float error_extent,
+    std::vector<uint32>& out_indices, float* out_error = nullptr
+);
+
+/// 섹션별로 단순화해 LOD1부터의 체인을 만든다. 오차는 모든 섹션이 메쉬 전체 AABB 기준이다. 줄어들지 않으면 거기서 멈춘다.
+std::vector<MeshLod> GenerateMeshLods(const se::asset::StaticMesh& mesh, const MeshLodSettings& settings = {});
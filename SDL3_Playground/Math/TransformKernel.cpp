@@ -0,0 +1,153 @@
+﻿#include "TransformKernel.h"
+
+#include <cassert>
+
+#include "TransformKernelImpl.h"
+#include "SDL3/SDL_cpuinfo.h"
+
+using namespace se;
+
+static_assert(sizeof(Matrix4x4f) == sizeof(float) * 16, "Matrix4x4f must be 16 tightly packed floats");
+
+namespace
+{
+    struct ScalarOps
+    {
+        using V = float;
+
+        static V Load(const float* p) { return *p; }
+        static V Set1(float v) { return v; }
+        static V Add(V a, V b) { return a + b; }
+        static V Sub(V a, V b) { return a - b; }
+        static V Mul(V a, V b) { return a * b; }
+        static V MulAdd(V a, V b, V c) { return a * b + c; }
+
+        static void StoreTransposed(const V (&elements)[16], float* out)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                out[i] = elements[i];
+            }
+        }
+    };
+}
+
+void transform_kernel::BuildScalar(const StreamView& streams, size_t begin, size_t end, const float* view_proj, float* out)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        BuildLanes<ScalarOps>(streams, i, view_proj, out);
+    }
+}
+
+TransformKernelBackend TransformBatch::ResolveBackend(TransformKernelBackend backend)
+{
+    if (backend == TransformKernelBackend::Auto)
+    {
+        if (transform_kernel::IsAvx2Compiled() && SDL_HasAVX2())
+        {
+            return TransformKernelBackend::AVX2;
+        }
+        if (transform_kernel::IsSse41Compiled() && SDL_HasSSE41())
+        {
+            return TransformKernelBackend::SSE41;
+        }
+        return TransformKernelBackend::Scalar;
+    }
+
+    // 지원하지 않는 경로를 요청하면 스칼라로 대체
+    if (backend == TransformKernelBackend::AVX2 && !(transform_kernel::IsAvx2Compiled() && SDL_HasAVX2()))
+    {
+        return TransformKernelBackend::Scalar;
+    }
+    if (backend == TransformKernelBackend::SSE41 && !(transform_kernel::IsSse41Compiled() && SDL_HasSSE41()))
+    {
+        return TransformKernelBackend::Scalar;
+    }
+    return backend;
+}
+
+const char* TransformBatch::GetBackendName(TransformKernelBackend backend)
+{
+    switch (backend)
+    {
+    case TransformKernelBackend::Auto:   return "Auto";
+    case TransformKernelBackend::Scalar: return "Scalar";
+    case TransformKernelBackend::SSE41:  return "SSE4.1";
+    case TransformKernelBackend::AVX2:   return "AVX2";
+    }
+    return "Unknown";
+}
+
+void TransformBatch::Clear()
+{
+    for (std::vector<float>& stream : streams)
+    {
+        stream.clear();
+    }
+    count = 0;
+}
+
+void TransformBatch::Reserve(size_t capacity)
+{
+    for (std::vector<float>& stream : streams)
+    {
+        stream.reserve(capacity);
+    }
+}
+
+void TransformBatch::Push(
+    double px, double py, double pz,
+    double qx, double qy, double qz, double qw,
+    double sx, double sy, double sz
+)
+{
+    const double values[StreamCount] = { px, py, pz, qx, qy, qz, qw, sx, sy, sz };
+    for (size_t i = 0; i < StreamCount; ++i)
+    {
+        streams[i].push_back(static_cast<float>(values[i]));
+    }
+    ++count;
+}
+
+void TransformBatch::BuildModelMatrices(std::span<Matrix4x4f> out, TransformKernelBackend backend) const
+{
+    assert(out.size() >= count);
+    Build(nullptr, out.data()->GetData(), backend);
+}
+
+void TransformBatch::BuildMvpMatrices(const Matrix4x4f& view_proj, std::span<Matrix4x4f> out, TransformKernelBackend backend) const
+{
+    assert(out.size() >= count);
+    Build(view_proj.GetData(), out.data()->GetData(), backend);
+}
+
+void TransformBatch::Build(const float* view_proj, float* out, TransformKernelBackend backend) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const transform_kernel::StreamView view = {
+        streams[0].data(), streams[1].data(), streams[2].data(),
+        streams[3].data(), streams[4].data(), streams[5].data(), streams[6].data(),
+        streams[7].data(), streams[8].data(), streams[9].data(),
+    };
+
+    size_t processed = 0;
+    switch (ResolveBackend(backend))
+    {
+    case TransformKernelBackend::AVX2:
+        processed = transform_kernel::BuildAvx2(view, count, view_proj, out);
+        break;
+    case TransformKernelBackend::SSE41:
+        processed = transform_kernel::BuildSse41(view, count, view_proj, out);
+        break;
+    default:
+        break;
+    }
+
+    // 레인 폭에 맞지 않는 나머지
+    transform_kernel::BuildScalar(view, processed, count, view_proj, out);
+}
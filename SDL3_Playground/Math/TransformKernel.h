@@ -0,0 +1,73 @@
+﻿#pragma once
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+
+
+enum class TransformKernelBackend : uint8
+{
+    Auto,   // 실행 중인 CPU가 지원하는 가장 빠른 경로
+    Scalar,
+    SSE41,
+    AVX2,
+};
+
+/**
+ * 여러 TransformComponent의 위치/회전/스케일을 SoA(float)로 모아두고,
+ * 한 번의 호출로 N개의 모델 행렬 또는 MVP 행렬을 만든다.
+ *
+ * 결과는 math::TransformUtility::MakeModelMatrix(position, rotation, scale)와 같은
+ * S * R * T (행 벡터 규약) 행렬이며, MVP는 model * view_proj 이다.
+ */
+class TransformBatch
+{
+public:
+    /// 런타임에 선택되는 백엔드 (Auto를 실제 경로로 해석)
+    [[nodiscard]] static TransformKernelBackend ResolveBackend(TransformKernelBackend backend);
+    [[nodiscard]] static const char* GetBackendName(TransformKernelBackend backend);
+
+public:
+    void Clear();
+    void Reserve(size_t capacity);
+
+    template <typename TransformType>
+    void Push(const TransformType& transform)
+    {
+        Push(
+            transform.position.x, transform.position.y, transform.position.z,
+            transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+            transform.scale.x, transform.scale.y, transform.scale.z
+        );
+    }
+
+    void Push(
+        double px, double py, double pz,
+        double qx, double qy, double qz, double qw,
+        double sx, double sy, double sz
+    );
+
+    [[nodiscard]] size_t Num() const { return count; }
+    [[nodiscard]] bool IsEmpty() const { return count == 0; }
+
+    /// out[i] = Model(i)
+    void BuildModelMatrices(std::span<se::Matrix4x4f> out, TransformKernelBackend backend = TransformKernelBackend::Auto) const;
+
+    /// out[i] = Model(i) * view_proj
+    void BuildMvpMatrices(
+        const se::Matrix4x4f& view_proj,
+        std::span<se::Matrix4x4f> out,
+        TransformKernelBackend backend = TransformKernelBackend::Auto
+    ) const;
+
+private:
+    void Build(const float* view_proj, float* out, TransformKernelBackend backend) const;
+
+private:
+    // SoA 스트림 (px, py, pz, qx, qy, qz, qw, sx, sy, sz)
+    static constexpr size_t StreamCount = 10;
+
+    std::vector<float> streams[StreamCount];
+    size_t count = 0;
+};
@@ -0,0 +1,111 @@
+﻿#pragma once
+#include <cstddef>
+
+// TransformKernel 내부 구현 전용 헤더
+// 각 ISA별 번역 단위(TransformKernel_*.cpp)가 서로 다른 컴파일 옵션으로 이 헤더를 포함하므로,
+// 템플릿과 헬퍼는 모두 익명 네임스페이스에 두어 ODR 충돌을 피한다.
+
+namespace transform_kernel
+{
+    struct StreamView
+    {
+        const float* px;
+        const float* py;
+        const float* pz;
+        const float* qx;
+        const float* qy;
+        const float* qz;
+        const float* qw;
+        const float* sx;
+        const float* sy;
+        const float* sz;
+    };
+
+    /// [begin, end) 범위를 스칼라로 처리한다. view_proj가 nullptr이면 모델 행렬만 만든다.
+    void BuildScalar(const StreamView& streams, size_t begin, size_t end, const float* view_proj, float* out);
+
+    /// 레인 폭의 배수만큼 처리하고, 처리한 개수를 반환한다. (나머지는 호출자가 스칼라로 처리)
+    size_t BuildSse41(const StreamView& streams, size_t count, const float* view_proj, float* out);
+    size_t BuildAvx2(const StreamView& streams, size_t count, const float* view_proj, float* out);
+
+    /// 해당 경로가 이 빌드에 컴파일되어 있는지 여부
+    bool IsSse41Compiled();
+    bool IsAvx2Compiled();
+}
+
+namespace
+{
+    /**
+     * 레인 단위 행렬 생성
+     *
+     * Ops는 V(레인 벡터 타입), Width, Load, Set1, Add, Sub, Mul, MulAdd, StoreTransposed를 제공한다.
+     * elements[16]은 "같은 원소 인덱스의 Width개 엔티티"이며, StoreTransposed가 엔티티별 행렬로 되돌린다.
+     */
+    template <typename Ops>
+    inline void BuildLanes(const transform_kernel::StreamView& s, size_t i, const float* view_proj, float* out)
+    {
+        using V = typename Ops::V;
+
+        const V qx = Ops::Load(s.qx + i), qy = Ops::Load(s.qy + i), qz = Ops::Load(s.qz + i), qw = Ops::Load(s.qw + i);
+        const V sx = Ops::Load(s.sx + i), sy = Ops::Load(s.sy + i), sz = Ops::Load(s.sz + i);
+
+        const V one = Ops::Set1(1.0f);
+        const V two = Ops::Set1(2.0f);
+
+        const V xx = Ops::Mul(qx, qx), yy = Ops::Mul(qy, qy), zz = Ops::Mul(qz, qz);
+        const V xy = Ops::Mul(qx, qy), xz = Ops::Mul(qx, qz), yz = Ops::Mul(qy, qz);
+        const V wx = Ops::Mul(qw, qx), wy = Ops::Mul(qw, qy), wz = Ops::Mul(qw, qz);
+
+        // 회전 행렬(행 벡터 규약)의 각 행에 스케일을 곱한 3x3
+        V m[3][3];
+        m[0][0] = Ops::Mul(Ops::Sub(one, Ops::Mul(two, Ops::Add(yy, zz))), sx);
+        m[0][1] = Ops::Mul(Ops::Mul(two, Ops::Add(xy, wz)), sx);
+        m[0][2] = Ops::Mul(Ops::Mul(two, Ops::Sub(xz, wy)), sx);
+
+        m[1][0] = Ops::Mul(Ops::Mul(two, Ops::Sub(xy, wz)), sy);
+        m[1][1] = Ops::Mul(Ops::Sub(one, Ops::Mul(two, Ops::Add(xx, zz))), sy);
+        m[1][2] = Ops::Mul(Ops::Mul(two, Ops::Add(yz, wx)), sy);
+
+        m[2][0] = Ops::Mul(Ops::Mul(two, Ops::Add(xz, wy)), sz);
+        m[2][1] = Ops::Mul(Ops::Mul(two, Ops::Sub(yz, wx)), sz);
+        m[2][2] = Ops::Mul(Ops::Sub(one, Ops::Mul(two, Ops::Add(xx, yy))), sz);
+
+        const V t[3] = { Ops::Load(s.px + i), Ops::Load(s.py + i), Ops::Load(s.pz + i) };
+
+        V elements[16];
+        if (!view_proj)
+        {
+            const V zero = Ops::Set1(0.0f);
+            for (int r = 0; r < 3; ++r)
+            {
+                elements[r * 4 + 0] = m[r][0];
+                elements[r * 4 + 1] = m[r][1];
+                elements[r * 4 + 2] = m[r][2];
+                elements[r * 4 + 3] = zero;
+            }
+            elements[12] = t[0];
+            elements[13] = t[1];
+            elements[14] = t[2];
+            elements[15] = one;
+        }
+        else
+        {
+            // (S * R * T) * VP: 모델 행렬의 0~2행은 w=0, 3행은 (t, 1)
+            for (int c = 0; c < 4; ++c)
+            {
+                const V vp0 = Ops::Set1(view_proj[0 * 4 + c]);
+                const V vp1 = Ops::Set1(view_proj[1 * 4 + c]);
+                const V vp2 = Ops::Set1(view_proj[2 * 4 + c]);
+                const V vp3 = Ops::Set1(view_proj[3 * 4 + c]);
+
+                for (int r = 0; r < 3; ++r)
+                {
+                    elements[r * 4 + c] = Ops::MulAdd(m[r][2], vp2, Ops::MulAdd(m[r][1], vp1, Ops::Mul(m[r][0], vp0)));
+                }
+                elements[12 + c] = Ops::MulAdd(t[2], vp2, Ops::MulAdd(t[1], vp1, Ops::MulAdd(t[0], vp0, vp3)));
+            }
+        }
+
+        Ops::StoreTransposed(elements, out + i * 16);
+    }
+}
@@ -0,0 +1,89 @@
+﻿// 이 파일은 AVX2/FMA 옵션으로 컴파일된다. (CMakeLists.txt 참고)
+#include "TransformKernelImpl.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace
+{
+    /// 8x8 전치: 입력 r[k]의 레인 e는 엔티티 e의 k번째 원소
+    inline void Transpose8x8(const __m256 (&r)[8], __m256 (&o)[8])
+    {
+        const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+        const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+        const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+        const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+        const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+        const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+        const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+        o[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        o[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        o[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        o[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        o[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        o[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        o[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        o[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+
+    struct Avx2Ops
+    {
+        using V = __m256;
+
+        static V Load(const float* p) { return _mm256_loadu_ps(p); }
+        static V Set1(float v) { return _mm256_set1_ps(v); }
+        static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+
+        static void StoreTransposed(const V (&elements)[16], float* out)
+        {
+            // 원소 0~7, 8~15를 각각 전치해 엔티티별 행렬의 앞/뒤 절반으로 저장
+            for (int half = 0; half < 2; ++half)
+            {
+                const __m256 in[8] = {
+                    elements[half * 8 + 0], elements[half * 8 + 1], elements[half * 8 + 2], elements[half * 8 + 3],
+                    elements[half * 8 + 4], elements[half * 8 + 5], elements[half * 8 + 6], elements[half * 8 + 7],
+                };
+                __m256 rows[8];
+                Transpose8x8(in, rows);
+
+                for (int entity = 0; entity < 8; ++entity)
+                {
+                    _mm256_storeu_ps(out + entity * 16 + half * 8, rows[entity]);
+                }
+            }
+        }
+    };
+}
+
+size_t transform_kernel::BuildAvx2(const StreamView& streams, size_t count, const float* view_proj, float* out)
+{
+    const size_t lane_count = count & ~size_t{ 7 };
+    for (size_t i = 0; i < lane_count; i += 8)
+    {
+        BuildLanes<Avx2Ops>(streams, i, view_proj, out);
+    }
+    return lane_count;
+}
+
+bool transform_kernel::IsAvx2Compiled() { return true; }
+
+#else
+
+size_t transform_kernel::BuildAvx2(const StreamView&, size_t, const float*, float*) { return 0; }
+bool transform_kernel::IsAvx2Compiled() { return false; }
+
+#endif
@@ -0,0 +1,63 @@
+﻿// 이 파일은 SSE4.1 옵션으로 컴파일된다. (CMakeLists.txt 참고)
+#include "TransformKernelImpl.h"
+
+#if defined(__SSE4_1__) || defined(__AVX__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64)))
+#define SE_TRANSFORM_KERNEL_SSE41 1
+#include <smmintrin.h>
+#else
+#define SE_TRANSFORM_KERNEL_SSE41 0
+#endif
+
+#if SE_TRANSFORM_KERNEL_SSE41
+
+namespace
+{
+    struct Sse41Ops
+    {
+        using V = __m128;
+
+        static V Load(const float* p) { return _mm_loadu_ps(p); }
+        static V Set1(float v) { return _mm_set1_ps(v); }
+        static V Add(V a, V b) { return _mm_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+        static void StoreTransposed(const V (&elements)[16], float* out)
+        {
+            // 4x4 블록 4개를 전치해 엔티티별 행(4 float)으로 되돌린다
+            for (int row = 0; row < 4; ++row)
+            {
+                V c0 = elements[row * 4 + 0];
+                V c1 = elements[row * 4 + 1];
+                V c2 = elements[row * 4 + 2];
+                V c3 = elements[row * 4 + 3];
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+                _mm_storeu_ps(out + 0 * 16 + row * 4, c0);
+                _mm_storeu_ps(out + 1 * 16 + row * 4, c1);
+                _mm_storeu_ps(out + 2 * 16 + row * 4, c2);
+                _mm_storeu_ps(out + 3 * 16 + row * 4, c3);
+            }
+        }
+    };
+}
+
+size_t transform_kernel::BuildSse41(const StreamView& streams, size_t count, const float* view_proj, float* out)
+{
+    const size_t lane_count = count & ~size_t{ 3 };
+    for (size_t i = 0; i < lane_count; i += 4)
+    {
+        BuildLanes<Sse41Ops>(streams, i, view_proj, out);
+    }
+    return lane_count;
+}
+
+bool transform_kernel::IsSse41Compiled() { return true; }
+
+#else
+
+size_t transform_kernel::BuildSse41(const StreamView&, size_t, const float*, float*) { return 0; }
+bool transform_kernel::IsSse41Compiled() { return false; }
+
+#endif
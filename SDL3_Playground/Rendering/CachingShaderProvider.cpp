@@ -0,0 +1,62 @@
+﻿#include "CachingShaderProvider.h"
+
+#include "ShaderLibrary.h"
+#include "SimpleEngine/Graphics/Manager/PSOManager.h"
+
+#include "tracy/Tracy.hpp"
+
+using namespace se;
+using namespace se::graphics;
+
+
+namespace
+{
+    /// Default.vert.hlsl 처럼 파일 이름에 들어있는 스테이지
+    const char* GetStageFromPath(const std::filesystem::path& path)
+    {
+        const std::string file_name = path.filename().string();
+        if (file_name.contains(".vert.")) return "vertex";
+        if (file_name.contains(".frag.")) return "fragment";
+        if (file_name.contains(".comp.")) return "compute";
+        return "unknown";
+    }
+}
+
+CachingShaderProvider::CachingShaderProvider(ShaderLibrary& library)
+    : library(library)
+{
+    // Prewarm 등 Provider 밖에서 시작된 요청도 같은 컴파일 경로를 쓰도록 등록
+    library.SetCompiler([this](const ShaderCacheKeyDesc& desc)
+    {
+        const ShaderRequest request = { .source_path = desc.source_path };
+        std::lock_guard lock(compile_mutex);
+        const Array<uint8> code = Super::GetShaderCode(request, desc.format);
+        return std::vector<uint8>(code.Data(), code.Data() + code.Len());
+    });
+}
+
+CachingShaderProvider::~CachingShaderProvider()
+{
+    library.SetCompiler(nullptr);
+}
+
+Array<uint8> CachingShaderProvider::GetShaderCode(const ShaderRequest& request, SDL_GPUShaderFormat format)
+{
+    ZoneScoped;
+
+    const ShaderCacheKeyDesc desc = {
+        .source_path = request.source_path,
+        .stage = GetStageFromPath(request.source_path),
+        .format = format,
+    };
+
+    const ShaderBytecodePtr bytecode = library.GetOrCompile(desc);
+
+    Array<uint8> code;
+    code.Reserve(bytecode->size());
+    for (const uint8 byte : *bytecode)
+    {
+        code.Push(byte);
+    }
+    return code;
+}
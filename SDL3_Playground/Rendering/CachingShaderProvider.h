@@ -0,0 +1,34 @@
+﻿#pragma once
+#include <mutex>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Container/Array.h"
+
+#include "Graphics/Compiler/Provider.h"
+
+
+class ShaderLibrary;
+
+/**
+ * CompilingShaderProvider 앞에 ShaderLibrary(메모리) / ShaderCache(디스크)를 두는 Provider
+ *
+ * 같은 셰이더를 쓰는 파이프라인끼리는 모듈을 공유하고, 디스크 캐시에 있으면 바이트코드를 그대로 쓴다.
+ * 어디에도 없을 때만 기존 경로로 컴파일한다.
+ * CompilingShaderProvider는 스레드 안전성을 보장하지 않으므로, Prewarm 워커들이 동시에 요청해도 컴파일은 한 번에 하나씩 한다.
+ * 따라서 캐시가 비어 있는 첫 실행의 시작 시간은 줄지 않고, Prewarm은 디스크 캐시 읽기만 병렬로 한다.
+ */
+class CachingShaderProvider final : public se::editor::CompilingShaderProvider
+{
+    using Super = se::editor::CompilingShaderProvider;
+
+public:
+    explicit CachingShaderProvider(ShaderLibrary& library);
+    ~CachingShaderProvider() override;
+
+    se::Array<uint8> GetShaderCode(const se::graphics::ShaderRequest& request, SDL_GPUShaderFormat format) override;
+
+private:
+    ShaderLibrary& library;
+    std::mutex compile_mutex;
+};
@@ -0,0 +1,152 @@
+﻿#include "FrustumCulling.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SE_FRUSTUM_CULLING_SSE 1
+#include <emmintrin.h>
+#else
+#define SE_FRUSTUM_CULLING_SSE 0
+#endif
+
+using namespace se;
+
+
+Frustum Frustum::FromViewProjection(const Matrix4x4f& view_proj)
+{
+    // clip_k = Σ v_i * m[i][k] 이므로 평면은 열 벡터의 조합
+    const float* m = view_proj.GetData();
+    auto column = [m](int c, int r) { return m[r * 4 + c]; };
+
+    Frustum frustum;
+    for (int r = 0; r < 4; ++r)
+    {
+        const float c0 = column(0, r);
+        const float c1 = column(1, r);
+        const float c2 = column(2, r);
+        const float c3 = column(3, r);
+
+        frustum.planes[0][r] = c3 + c0; // left
+        frustum.planes[1][r] = c3 - c0; // right
+        frustum.planes[2][r] = c3 + c1; // bottom
+        frustum.planes[3][r] = c3 - c1; // top
+        frustum.planes[4][r] = c2;      // near (z >= 0)
+        frustum.planes[5][r] = c3 - c2; // far
+    }
+
+    for (float (&plane)[4] : frustum.planes)
+    {
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f)
+        {
+            for (float& value : plane)
+            {
+                value /= length;
+            }
+        }
+    }
+    return frustum;
+}
+
+void CullingBounds::Clear()
+{
+    center_x.clear();
+    center_y.clear();
+    center_z.clear();
+    extent_x.clear();
+    extent_y.clear();
+    extent_z.clear();
+}
+
+void CullingBounds::Reserve(size_t capacity)
+{
+    center_x.reserve(capacity);
+    center_y.reserve(capacity);
+    center_z.reserve(capacity);
+    extent_x.reserve(capacity);
+    extent_y.reserve(capacity);
+    extent_z.reserve(capacity);
+}
+
+void CullingBounds::Push(const AABB& bounds)
+{
+    center_x.push_back(static_cast<float>((bounds.min.x + bounds.max.x) * 0.5));
+    center_y.push_back(static_cast<float>((bounds.min.y + bounds.max.y) * 0.5));
+    center_z.push_back(static_cast<float>((bounds.min.z + bounds.max.z) * 0.5));
+    extent_x.push_back(static_cast<float>((bounds.max.x - bounds.min.x) * 0.5));
+    extent_y.push_back(static_cast<float>((bounds.max.y - bounds.min.y) * 0.5));
+    extent_z.push_back(static_cast<float>((bounds.max.z - bounds.min.z) * 0.5));
+}
+
+uint32 CullingBounds::Cull(const Frustum& frustum, std::vector<uint8>& out_visibility) const
+{
+    const size_t count = Num();
+    out_visibility.resize(count);
+
+    uint32 visible_count = 0;
+    size_t i = 0;
+
+#if SE_FRUSTUM_CULLING_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(center_x.data() + i);
+        const __m128 cy = _mm_loadu_ps(center_y.data() + i);
+        const __m128 cz = _mm_loadu_ps(center_z.data() + i);
+        const __m128 ex = _mm_loadu_ps(extent_x.data() + i);
+        const __m128 ey = _mm_loadu_ps(extent_y.data() + i);
+        const __m128 ez = _mm_loadu_ps(extent_z.data() + i);
+
+        // 어느 한 평면이라도 완전히 바깥이면 컬링
+        __m128 outside = _mm_setzero_ps();
+        for (const float (&plane)[4] : frustum.planes)
+        {
+            const __m128 a = _mm_set1_ps(plane[0]);
+            const __m128 b = _mm_set1_ps(plane[1]);
+            const __m128 c = _mm_set1_ps(plane[2]);
+            const __m128 d = _mm_set1_ps(plane[3]);
+
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(a, cx), _mm_mul_ps(b, cy)),
+                _mm_add_ps(_mm_mul_ps(c, cz), d)
+            );
+            const __m128 radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, a), ex), _mm_mul_ps(_mm_andnot_ps(sign_mask, b), ey)),
+                _mm_mul_ps(_mm_andnot_ps(sign_mask, c), ez)
+            );
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        const int outside_bits = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            const uint8 visible = (outside_bits & (1 << lane)) ? 0 : 1;
+            out_visibility[i + lane] = visible;
+            visible_count += visible;
+        }
+    }
+#endif
+
+    // 나머지 (또는 SSE가 없는 경우 전체)
+    for (; i < count; ++i)
+    {
+        bool is_outside = false;
+        for (const float (&plane)[4] : frustum.planes)
+        {
+            const float distance = plane[0] * center_x[i] + plane[1] * center_y[i] + plane[2] * center_z[i] + plane[3];
+            const float radius = std::abs(plane[0]) * extent_x[i] + std::abs(plane[1]) * extent_y[i] + std::abs(plane[2]) * extent_z[i];
+            if (distance + radius < 0.0f)
+            {
+                is_outside = true;
+                break;
+            }
+        }
+
+        out_visibility[i] = is_outside ? 0 : 1;
+        visible_count += is_outside ? 0 : 1;
+    }
+
+    return visible_count;
+}
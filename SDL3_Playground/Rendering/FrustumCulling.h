@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+
+
+/// 월드 공간 절두체 평면 6개
+struct Frustum
+{
+    // (a, b, c, d): a*x + b*y + c*z + d >= 0 이면 평면 안쪽 (left, right, bottom, top, near, far)
+    float planes[6][4];
+
+    /// 행 벡터 규약(clip = v * view_proj), 깊이 0~1 투영 행렬에서 평면을 추출한다.
+    static Frustum FromViewProjection(const se::Matrix4x4f& view_proj);
+};
+
+/**
+ * 컬링 대상 월드 AABB를 중심/반경 SoA(float)로 모아두고 절두체 판정을 묶음으로 수행한다.
+ * SSE가 있으면 4개씩, 없으면 스칼라로 처리한다.
+ */
+class CullingBounds
+{
+public:
+    void Clear();
+    void Reserve(size_t capacity);
+    void Push(const se::AABB& bounds);
+
+    [[nodiscard]] size_t Num() const { return center_x.size(); }
+
+    /// out_visibility[i]에 i번째 AABB가 절두체와 겹치면 1, 아니면 0을 쓰고 보이는 개수를 반환한다.
+    uint32 Cull(const Frustum& frustum, std::vector<uint8>& out_visibility) const;
+
+private:
+    std::vector<float> center_x, center_y, center_z;
+    std::vector<float> extent_x, extent_y, extent_z;
+};
@@ -0,0 +1,380 @@
+﻿#include "GeometryBuffer.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Rendering/UploadRing.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    // 인덱스 풀은 4바이트 단위 (16비트 인덱스 두 개, 32비트 인덱스 하나)
+    constexpr uint32 IndexUnitBytes = 4;
+    constexpr uint16 IndexPool = 0;
+
+    // 프레임마다 옮길 후보를 이만큼만 본다 (앞쪽에 빈 곳이 없는 할당을 끝까지 훑지 않게)
+    constexpr uint32 MaxCompactionCandidates = 32;
+}
+
+GeometryBuffer::GeometryBuffer(SDL_GPUDevice* device, UploadRing& upload_ring, uint32 page_bytes, uint32 retire_frames)
+    : device(device)
+    , upload_ring(upload_ring)
+    , page_bytes(page_bytes)
+    , retire_frames(retire_frames)
+{
+    pools.push_back({ .unit_bytes = IndexUnitBytes, .usage = SDL_GPU_BUFFERUSAGE_INDEX });
+}
+
+GeometryBuffer::~GeometryBuffer()
+{
+    for (const Pool& pool : pools)
+    {
+        for (const Page& page : pool.pages)
+        {
+            if (page.buffer)
+            {
+                SDL_ReleaseGPUBuffer(device, page.buffer);
+            }
+        }
+    }
+}
+
+uint32 GeometryBuffer::Upload(
+    std::span<const uint8> vertex_data, uint32 vertex_stride,
+    std::span<const uint8> index_data, SDL_GPUIndexElementSize index_element_size
+)
+{
+    ZoneScoped;
+
+    if (vertex_data.empty() || index_data.empty() || vertex_stride == 0 || vertex_data.size() % vertex_stride != 0)
+    {
+        return InvalidHandle;
+    }
+
+    uint32 handle;
+    if (!free_handles.empty())
+    {
+        handle = free_handles.back();
+        free_handles.pop_back();
+    }
+    else
+    {
+        meshes.emplace_back();
+        handle = static_cast<uint32>(meshes.size());
+    }
+
+    Mesh& mesh = meshes[handle - 1];
+    mesh = {};
+    mesh.index_element_bytes = index_element_size == SDL_GPU_INDEXELEMENTSIZE_16BIT ? 2 : 4;
+
+    const uint16 vertex_pool = FindOrCreatePool(vertex_stride, SDL_GPU_BUFFERUSAGE_VERTEX);
+    const uint32 num_vertices = static_cast<uint32>(vertex_data.size() / vertex_stride);
+    const uint32 index_units = static_cast<uint32>((index_data.size() + IndexUnitBytes - 1) / IndexUnitBytes);
+
+    if (!Allocate(vertex_pool, num_vertices, handle, mesh.vertices))
+    {
+        free_handles.push_back(handle);
+        return InvalidHandle;
+    }
+    if (!Allocate(IndexPool, index_units, handle, mesh.indices))
+    {
+        // 아직 아무것도 쓰지 않았으므로 바로 돌려준다
+        Page& page = pools[vertex_pool].pages[mesh.vertices.page];
+        page.allocations.erase(mesh.vertices.offset);
+        page.allocator.Free(mesh.vertices.offset, mesh.vertices.size);
+        free_handles.push_back(handle);
+        return InvalidHandle;
+    }
+
+    mesh.is_alive = true;
+    mesh.vertices_written_frame = current_frame;
+    mesh.indices_written_frame = current_frame;
+    ++num_meshes;
+
+    // 업로드 링보다 큰 메쉬는 링이 조각으로 나눠 올린다. 실패해도 예약된 복사가 있을 수 있으므로 구간은 지연 해제한다
+    if (!upload_ring.UploadToBuffer(GetBuffer(mesh.vertices), GetOffsetBytes(mesh.vertices), vertex_data.data(), static_cast<uint32>(vertex_data.size()))
+        || !upload_ring.UploadToBuffer(GetBuffer(mesh.indices), GetOffsetBytes(mesh.indices), index_data.data(), static_cast<uint32>(index_data.size())))
+    {
+        Free(handle);
+        return InvalidHandle;
+    }
+    return handle;
+}
+
+void GeometryBuffer::Free(uint32 handle)
+{
+    if (handle == InvalidHandle || handle > meshes.size()) return;
+
+    Mesh& mesh = meshes[handle - 1];
+    if (!mesh.is_alive) return;
+
+    RetireRange(mesh.vertices);
+    RetireRange(mesh.indices);
+    mesh.is_alive = false;
+    free_handles.push_back(handle);
+    --num_meshes;
+}
+
+GeometrySlice GeometryBuffer::GetSlice(uint32 handle) const
+{
+    if (handle == InvalidHandle || handle > meshes.size()) return {};
+
+    const Mesh& mesh = meshes[handle - 1];
+    if (!mesh.is_alive) return {};
+
+    return {
+        .vertex_buffer = GetBuffer(mesh.vertices),
+        .index_buffer = GetBuffer(mesh.indices),
+        .first_vertex = mesh.vertices.offset,
+        .first_index = GetOffsetBytes(mesh.indices) / mesh.index_element_bytes,
+    };
+}
+
+void GeometryBuffer::Update(uint64 frame_index, uint64 max_move_bytes)
+{
+    ZoneScoped;
+
+    current_frame = frame_index;
+
+    // GPU가 다 읽은 구간을 돌려준다. 빈 곳이 생겼으므로 조각 모음을 다시 시도한다
+    while (!pending_frees.empty() && pending_frees.front().frame + retire_frames <= frame_index)
+    {
+        const Range& range = pending_frees.front().range;
+        pools[range.pool].pages[range.page].allocator.Free(range.offset, range.size);
+        pending_frees.pop_front();
+        needs_compaction = true;
+    }
+
+    if (needs_compaction && max_move_bytes > 0)
+    {
+        uint64 frame_moved_bytes = 0;
+        for (uint16 pool_index = 0; pool_index < pools.size() && frame_moved_bytes < max_move_bytes; ++pool_index)
+        {
+            frame_moved_bytes += CompactPool(pool_index, max_move_bytes - frame_moved_bytes);
+        }
+
+        // 더 옮길 것이 없다. 옮긴 구간이 돌아오면 다시 시도한다
+        if (frame_moved_bytes == 0)
+        {
+            needs_compaction = false;
+        }
+    }
+
+    ReleaseEmptyPages();
+}
+
+GeometryBufferStats GeometryBuffer::GetStats() const
+{
+    GeometryBufferStats stats;
+    stats.num_meshes = num_meshes;
+    stats.moved_bytes = moved_bytes;
+    stats.num_moves = num_moves;
+
+    for (const Pool& pool : pools)
+    {
+        for (const Page& page : pool.pages)
+        {
+            if (!page.buffer) continue;
+
+            const RangeAllocator& allocator = page.allocator;
+            const uint64 free_bytes = static_cast<uint64>(allocator.GetFreeSize()) * pool.unit_bytes;
+            const uint64 largest_free_bytes = static_cast<uint64>(allocator.GetLargestFreeBlock()) * pool.unit_bytes;
+
+            ++stats.num_buffers;
+            stats.capacity_bytes += static_cast<uint64>(allocator.GetCapacity()) * pool.unit_bytes;
+            stats.used_bytes += static_cast<uint64>(allocator.GetUsedSize()) * pool.unit_bytes;
+            stats.largest_free_bytes = std::max(stats.largest_free_bytes, largest_free_bytes);
+            stats.num_free_blocks += allocator.GetNumFreeBlocks();
+            if (free_bytes > 0)
+            {
+                const float fragmentation = 1.0f - static_cast<float>(largest_free_bytes) / static_cast<float>(free_bytes);
+                stats.fragmentation = std::max(stats.fragmentation, fragmentation);
+            }
+        }
+    }
+
+    for (const PendingFree& pending : pending_frees)
+    {
+        stats.pending_free_bytes += static_cast<uint64>(pending.range.size) * pools[pending.range.pool].unit_bytes;
+    }
+    return stats;
+}
+
+uint16 GeometryBuffer::FindOrCreatePool(uint32 unit_bytes, SDL_GPUBufferUsageFlags usage)
+{
+    for (uint16 i = 0; i < pools.size(); ++i)
+    {
+        if (pools[i].unit_bytes == unit_bytes && pools[i].usage == usage)
+        {
+            return i;
+        }
+    }
+
+    pools.push_back({ .unit_bytes = unit_bytes, .usage = usage });
+    return static_cast<uint16>(pools.size() - 1);
+}
+
+bool GeometryBuffer::Allocate(uint16 pool_index, uint32 size, uint32 handle, Range& out_range)
+{
+    Pool& pool = pools[pool_index];
+
+    // 앞쪽 페이지부터 채워서 뒤쪽 페이지가 비워질 수 있게 한다
+    for (uint16 page_index = 0; page_index < pool.pages.size(); ++page_index)
+    {
+        Page& page = pool.pages[page_index];
+        if (!page.buffer) continue;
+
+        if (const std::optional<uint32> offset = page.allocator.Allocate(size))
+        {
+            page.allocations.emplace(*offset, handle);
+            out_range = { .pool = pool_index, .page = page_index, .offset = *offset, .size = size };
+            return true;
+        }
+    }
+
+    uint16 page_index;
+    if (!CreatePage(pool, size, page_index))
+    {
+        return false;
+    }
+
+    Page& page = pool.pages[page_index];
+    const uint32 offset = *page.allocator.Allocate(size);
+    page.allocations.emplace(offset, handle);
+    out_range = { .pool = pool_index, .page = page_index, .offset = offset, .size = size };
+    return true;
+}
+
+bool GeometryBuffer::CreatePage(Pool& pool, uint32 min_units, uint16& out_page)
+{
+    ZoneScoped;
+
+    // 페이지보다 큰 메쉬는 그 크기의 페이지를 따로 만든다
+    const uint64 max_units = std::numeric_limits<uint32>::max() / pool.unit_bytes;
+    const uint32 num_units = std::max(page_bytes / pool.unit_bytes, min_units);
+    if (num_units > max_units)
+    {
+        return false;
+    }
+
+    const SDL_GPUBufferCreateInfo buffer_info = {
+        .usage = pool.usage,
+        .size = num_units * pool.unit_bytes,
+    };
+    SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+    if (!buffer)
+    {
+        return false;
+    }
+
+    const auto empty_slot = std::ranges::find(pool.pages, nullptr, &Page::buffer);
+    if (empty_slot == pool.pages.end() && pool.pages.size() >= std::numeric_limits<uint16>::max())
+    {
+        SDL_ReleaseGPUBuffer(device, buffer);
+        return false;
+    }
+
+    Page& page = empty_slot != pool.pages.end() ? *empty_slot : pool.pages.emplace_back();
+    page.buffer = buffer;
+    page.allocator = RangeAllocator(num_units);
+    page.allocations.clear();
+    out_page = static_cast<uint16>(&page - pool.pages.data());
+    return true;
+}
+
+void GeometryBuffer::RetireRange(const Range& range)
+{
+    pools[range.pool].pages[range.page].allocations.erase(range.offset);
+    pending_frees.push_back({ .range = range, .frame = current_frame });
+}
+
+uint64 GeometryBuffer::CompactPool(uint16 pool_index, uint64 max_move_bytes)
+{
+    ZoneScoped;
+
+    struct Candidate
+    {
+        uint16 page;
+        uint32 offset;
+        uint32 handle;
+    };
+
+    // 뒤쪽 페이지의 높은 offset부터
+    Pool& pool = pools[pool_index];
+    std::vector<Candidate> candidates;
+    for (size_t page_index = pool.pages.size(); page_index-- > 0 && candidates.size() < MaxCompactionCandidates;)
+    {
+        const Page& page = pool.pages[page_index];
+        for (auto it = page.allocations.rbegin(); it != page.allocations.rend() && candidates.size() < MaxCompactionCandidates; ++it)
+        {
+            candidates.push_back({ static_cast<uint16>(page_index), it->first, it->second });
+        }
+    }
+
+    uint64 frame_moved_bytes = 0;
+    for (const Candidate& candidate : candidates)
+    {
+        Mesh& mesh = meshes[candidate.handle - 1];
+        const bool is_index = pool_index == IndexPool;
+        uint64& written_frame = is_index ? mesh.indices_written_frame : mesh.vertices_written_frame;
+        if (written_frame == current_frame) continue; // 이번 Copy Pass에서 쓴 구간
+
+        Range& range = is_index ? mesh.indices : mesh.vertices;
+        const uint64 size_bytes = static_cast<uint64>(range.size) * pool.unit_bytes;
+        if (frame_moved_bytes > 0 && frame_moved_bytes + size_bytes > max_move_bytes)
+        {
+            break; // 예산보다 큰 할당도 프레임에 하나는 옮길 수 있게 첫 번째는 통과시킨다
+        }
+
+        // 앞쪽 페이지는 어디든, 같은 페이지는 지금 위치보다 앞에서 끝나는 곳만 (겹치는 복사를 피한다)
+        std::optional<uint32> new_offset;
+        uint16 new_page = 0;
+        for (; new_page <= candidate.page; ++new_page)
+        {
+            Page& page = pool.pages[new_page];
+            if (!page.buffer) continue;
+
+            const uint32 limit = new_page < candidate.page ? page.allocator.GetCapacity() : range.offset;
+            new_offset = page.allocator.AllocateLowest(range.size, limit);
+            if (new_offset) break;
+        }
+        if (!new_offset) continue;
+
+        const Range new_range = { .pool = pool_index, .page = new_page, .offset = *new_offset, .size = range.size };
+        upload_ring.CopyBuffer(
+            GetBuffer(range), GetOffsetBytes(range),
+            GetBuffer(new_range), GetOffsetBytes(new_range),
+            static_cast<uint32>(size_bytes)
+        );
+
+        // 이전 위치는 진행 중인 프레임이 아직 읽으므로 지연 해제한다
+        RetireRange(range);
+        pool.pages[new_page].allocations.emplace(new_range.offset, candidate.handle);
+        range = new_range;
+        written_frame = current_frame;
+
+        frame_moved_bytes += size_bytes;
+        moved_bytes += size_bytes;
+        ++num_moves;
+    }
+    return frame_moved_bytes;
+}
+
+void GeometryBuffer::ReleaseEmptyPages()
+{
+    for (Pool& pool : pools)
+    {
+        for (size_t page_index = 1; page_index < pool.pages.size(); ++page_index)
+        {
+            // 지연 해제까지 모두 돌아온 페이지만 놓는다 (GPU가 더 이상 읽지 않는다)
+            Page& page = pool.pages[page_index];
+            if (page.buffer && page.allocations.empty() && page.allocator.GetUsedSize() == 0)
+            {
+                SDL_ReleaseGPUBuffer(device, page.buffer);
+                page.buffer = nullptr;
+                page.allocator = RangeAllocator();
+            }
+        }
+    }
+}
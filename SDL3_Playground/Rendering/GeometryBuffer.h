@@ -0,0 +1,154 @@
+﻿#pragma once
+#include <deque>
+#include <map>
+#include <span>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+#include "Rendering/RangeAllocator.h"
+
+
+class UploadRing;
+
+/// 공용 버퍼 안에서 메쉬 하나의 위치. 같은 버퍼의 메쉬끼리는 다시 바인딩하지 않고 first_vertex / first_index만 바꾼다.
+struct GeometrySlice
+{
+    SDL_GPUBuffer* vertex_buffer = nullptr;
+    SDL_GPUBuffer* index_buffer = nullptr;
+    uint32 first_vertex = 0; // base vertex에 더한다
+    uint32 first_index = 0;  // 인덱스 원소 단위
+
+    [[nodiscard]] bool IsValid() const { return vertex_buffer != nullptr && index_buffer != nullptr; }
+};
+
+struct GeometryBufferStats
+{
+    uint32 num_buffers = 0;
+    uint32 num_meshes = 0;
+    uint64 capacity_bytes = 0;
+    uint64 used_bytes = 0;
+    uint64 pending_free_bytes = 0; // GPU가 아직 읽을 수 있어 할당기에 돌려주지 않은 바이트
+    uint64 largest_free_bytes = 0;
+    uint32 num_free_blocks = 0;
+    float fragmentation = 0.0f;    // 1 - 가장 큰 빈 구간 / 빈 바이트 (버퍼별 값 중 최대)
+    uint64 moved_bytes = 0;        // 조각 모음으로 옮긴 누적 바이트
+    uint32 num_moves = 0;
+};
+
+/**
+ * 정적 메쉬의 정점 / 인덱스를 큰 GPU 버퍼 몇 개에서 나눠 쓰는 지오메트리 버퍼
+ *
+ * 정점은 stride별 풀에 정점 단위로, 인덱스는 한 풀에 4바이트 단위로 할당하고, 풀은 page_bytes 크기의 버퍼(페이지)로 늘어난다.
+ * 정점 위치는 base vertex로, 인덱스 위치는 first index로 그리므로 같은 페이지의 메쉬끼리는 버퍼를 다시 바인딩하지 않는다.
+ *
+ * 해제한 구간은 retire_frames 프레임 뒤에(GPU가 다 읽은 뒤에) 할당기로 돌아간다.
+ * 돌아온 구간이 있으면 Update마다 예산만큼 뒤쪽 할당을 앞쪽 빈 곳으로 GPU에서 복사해 조각을 모으고,
+ * 비게 된 페이지는 (첫 페이지 제외) 버퍼를 놓는다.
+ * 메인 스레드에서만 바꾸고, 렌더 워커는 GetSlice로 읽기만 한다.
+ */
+class GeometryBuffer
+{
+public:
+    static constexpr uint32 InvalidHandle = 0;
+
+    GeometryBuffer(SDL_GPUDevice* device, UploadRing& upload_ring, uint32 page_bytes, uint32 retire_frames);
+    ~GeometryBuffer();
+
+    GeometryBuffer(const GeometryBuffer&) = delete;
+    GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+    GeometryBuffer(GeometryBuffer&&) = delete;
+    GeometryBuffer& operator=(GeometryBuffer&&) = delete;
+
+public:
+    /// 정점 / 인덱스 자리를 잡고 업로드 링에 복사를 예약한다. 실패하면 InvalidHandle
+    [[nodiscard]] uint32 Upload(
+        std::span<const uint8> vertex_data, uint32 vertex_stride,
+        std::span<const uint8> index_data, SDL_GPUIndexElementSize index_element_size
+    );
+
+    /// 핸들은 바로 무효가 되고, 구간은 retire_frames 뒤에 다시 쓰인다.
+    void Free(uint32 handle);
+
+    [[nodiscard]] GeometrySlice GetSlice(uint32 handle) const;
+
+    /// 프레임마다 업로드 전에 호출한다. frame_index는 이번에 기록할 프레임 번호
+    /// GPU가 다 읽은 구간을 돌려주고, 조각 모음으로 최대 max_move_bytes를 옮긴다.
+    void Update(uint64 frame_index, uint64 max_move_bytes);
+
+    [[nodiscard]] GeometryBufferStats GetStats() const;
+
+private:
+    /// 풀의 unit_bytes 단위 구간
+    struct Range
+    {
+        uint16 pool = 0;
+        uint16 page = 0;
+        uint32 offset = 0;
+        uint32 size = 0;
+    };
+
+    struct Mesh
+    {
+        Range vertices;
+        Range indices;
+        uint32 index_element_bytes = 0;
+        // 이 프레임에 쓴 구간은 같은 Copy Pass에서 다시 옮기지 않는다 (정점 / 인덱스는 따로 옮길 수 있다)
+        uint64 vertices_written_frame = 0;
+        uint64 indices_written_frame = 0;
+        bool is_alive = false;
+    };
+
+    struct Page
+    {
+        SDL_GPUBuffer* buffer = nullptr; // 놓은 페이지는 nullptr, 다음 페이지가 자리를 재사용한다
+        RangeAllocator allocator;
+        std::map<uint32, uint32> allocations; // offset -> 메쉬 핸들, 조각 모음에서 뒤쪽부터 고른다
+    };
+
+    struct Pool
+    {
+        uint32 unit_bytes = 0;
+        SDL_GPUBufferUsageFlags usage = 0;
+        std::vector<Page> pages;
+    };
+
+    struct PendingFree
+    {
+        Range range;
+        uint64 frame = 0;
+    };
+
+    uint16 FindOrCreatePool(uint32 unit_bytes, SDL_GPUBufferUsageFlags usage);
+    bool Allocate(uint16 pool_index, uint32 size, uint32 handle, Range& out_range);
+    bool CreatePage(Pool& pool, uint32 min_units, uint16& out_page);
+
+    /// 페이지 할당 목록에서 빼고 retire_frames 뒤에 할당기로 돌려준다.
+    void RetireRange(const Range& range);
+
+    /// 뒤쪽 페이지 / 높은 offset의 할당부터 앞쪽 빈 곳으로 옮긴다. 옮긴 바이트를 돌려준다.
+    uint64 CompactPool(uint16 pool_index, uint64 max_move_bytes);
+
+    void ReleaseEmptyPages();
+
+    [[nodiscard]] SDL_GPUBuffer* GetBuffer(const Range& range) const { return pools[range.pool].pages[range.page].buffer; }
+    [[nodiscard]] uint32 GetOffsetBytes(const Range& range) const { return range.offset * pools[range.pool].unit_bytes; }
+
+private:
+    SDL_GPUDevice* device;
+    UploadRing& upload_ring;
+    uint32 page_bytes;
+    uint32 retire_frames;
+
+    std::vector<Pool> pools; // [0]은 인덱스, 나머지는 정점 stride별
+    std::vector<Mesh> meshes; // 핸들 - 1
+    std::vector<uint32> free_handles;
+    std::deque<PendingFree> pending_frees; // 해제한 프레임 순서
+    uint64 current_frame = 0;
+    bool needs_compaction = false;
+
+    uint32 num_meshes = 0;
+    uint64 moved_bytes = 0;
+    uint32 num_moves = 0;
+};
@@ -0,0 +1,93 @@
+﻿#include "InstanceBuffer.h"
+
+#include <algorithm>
+#include <bit>
+
+
+InstanceBuffer::InstanceBuffer(SDL_GPUDevice* device)
+    : device(device)
+{
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    ReleaseBuffers();
+}
+
+bool InstanceBuffer::Upload(SDL_GPUCommandBuffer* command_buffer, const void* data, uint32 size)
+{
+    if (size == 0)
+    {
+        return true;
+    }
+
+    if (!Reserve(size))
+    {
+        return false;
+    }
+
+    // 이전 프레임이 아직 읽고 있을 수 있으므로 cycle해서 매핑
+    void* map = SDL_MapGPUTransferBuffer(device, transfer_buffer, true);
+    if (!map)
+    {
+        return false;
+    }
+    SDL_memcpy(map, data, size);
+    SDL_UnmapGPUTransferBuffer(device, transfer_buffer);
+
+    SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(command_buffer);
+    const SDL_GPUTransferBufferLocation src = { .transfer_buffer = transfer_buffer, .offset = 0 };
+    const SDL_GPUBufferRegion dst = { .buffer = buffer, .offset = 0, .size = size };
+    SDL_UploadToGPUBuffer(copy_pass, &src, &dst, true);
+    SDL_EndGPUCopyPass(copy_pass);
+    return true;
+}
+
+bool InstanceBuffer::Reserve(uint32 size)
+{
+    if (size <= capacity)
+    {
+        return true;
+    }
+
+    ReleaseBuffers();
+
+    // 매 프레임 조금씩 늘어나는 경우 재생성이 반복되지 않도록 2의 거듭제곱으로 키운다
+    const uint32 new_capacity = std::bit_ceil(std::max(size, 4096u));
+
+    const SDL_GPUBufferCreateInfo buffer_info = {
+        .usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+        .size = new_capacity,
+    };
+    buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+
+    const SDL_GPUTransferBufferCreateInfo transfer_info = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = new_capacity,
+    };
+    transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+
+    if (!buffer || !transfer_buffer)
+    {
+        ReleaseBuffers();
+        return false;
+    }
+
+    capacity = new_capacity;
+    return true;
+}
+
+void InstanceBuffer::ReleaseBuffers()
+{
+    if (buffer)
+    {
+        SDL_ReleaseGPUBuffer(device, buffer);
+        buffer = nullptr;
+    }
+    if (transfer_buffer)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
+        transfer_buffer = nullptr;
+    }
+    capacity = 0;
+}
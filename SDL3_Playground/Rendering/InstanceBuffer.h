@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <span>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/**
+ * 인스턴스별 데이터를 담는 프레임 단위 Storage Buffer
+ *
+ * 버텍스 셰이더에서 StructuredBuffer로 읽는다.
+ * 업로드할 때마다 cycle을 사용하므로, 이전 프레임이나 다른 윈도우가 아직 GPU에서
+ * 사용 중인 버퍼도 대기 없이 덮어쓸 수 있다.
+ */
+class InstanceBuffer
+{
+public:
+    explicit InstanceBuffer(SDL_GPUDevice* device);
+    ~InstanceBuffer();
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+    InstanceBuffer(InstanceBuffer&&) = delete;
+    InstanceBuffer& operator=(InstanceBuffer&&) = delete;
+
+public:
+    /// data를 Storage Buffer로 복사하는 Copy Pass를 command_buffer에 기록한다.
+    /// Render Pass가 열려 있지 않은 상태에서 호출해야 한다.
+    bool Upload(SDL_GPUCommandBuffer* command_buffer, const void* data, uint32 size);
+
+    template <typename T>
+    bool Upload(SDL_GPUCommandBuffer* command_buffer, std::span<const T> elements)
+    {
+        return Upload(command_buffer, elements.data(), static_cast<uint32>(elements.size_bytes()));
+    }
+
+    [[nodiscard]] SDL_GPUBuffer* GetBuffer() const { return buffer; }
+    [[nodiscard]] uint32 GetCapacity() const { return capacity; }
+
+private:
+    /// 최소 size 바이트를 담을 수 있도록 버퍼를 (재)생성한다.
+    bool Reserve(uint32 size);
+    void ReleaseBuffers();
+
+private:
+    SDL_GPUDevice* device = nullptr;
+    SDL_GPUBuffer* buffer = nullptr;
+    SDL_GPUTransferBuffer* transfer_buffer = nullptr;
+    uint32 capacity = 0;
+};
@@ -0,0 +1,280 @@
+﻿#include "MeshEncoding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+#include "tracy/Tracy.hpp"
+
+using namespace se;
+
+
+namespace
+{
+    int16 ToSnorm16(float value)
+    {
+        return static_cast<int16>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    uint16 ToUnorm16(float value)
+    {
+        return static_cast<uint16>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    void EncodeCompactVertices(const asset::StaticMesh& mesh, EncodedMesh& out_mesh)
+    {
+        const uint32 num_vertices = mesh.vertices.Len();
+        const Vertex* vertices = mesh.vertices.Data();
+
+        float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float max[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+        for (uint32 i = 0; i < num_vertices; ++i)
+        {
+            const float position[3] = { vertices[i].position.x, vertices[i].position.y, vertices[i].position.z };
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                min[axis] = std::min(min[axis], position[axis]);
+                max[axis] = std::max(max[axis], position[axis]);
+            }
+        }
+
+        PositionDequantize& dequantize = out_mesh.format.dequantize;
+        float inv_extent[3];
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            const float extent = max[axis] - min[axis];
+            dequantize.position_min[axis] = min[axis];
+            dequantize.position_scale[axis] = extent;
+            inv_extent[axis] = extent > 0.0f ? 1.0f / extent : 0.0f; // 납작한 축은 전부 min
+        }
+
+        out_mesh.vertex_data.resize(num_vertices * sizeof(CompactVertex));
+        auto* compact = reinterpret_cast<CompactVertex*>(out_mesh.vertex_data.data());
+        for (uint32 i = 0; i < num_vertices; ++i)
+        {
+            const Vertex& vertex = vertices[i];
+            CompactVertex& out = compact[i];
+
+            out.position[0] = ToUnorm16((vertex.position.x - min[0]) * inv_extent[0]);
+            out.position[1] = ToUnorm16((vertex.position.y - min[1]) * inv_extent[1]);
+            out.position[2] = ToUnorm16((vertex.position.z - min[2]) * inv_extent[2]);
+            out.position[3] = 0;
+
+            EncodeOctahedralNormal(vertex.normal.x, vertex.normal.y, vertex.normal.z, out.normal);
+
+            out.tex_coord[0] = FloatToHalf(vertex.tex_coord.x);
+            out.tex_coord[1] = FloatToHalf(vertex.tex_coord.y);
+        }
+    }
+
+    void EncodeIndices(const asset::StaticMesh& mesh, std::span<const MeshLod> lods, EncodedMesh& out_mesh)
+    {
+        const uint32 num_indices = mesh.indices.Len();
+        const uint32* indices = mesh.indices.Data();
+
+        /* 인덱스 버퍼 = 원본 인덱스 + LOD1, LOD2, ... 인덱스
+         * 각 LOD 섹션이 버퍼의 어디에 있는지 기록해 두고, 복사할 원본 위치와 섹션 번호를 같이 모은다.
+         */
+        struct CopyRange
+        {
+            const uint32* source;
+            uint32 count;
+            uint32 dest_start;
+            uint32 section;
+        };
+        std::vector<CopyRange> ranges;
+
+        out_mesh.format.lods.reserve(1 + lods.size()); // base_lod 참조가 유지되도록
+        GpuMeshLod& base_lod = out_mesh.format.lods.emplace_back();
+        uint32 section_index = 0;
+        for (const auto& section : mesh.sections)
+        {
+            const uint32 end = std::min(section.index_start + section.index_count, num_indices);
+            const uint32 count = end > section.index_start ? end - section.index_start : 0;
+            base_lod.sections.push_back({ section.index_start, count });
+            base_lod.num_triangles += count / 3;
+            ranges.push_back({ indices + section.index_start, count, section.index_start, section_index++ });
+        }
+
+        uint32 total_indices = num_indices;
+        for (const MeshLod& lod : lods)
+        {
+            if (lod.section_index_counts.size() != base_lod.sections.size()) break; // 섹션 구성이 다르면 버린다
+
+            GpuMeshLod& gpu_lod = out_mesh.format.lods.emplace_back();
+            gpu_lod.num_triangles = lod.num_triangles;
+            gpu_lod.error = lod.error;
+
+            uint32 source_offset = 0;
+            for (uint32 s = 0; s < lod.section_index_counts.size(); ++s)
+            {
+                const uint32 count = lod.section_index_counts[s];
+                gpu_lod.sections.push_back({ total_indices, count });
+                ranges.push_back({ lod.indices.data() + source_offset, count, total_indices, s });
+                source_offset += count;
+                total_indices += count;
+            }
+        }
+
+        // 섹션마다 참조하는 정점 범위가 16비트 안에 들어오는지 본다
+        // LOD는 같은 섹션의 정점만 쓰므로 원본 섹션 범위만 보면 된다
+        bool is_16bit = true;
+        std::vector<int32>& vertex_offsets = out_mesh.format.section_vertex_offsets;
+        for (const GpuIndexRange& section : base_lod.sections)
+        {
+            uint32 min_index = std::numeric_limits<uint32>::max();
+            uint32 max_index = 0;
+            for (uint32 i = section.index_start; i < section.index_start + section.index_count; ++i)
+            {
+                min_index = std::min(min_index, indices[i]);
+                max_index = std::max(max_index, indices[i]);
+            }
+
+            if (min_index > max_index)
+            {
+                min_index = max_index = 0; // 빈 섹션
+            }
+            is_16bit &= max_index - min_index <= std::numeric_limits<uint16>::max();
+            vertex_offsets.push_back(static_cast<int32>(min_index));
+        }
+
+        if (!is_16bit || vertex_offsets.empty())
+        {
+            std::ranges::fill(vertex_offsets, 0);
+            out_mesh.format.index_element_size = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+            out_mesh.index_data.assign(total_indices * sizeof(uint32), 0);
+            auto* indices32 = reinterpret_cast<uint32*>(out_mesh.index_data.data());
+
+            std::memcpy(indices32, indices, num_indices * sizeof(uint32));
+            for (const CopyRange& range : ranges)
+            {
+                std::memcpy(indices32 + range.dest_start, range.source, range.count * sizeof(uint32));
+            }
+            return;
+        }
+
+        // 섹션에 속하지 않는 인덱스는 그려지지 않으므로 0으로 둔다
+        // 버퍼 복사는 4바이트 단위로 맞춘다
+        out_mesh.format.index_element_size = SDL_GPU_INDEXELEMENTSIZE_16BIT;
+        out_mesh.index_data.assign((total_indices * sizeof(uint16) + 3) & ~size_t{ 3 }, 0);
+        auto* indices16 = reinterpret_cast<uint16*>(out_mesh.index_data.data());
+
+        for (const CopyRange& range : ranges)
+        {
+            const uint32 base = static_cast<uint32>(vertex_offsets[range.section]);
+            for (uint32 i = 0; i < range.count; ++i)
+            {
+                indices16[range.dest_start + i] = static_cast<uint16>(range.source[i] - base);
+            }
+        }
+    }
+}
+
+EncodedMesh EncodeMeshForGpu(const asset::StaticMesh& mesh, std::span<const MeshLod> lods, bool use_compact_vertices)
+{
+    ZoneScoped;
+
+    EncodedMesh encoded;
+    encoded.format.is_compact = use_compact_vertices;
+    if (use_compact_vertices)
+    {
+        EncodeCompactVertices(mesh, encoded);
+    }
+    else
+    {
+        encoded.vertex_data.resize(mesh.vertices.Len() * sizeof(Vertex));
+        std::memcpy(encoded.vertex_data.data(), mesh.vertices.Data(), encoded.vertex_data.size());
+    }
+
+    EncodeIndices(mesh, lods, encoded);
+    return encoded;
+}
+
+GpuMeshData MakeGpuMeshData(const asset::StaticMesh& mesh, std::span<const MeshLod> lods, bool use_compact_vertices)
+{
+    auto encoded = std::make_shared<EncodedMesh>(EncodeMeshForGpu(mesh, lods, use_compact_vertices));
+
+    GpuMeshData data;
+    data.format = encoded->format;
+    data.bounds = mesh.bounds;
+    data.vertex_data = encoded->vertex_data;
+    data.index_data = encoded->index_data;
+    data.full_format_bytes = static_cast<uint64>(mesh.vertices.Len()) * sizeof(Vertex)
+                           + static_cast<uint64>(mesh.indices.Len()) * sizeof(uint32);
+    data.storage = std::move(encoded);
+    return data;
+}
+
+uint16 FloatToHalf(float value)
+{
+    uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32 sign = (bits >> 16) & 0x8000;
+    const uint32 magnitude = bits & 0x7FFFFFFF;
+
+    // NaN / Inf, half로 표현할 수 없는 큰 값
+    if (magnitude >= 0x7F800000)
+    {
+        return static_cast<uint16>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+    }
+    if (magnitude >= 0x47800000)
+    {
+        return static_cast<uint16>(sign | 0x7C00);
+    }
+
+    // half의 비정규 범위 (2^-14 미만)
+    if (magnitude < 0x38800000)
+    {
+        if (magnitude < 0x33000000)
+        {
+            return static_cast<uint16>(sign);
+        }
+
+        const uint32 mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        const uint32 shift = 126 - (magnitude >> 23);
+        uint32 half = mantissa >> shift;
+        const uint32 remainder = mantissa & ((1u << shift) - 1);
+        const uint32 halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+            ++half;
+        }
+        return static_cast<uint16>(sign | half);
+    }
+
+    // 지수 바이어스를 127에서 15로 바꾸고 가수를 13비트 줄인다 (짝수 반올림, 넘치면 지수로 올라간다)
+    uint32 half = (magnitude - 0x38000000) >> 13;
+    const uint32 remainder = magnitude & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        ++half;
+    }
+    return static_cast<uint16>(sign | half);
+}
+
+void EncodeOctahedralNormal(float x, float y, float z, int16 out_encoded[2])
+{
+    const float l1_norm = std::abs(x) + std::abs(y) + std::abs(z);
+    if (l1_norm <= 0.0f)
+    {
+        out_encoded[0] = out_encoded[1] = 0; // +Z로 복원된다
+        return;
+    }
+
+    float u = x / l1_norm;
+    float v = y / l1_norm;
+    if (z < 0.0f)
+    {
+        // 아래쪽 반구는 대각선으로 접어 바깥 삼각형에 넣는다
+        const float folded_u = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        const float folded_v = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = folded_u;
+        v = folded_v;
+    }
+
+    out_encoded[0] = ToSnorm16(u);
+    out_encoded[1] = ToSnorm16(v);
+}
@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+
+#include "Asset/MeshSimplifier.h"
+
+
+namespace se::asset
+{
+struct StaticMesh;
+}
+
+/**
+ * Compact.vert.hlsl이 읽는 압축 정점 (16 바이트, se::Vertex는 48 바이트)
+ *
+ * position: 메쉬 AABB 기준 unorm16 (w는 패딩), 셰이더에서 position_min + v * position_scale로 복원
+ * normal: 8면체(octahedral) 인코딩 snorm16x2
+ * tex_coord: half2
+ * tangent는 셰이더가 쓰지 않으므로 싣지 않는다.
+ */
+struct CompactVertex
+{
+    uint16 position[4];
+    int16 normal[2];
+    uint16 tex_coord[2];
+};
+static_assert(sizeof(CompactVertex) == 16);
+
+/// 압축 위치 복원용 uniform (Compact.vert.hlsl의 MeshBuffer와 같은 배치)
+struct PositionDequantize
+{
+    float position_min[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float position_scale[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+};
+
+struct GpuIndexRange
+{
+    uint32 index_start = 0;
+    uint32 index_count = 0;
+};
+
+/// 인덱스 버퍼 안에서 LOD 하나가 차지하는 섹션별 범위
+struct GpuMeshLod
+{
+    std::vector<GpuIndexRange> sections; // StaticMesh::sections와 같은 순서
+    uint32 num_triangles = 0;
+    float error = 0.0f;
+};
+
+/// 메쉬가 GPU에 올라간 형식. 그릴 때 파이프라인 / 인덱스 크기 / base vertex / LOD 범위를 고르는 데 쓴다.
+struct MeshGpuFormat
+{
+    bool is_compact = false;
+    SDL_GPUIndexElementSize index_element_size = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+    std::vector<int32> section_vertex_offsets; // 섹션별 base vertex (16비트 인덱스는 섹션 안에서의 상대 번호)
+    std::vector<GpuMeshLod> lods;              // [0]은 원본, 모든 LOD가 같은 정점 버퍼를 쓴다
+    PositionDequantize dequantize;
+};
+
+struct EncodedMesh
+{
+    MeshGpuFormat format;
+    std::vector<uint8> vertex_data;
+    std::vector<uint8> index_data;
+};
+
+/// 업로드할 메쉬 하나. 바이트는 storage(인코딩 결과나 쿠킹 파일 매핑)가 붙잡고 있는 메모리를 가리킨다.
+struct GpuMeshData
+{
+    MeshGpuFormat format;
+    se::AABBf bounds;
+    std::span<const uint8> vertex_data;
+    std::span<const uint8> index_data;
+    uint64 full_format_bytes = 0; // se::Vertex / 32비트 인덱스로 올렸을 때의 크기 (통계용)
+    std::shared_ptr<const void> storage;
+
+    [[nodiscard]] bool IsValid() const { return !vertex_data.empty() && !index_data.empty(); }
+};
+
+/* GPU 업로드용으로 메쉬를 인코딩한다.
+ * use_compact_vertices면 CompactVertex, 아니면 se::Vertex를 그대로 쓴다.
+ * 인덱스는 원본 뒤에 LOD 인덱스를 이어 붙여 한 버퍼(슬라이스)에 담고,
+ * 모든 섹션이 참조하는 정점 범위가 65536개 미만이면 16비트로 줄인다.
+ */
+EncodedMesh EncodeMeshForGpu(
+    const se::asset::StaticMesh& mesh, std::span<const MeshLod> lods, bool use_compact_vertices
+);
+
+/// EncodeMeshForGpu 결과를 GpuMeshData로 감싼다.
+GpuMeshData MakeGpuMeshData(
+    const se::asset::StaticMesh& mesh, std::span<const MeshLod> lods, bool use_compact_vertices
+);
+
+/// float -> IEEE half (반올림, 범위를 넘으면 inf)
+uint16 FloatToHalf(float value);
+
+/// 단위 벡터를 8면체 인코딩해 snorm16 두 개로 만든다.
+void EncodeOctahedralNormal(float x, float y, float z, int16 out_encoded[2]);
@@ -0,0 +1,46 @@
+﻿#include "MeshInstanceBatcher.h"
+
+
+void MeshInstanceBatcher::Reset()
+{
+    batch_lookup.clear();
+    batches.clear();
+    pending.clear();
+}
+
+void MeshInstanceBatcher::Add(const std::shared_ptr<LoadedMesh>& mesh, const se::Matrix4x4f& model, uint32 lod)
+{
+    auto [it, inserted] = batch_lookup.try_emplace({ mesh.get(), lod }, static_cast<uint32>(batches.size()));
+    if (inserted)
+    {
+        batches.push_back({ .mesh = mesh, .lod = lod });
+    }
+
+    ++batches[it->second].instance_count;
+    pending.push_back({ it->second, model });
+}
+
+void MeshInstanceBatcher::Build(std::vector<se::Matrix4x4f>& out_instances)
+{
+    const uint32 base = static_cast<uint32>(out_instances.size());
+    out_instances.resize(base + pending.size());
+
+    // 배치별 시작 위치 계산
+    std::vector<uint32> cursors;
+    cursors.reserve(batches.size());
+
+    uint32 offset = base;
+    for (MeshInstanceBatch& batch : batches)
+    {
+        batch.first_instance = offset;
+        cursors.push_back(offset);
+        offset += batch.instance_count;
+    }
+
+    // 메쉬별로 연속되도록 흩뿌리기
+    for (const auto& [batch_index, model] : pending)
+    {
+        out_instances[cursors[batch_index]++] = model;
+    }
+    pending.clear();
+}
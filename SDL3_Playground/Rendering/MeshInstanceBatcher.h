@@ -0,0 +1,66 @@
+﻿#pragma once
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+
+
+struct LoadedMesh;
+
+/// 같은 LoadedMesh, 같은 LOD를 공유하는 인스턴스들의 연속된 범위
+struct MeshInstanceBatch
+{
+    std::shared_ptr<LoadedMesh> mesh;
+    uint32 lod = 0;
+    uint32 first_instance = 0;
+    uint32 instance_count = 0;
+};
+
+/**
+ * 엔티티들을 (LoadedMesh, LOD) 기준으로 묶어 인스턴스 드로우 단위를 만든다.
+ *
+ * Add()로 모은 모델 행렬을 Build()에서 메쉬별로 연속되게 재배치하므로,
+ * 각 메쉬 섹션을 SDL_DrawGPUIndexedPrimitives 한 번으로 그릴 수 있다.
+ */
+class MeshInstanceBatcher
+{
+public:
+    void Reset();
+
+    void Add(const std::shared_ptr<LoadedMesh>& mesh, const se::Matrix4x4f& model, uint32 lod = 0);
+
+    /// 모인 인스턴스를 메쉬별로 정렬해 out_instances 뒤에 이어 붙이고 배치 범위를 확정한다.
+    void Build(std::vector<se::Matrix4x4f>& out_instances);
+
+    [[nodiscard]] std::span<const MeshInstanceBatch> GetBatches() const { return batches; }
+
+private:
+    struct PendingInstance
+    {
+        uint32 batch_index;
+        se::Matrix4x4f model;
+    };
+
+    struct BatchKey
+    {
+        const LoadedMesh* mesh;
+        uint32 lod;
+
+        bool operator==(const BatchKey&) const = default;
+    };
+
+    struct BatchKeyHash
+    {
+        size_t operator()(const BatchKey& key) const
+        {
+            return std::hash<const void*>{}(key.mesh) ^ (static_cast<size_t>(key.lod) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    std::unordered_map<BatchKey, uint32, BatchKeyHash> batch_lookup;
+    std::vector<MeshInstanceBatch> batches;
+    std::vector<PendingInstance> pending;
+};
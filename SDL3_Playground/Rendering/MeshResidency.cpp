@@ -0,0 +1,165 @@
+﻿#include "MeshResidency.h"
+
+#include <algorithm>
+
+#include "App.h"
+#include "tracy/Tracy.hpp"
+
+
+MeshResidency::MeshResidency(uint64 budget_bytes, uint32 min_unused_frames)
+    : budget_bytes(budget_bytes)
+    , min_unused_frames(min_unused_frames)
+{
+}
+
+void MeshResidency::SetMinUnusedFrames(uint32 frames, uint32 min_frames)
+{
+    min_unused_frames = std::max(frames, min_frames);
+}
+
+void MeshResidency::OnUploaded(const std::shared_ptr<LoadedMesh>& mesh, uint64 frame_index)
+{
+    if (mesh->residency == MeshResidencyState::Reloading)
+    {
+        RemoveEvicted(*mesh);
+        ++total_reloads;
+    }
+
+    mesh->residency = MeshResidencyState::Resident;
+    mesh->last_used_frame.store(frame_index, std::memory_order_relaxed);
+    resident_meshes.push_back({ .mesh = mesh, .gpu_bytes = mesh->gpu_bytes });
+    resident_bytes += mesh->gpu_bytes;
+}
+
+void MeshResidency::OnReloadFailed(LoadedMesh& mesh)
+{
+    RemoveEvicted(mesh);
+    mesh.residency = MeshResidencyState::Failed;
+}
+
+void MeshResidency::OnReleased(LoadedMesh& mesh)
+{
+    if (mesh.residency == MeshResidencyState::Resident)
+    {
+        const auto it = std::ranges::find_if(resident_meshes, [&mesh](const ResidentMesh& resident)
+        {
+            return resident.mesh.lock().get() == &mesh;
+        });
+        if (it != resident_meshes.end())
+        {
+            resident_bytes -= it->gpu_bytes;
+            *it = std::move(resident_meshes.back());
+            resident_meshes.pop_back();
+        }
+    }
+    else
+    {
+        RemoveEvicted(mesh);
+    }
+    mesh.residency = MeshResidencyState::Released;
+}
+
+void MeshResidency::Update(uint64 frame_index, const ReleaseFunc& release, std::vector<std::shared_ptr<LoadedMesh>>& out_reloads)
+{
+    ZoneScoped;
+
+    // 레지스트리에서 지운 메쉬는 OnReleased로 빠지지만, 그 밖에 사라진 메쉬가 있으면 목록과 바이트에서 뺀다
+    std::erase_if(resident_meshes, [this](const ResidentMesh& resident)
+    {
+        if (!resident.mesh.expired()) return false;
+        resident_bytes -= resident.gpu_bytes;
+        return true;
+    });
+    std::erase_if(evicted_meshes, [](const EvictedMesh& evicted) { return evicted.mesh.expired(); });
+
+    is_over_budget = false;
+    if (resident_bytes > budget_bytes)
+    {
+        EvictLeastRecentlyUsed(frame_index, release);
+    }
+
+    // 내린 뒤에 렌더 스레드가 그리려고 했으면 (last_used_frame이 갱신됐으면) 다시 올린다
+    for (const EvictedMesh& evicted : evicted_meshes)
+    {
+        const std::shared_ptr<LoadedMesh> mesh = evicted.mesh.lock();
+        if (mesh->residency == MeshResidencyState::Evicted
+            && mesh->last_used_frame.load(std::memory_order_relaxed) >= evicted.evicted_frame)
+        {
+            mesh->residency = MeshResidencyState::Reloading;
+            out_reloads.push_back(mesh);
+        }
+    }
+}
+
+MeshResidencyStats MeshResidency::GetStats() const
+{
+    MeshResidencyStats stats;
+    stats.budget_bytes = budget_bytes;
+    stats.resident_bytes = resident_bytes;
+    stats.num_resident = static_cast<uint32>(resident_meshes.size());
+    stats.num_evicted = static_cast<uint32>(evicted_meshes.size());
+    stats.num_reloading = static_cast<uint32>(std::ranges::count_if(evicted_meshes, [](const EvictedMesh& evicted)
+    {
+        const std::shared_ptr<LoadedMesh> mesh = evicted.mesh.lock();
+        return mesh && mesh->residency == MeshResidencyState::Reloading;
+    }));
+    stats.total_evictions = total_evictions;
+    stats.total_reloads = total_reloads;
+    stats.is_over_budget = is_over_budget;
+    return stats;
+}
+
+void MeshResidency::EvictLeastRecentlyUsed(uint64 frame_index, const ReleaseFunc& release)
+{
+    ZoneScoped;
+
+    struct Candidate
+    {
+        uint64 last_used_frame;
+        size_t index;
+    };
+
+    // 예산을 넘은 프레임에만 정렬하므로 따로 LRU 리스트를 유지하지 않는다
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < resident_meshes.size(); ++i)
+    {
+        const std::shared_ptr<LoadedMesh> mesh = resident_meshes[i].mesh.lock();
+        const uint64 last_used_frame = mesh->last_used_frame.load(std::memory_order_relaxed);
+        if (last_used_frame + min_unused_frames <= frame_index)
+        {
+            candidates.push_back({ last_used_frame, i });
+        }
+    }
+    std::ranges::sort(candidates, {}, &Candidate::last_used_frame);
+
+    for (const Candidate& candidate : candidates)
+    {
+        if (resident_bytes <= budget_bytes) break;
+
+        ResidentMesh& resident = resident_meshes[candidate.index];
+        const std::shared_ptr<LoadedMesh> mesh = resident.mesh.lock();
+        release(*mesh);
+        mesh->residency = MeshResidencyState::Evicted;
+        evicted_meshes.push_back({ .mesh = mesh, .evicted_frame = frame_index });
+
+        resident_bytes -= resident.gpu_bytes;
+        resident.mesh.reset();
+        ++total_evictions;
+    }
+    std::erase_if(resident_meshes, [](const ResidentMesh& resident) { return resident.mesh.expired(); });
+
+    is_over_budget = resident_bytes > budget_bytes;
+}
+
+void MeshResidency::RemoveEvicted(const LoadedMesh& mesh)
+{
+    const auto it = std::ranges::find_if(evicted_meshes, [&mesh](const EvictedMesh& evicted)
+    {
+        return evicted.mesh.lock().get() == &mesh;
+    });
+    if (it != evicted_meshes.end())
+    {
+        *it = std::move(evicted_meshes.back());
+        evicted_meshes.pop_back();
+    }
+}
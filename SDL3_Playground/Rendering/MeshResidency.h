@@ -0,0 +1,97 @@
+﻿#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+struct LoadedMesh;
+
+enum class MeshResidencyState : uint8
+{
+    Resident,  // GPU 슬라이스가 있다
+    Evicted,   // 예산 때문에 내려갔다. 다시 그려지면 올린다
+    Reloading, // 쿠킹 캐시 / 원본에서 다시 읽는 중
+    Failed,    // 다시 올리지 못했다. 더 이상 그리지 않는다
+    Released,  // 쓰는 엔티티가 없어 레지스트리에서 지웠다. 더 이상 그리지 않는다
+};
+
+struct MeshResidencyStats
+{
+    uint64 budget_bytes = 0;
+    uint64 resident_bytes = 0;
+    uint32 num_resident = 0;
+    uint32 num_evicted = 0;   // Evicted + Reloading
+    uint32 num_reloading = 0;
+    uint64 total_evictions = 0;
+    uint64 total_reloads = 0;
+    bool is_over_budget = false; // 내릴 수 있는 메쉬가 없어 예산을 넘은 채로 있다
+};
+
+/**
+ * 메쉬 GPU 슬라이스가 차지하는 메모리를 예산 안으로 유지한다.
+ *
+ * 렌더 스레드는 메쉬를 그릴 때 LoadedMesh::last_used_frame만 갱신하고, 메인 스레드가 프레임마다 Update를 부른다.
+ * 상주 바이트가 예산을 넘으면 min_unused_frames 이상 그려지지 않은 메쉬를 오래된 순서(LRU)로 내린다.
+ * 내려간 메쉬가 다시 그려지려고 하면(화면에 들어오면) 다시 올릴 목록으로 돌려준다.
+ *
+ * min_unused_frames는 Frames In Flight보다 크게 유지하므로, GPU가 아직 읽는 슬라이스는 내리지 않는다.
+ * 메쉬는 weak_ptr로만 들고 있어 레지스트리의 참조 수에 영향을 주지 않는다.
+ */
+class MeshResidency
+{
+public:
+    using ReleaseFunc = std::function<void(LoadedMesh&)>;
+
+    MeshResidency(uint64 budget_bytes, uint32 min_unused_frames);
+
+public:
+    void SetBudget(uint64 new_budget_bytes) { budget_bytes = new_budget_bytes; }
+    [[nodiscard]] uint64 GetBudget() const { return budget_bytes; }
+
+    /// min_frames보다 작게는 내려가지 않는다 (GPU가 읽고 있을 수 있는 프레임 수)
+    void SetMinUnusedFrames(uint32 frames, uint32 min_frames);
+    [[nodiscard]] uint32 GetMinUnusedFrames() const { return min_unused_frames; }
+
+    /// 처음 올렸거나 다시 올린 메쉬를 상주 목록에 넣는다. mesh->gpu_bytes가 채워져 있어야 한다.
+    void OnUploaded(const std::shared_ptr<LoadedMesh>& mesh, uint64 frame_index);
+
+    /// 다시 올리지 못한 메쉬. Failed가 되어 다시 요청하지 않는다.
+    void OnReloadFailed(LoadedMesh& mesh);
+
+    /// 레지스트리에서 지운 메쉬. 목록과 상주 바이트에서 빼고 Released가 된다. (슬라이스는 호출한 쪽이 내린다)
+    void OnReleased(LoadedMesh& mesh);
+
+    /// 예산을 넘었으면 release로 슬라이스를 내리고, 다시 그려진 메쉬를 Reloading으로 바꿔 out_reloads에 넣는다.
+    void Update(uint64 frame_index, const ReleaseFunc& release, std::vector<std::shared_ptr<LoadedMesh>>& out_reloads);
+
+    [[nodiscard]] MeshResidencyStats GetStats() const;
+
+private:
+    struct ResidentMesh
+    {
+        std::weak_ptr<LoadedMesh> mesh;
+        uint64 gpu_bytes = 0; // 메쉬가 먼저 사라져도 상주 바이트에서 뺄 수 있게 따로 둔다
+    };
+
+    struct EvictedMesh
+    {
+        std::weak_ptr<LoadedMesh> mesh;
+        uint64 evicted_frame = 0;
+    };
+
+    void EvictLeastRecentlyUsed(uint64 frame_index, const ReleaseFunc& release);
+    void RemoveEvicted(const LoadedMesh& mesh);
+
+private:
+    uint64 budget_bytes;
+    uint32 min_unused_frames;
+
+    std::vector<ResidentMesh> resident_meshes;
+    std::vector<EvictedMesh> evicted_meshes; // Evicted + Reloading
+    uint64 resident_bytes = 0;
+    uint64 total_evictions = 0;
+    uint64 total_reloads = 0;
+    bool is_over_budget = false;
+};
@@ -0,0 +1,111 @@
+﻿#include "RangeAllocator.h"
+
+#include <cassert>
+
+
+RangeAllocator::RangeAllocator(uint32 capacity)
+    : capacity(capacity)
+    , free_size(0)
+{
+    if (capacity > 0)
+    {
+        InsertFreeBlock(0, capacity);
+    }
+}
+
+std::optional<uint32> RangeAllocator::Allocate(uint32 size)
+{
+    if (size == 0) return std::nullopt;
+
+    const auto by_size = free_by_size.lower_bound(size);
+    if (by_size == free_by_size.end())
+    {
+        return std::nullopt;
+    }
+    return TakeFront(free_by_offset.find(by_size->second), size);
+}
+
+std::optional<uint32> RangeAllocator::AllocateLowest(uint32 size, uint32 limit)
+{
+    if (size == 0) return std::nullopt;
+
+    for (auto it = free_by_offset.begin(); it != free_by_offset.end() && it->first < limit; ++it)
+    {
+        if (it->second >= size && it->first + size <= limit)
+        {
+            return TakeFront(it, size);
+        }
+    }
+    return std::nullopt;
+}
+
+void RangeAllocator::Free(uint32 offset, uint32 size)
+{
+    if (size == 0) return;
+    assert(offset + size <= capacity);
+
+    // 뒤쪽 빈 구간과 합친다
+    auto next = free_by_offset.lower_bound(offset);
+    assert(next == free_by_offset.end() || next->first >= offset + size);
+    if (next != free_by_offset.end() && next->first == offset + size)
+    {
+        size += next->second;
+        EraseFreeBlock(next);
+    }
+
+    // 앞쪽 빈 구간과 합친다
+    auto prev = free_by_offset.lower_bound(offset);
+    if (prev != free_by_offset.begin())
+    {
+        --prev;
+        assert(prev->first + prev->second <= offset);
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            EraseFreeBlock(prev);
+        }
+    }
+
+    InsertFreeBlock(offset, size);
+}
+
+uint32 RangeAllocator::GetLargestFreeBlock() const
+{
+    return free_by_size.empty() ? 0 : free_by_size.rbegin()->first;
+}
+
+void RangeAllocator::InsertFreeBlock(uint32 offset, uint32 size)
+{
+    free_by_offset.emplace(offset, size);
+    free_by_size.emplace(size, offset);
+    free_size += size;
+}
+
+void RangeAllocator::EraseFreeBlock(std::map<uint32, uint32>::iterator it)
+{
+    // 같은 크기의 빈 구간이 여러 개일 수 있으므로 offset까지 맞는 항목을 지운다
+    auto [first, last] = free_by_size.equal_range(it->second);
+    for (auto by_size = first; by_size != last; ++by_size)
+    {
+        if (by_size->second == it->first)
+        {
+            free_by_size.erase(by_size);
+            break;
+        }
+    }
+    free_size -= it->second;
+    free_by_offset.erase(it);
+}
+
+uint32 RangeAllocator::TakeFront(std::map<uint32, uint32>::iterator it, uint32 size)
+{
+    const uint32 offset = it->first;
+    const uint32 remaining = it->second - size;
+    EraseFreeBlock(it);
+    if (remaining > 0)
+    {
+        InsertFreeBlock(offset + size, remaining);
+    }
+    return offset;
+}
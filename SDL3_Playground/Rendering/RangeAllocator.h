@@ -0,0 +1,46 @@
+﻿#pragma once
+#include <map>
+#include <optional>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/**
+ * [0, capacity) 구간을 나눠 주는 free-list 할당기. 단위(바이트, 정점 등)는 쓰는 쪽이 정한다.
+ *
+ * 빈 구간을 시작 위치 순(병합용)과 크기 순(best-fit용)으로 같이 들고 있어서 할당 / 해제가 O(log n)이다.
+ * 해제할 때 앞뒤의 빈 구간과 합친다. 할당된 구간의 크기는 기록하지 않으므로 Free에 같이 넘긴다.
+ */
+class RangeAllocator
+{
+public:
+    explicit RangeAllocator(uint32 capacity = 0);
+
+public:
+    /// 들어갈 수 있는 가장 작은 빈 구간에 할당한다. 자리가 없으면 nullopt
+    [[nodiscard]] std::optional<uint32> Allocate(uint32 size);
+
+    /// limit 이하에서 끝나는 가장 앞쪽 빈 구간에 할당한다. (조각 모음에서 뒤쪽 할당을 앞으로 당길 때)
+    [[nodiscard]] std::optional<uint32> AllocateLowest(uint32 size, uint32 limit);
+
+    void Free(uint32 offset, uint32 size);
+
+    [[nodiscard]] uint32 GetCapacity() const { return capacity; }
+    [[nodiscard]] uint32 GetFreeSize() const { return free_size; }
+    [[nodiscard]] uint32 GetUsedSize() const { return capacity - free_size; }
+    [[nodiscard]] uint32 GetLargestFreeBlock() const;
+    [[nodiscard]] uint32 GetNumFreeBlocks() const { return static_cast<uint32>(free_by_offset.size()); }
+
+private:
+    void InsertFreeBlock(uint32 offset, uint32 size);
+    void EraseFreeBlock(std::map<uint32, uint32>::iterator it);
+
+    /// 빈 구간 it의 앞쪽 size만큼을 떼어 쓴다.
+    uint32 TakeFront(std::map<uint32, uint32>::iterator it, uint32 size);
+
+private:
+    uint32 capacity;
+    uint32 free_size;
+    std::map<uint32, uint32> free_by_offset;    // offset -> size
+    std::multimap<uint32, uint32> free_by_size; // size -> offset
+};
@@ -0,0 +1,179 @@
+﻿#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+
+#include "tracy/Tracy.hpp"
+
+
+RenderTargetPool::RenderTargetPool(SDL_GPUDevice* device, uint32 max_free_targets, uint32 max_idle_frames)
+    : device(device)
+    , max_free_targets(max_free_targets)
+    , max_idle_frames(max_idle_frames)
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    ReleaseAll();
+}
+
+SDL_GPUTexture* RenderTargetPool::Acquire(uint32 owner, uint32 slot, const RenderTargetDesc& desc)
+{
+    if (desc.width == 0 || desc.height == 0)
+    {
+        return nullptr;
+    }
+
+    const uint64 key = MakeKey(owner, slot);
+    if (const auto it = active.find(key); it != active.end())
+    {
+        if (it->second.desc == desc)
+        {
+            it->second.last_used_frame = frame_index;
+            return it->second.texture;
+        }
+
+        // 크기나 포맷이 바뀌었으면 반납하고 다시 얻는다
+        Recycle(it->second);
+        active.erase(it);
+    }
+
+    Target target;
+    if (!TakeOrCreate(desc, target))
+    {
+        return nullptr;
+    }
+    target.last_used_frame = frame_index;
+    return active.emplace(key, target).first->second.texture;
+}
+
+void RenderTargetPool::ReleaseOwner(uint32 owner)
+{
+    for (auto it = active.begin(); it != active.end();)
+    {
+        if (static_cast<uint32>(it->first >> 32) == owner)
+        {
+            Recycle(it->second);
+            it = active.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void RenderTargetPool::EndFrame()
+{
+    ++frame_index;
+
+    std::erase_if(free_targets, [this](Target& target)
+    {
+        if (frame_index - target.last_used_frame <= max_idle_frames)
+        {
+            return false;
+        }
+        Destroy(target);
+        return true;
+    });
+}
+
+void RenderTargetPool::ReleaseAll()
+{
+    for (Target& target : active | std::views::values)
+    {
+        Destroy(target);
+    }
+    active.clear();
+
+    for (Target& target : free_targets)
+    {
+        Destroy(target);
+    }
+    free_targets.clear();
+}
+
+RenderTargetPoolStats RenderTargetPool::GetStats() const
+{
+    RenderTargetPoolStats stats;
+    stats.num_active = static_cast<uint32>(active.size());
+    stats.num_free = static_cast<uint32>(free_targets.size());
+    for (const Target& target : active | std::views::values)
+    {
+        stats.active_bytes += target.size_bytes;
+    }
+    for (const Target& target : free_targets)
+    {
+        stats.free_bytes += target.size_bytes;
+    }
+    stats.num_created = num_created;
+    stats.num_reused = num_reused;
+    return stats;
+}
+
+bool RenderTargetPool::TakeOrCreate(const RenderTargetDesc& desc, Target& out_target)
+{
+    // 최근에 반납된 것부터 찾는다
+    const auto it = std::find_if(free_targets.rbegin(), free_targets.rend(), [&](const Target& target)
+    {
+        return target.desc == desc;
+    });
+    if (it != free_targets.rend())
+    {
+        out_target = *it;
+        free_targets.erase(std::next(it).base());
+        ++num_reused;
+        return true;
+    }
+
+    ZoneScoped;
+
+    const SDL_GPUTextureCreateInfo info = {
+        .type = SDL_GPU_TEXTURETYPE_2D,
+        .format = desc.format,
+        .usage = desc.usage,
+        .width = desc.width,
+        .height = desc.height,
+        .layer_count_or_depth = 1,
+        .num_levels = 1,
+        .sample_count = SDL_GPU_SAMPLECOUNT_1,
+    };
+    SDL_GPUTexture* texture = SDL_CreateGPUTexture(device, &info);
+    if (!texture)
+    {
+        SDL_Log("RenderTargetPool: failed to create %ux%u target: %s", desc.width, desc.height, SDL_GetError());
+        return false;
+    }
+
+    out_target = {
+        .desc = desc,
+        .texture = texture,
+        .size_bytes = SDL_CalculateGPUTextureFormatSize(desc.format, desc.width, desc.height, 1),
+    };
+    ++num_created;
+    return true;
+}
+
+void RenderTargetPool::Recycle(Target target)
+{
+    target.last_used_frame = frame_index;
+    free_targets.push_back(target);
+
+    // 개수 제한을 넘으면 가장 오래된 것부터 해제
+    while (free_targets.size() > max_free_targets)
+    {
+        Destroy(free_targets.front());
+        free_targets.erase(free_targets.begin());
+    }
+}
+
+void RenderTargetPool::Destroy(Target& target)
+{
+    if (target.texture)
+    {
+        SDL_ReleaseGPUTexture(device, target.texture);
+        target.texture = nullptr;
+    }
+}
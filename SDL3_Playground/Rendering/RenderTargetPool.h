@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+struct RenderTargetDesc
+{
+    SDL_GPUTextureFormat format = SDL_GPU_TEXTUREFORMAT_INVALID;
+    SDL_GPUTextureUsageFlags usage = 0;
+    uint32 width = 0;
+    uint32 height = 0;
+
+    bool operator==(const RenderTargetDesc&) const = default;
+};
+
+struct RenderTargetPoolStats
+{
+    uint32 num_active = 0;
+    uint32 num_free = 0;
+    uint64 active_bytes = 0;
+    uint64 free_bytes = 0;
+    uint32 num_created = 0; // 누적
+    uint32 num_reused = 0;  // 누적, free 목록에서 다시 쓴 횟수
+};
+
+/**
+ * 윈도우(소유자)별 렌더 타겟을 포맷 / 크기 기준으로 관리하는 풀
+ *
+ * Acquire는 소유자의 슬롯에 맞는 타겟을 돌려주고, 크기나 포맷이 달라졌으면 기존 것을 반납한 뒤 다시 얻는다.
+ * 반납된 타겟은 같은 포맷 / 크기 요청에 재사용되며, 오래 쓰이지 않거나 개수 제한을 넘으면 해제된다.
+ * GPU가 아직 쓰는 중인 텍스처도 SDL_ReleaseGPUTexture는 사용이 끝난 뒤 해제하므로 바로 반납할 수 있다.
+ */
+class RenderTargetPool
+{
+public:
+    /// max_free_targets: 재사용을 위해 남겨둘 최대 개수, max_idle_frames: 이 프레임 수 동안 쓰이지 않으면 해제
+    explicit RenderTargetPool(SDL_GPUDevice* device, uint32 max_free_targets = 4, uint32 max_idle_frames = 120);
+    ~RenderTargetPool();
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+    RenderTargetPool(RenderTargetPool&&) = delete;
+    RenderTargetPool& operator=(RenderTargetPool&&) = delete;
+
+public:
+    /// owner의 slot에 desc와 맞는 타겟을 돌려준다. 실패하면 nullptr
+    SDL_GPUTexture* Acquire(uint32 owner, uint32 slot, const RenderTargetDesc& desc);
+
+    /// owner가 가진 타겟을 모두 free 목록으로 반납한다 (윈도우 크기 변경 / 닫힘).
+    void ReleaseOwner(uint32 owner);
+
+    /// 프레임 끝에서 호출. 오래 쓰이지 않은 free 타겟을 해제한다.
+    void EndFrame();
+
+    /// 모든 타겟을 해제한다.
+    void ReleaseAll();
+
+    [[nodiscard]] RenderTargetPoolStats GetStats() const;
+
+private:
+    struct Target
+    {
+        RenderTargetDesc desc;
+        SDL_GPUTexture* texture = nullptr;
+        uint64 size_bytes = 0;
+        uint64 last_used_frame = 0;
+    };
+
+    static uint64 MakeKey(uint32 owner, uint32 slot) { return (static_cast<uint64>(owner) << 32) | slot; }
+
+    /// free 목록에서 맞는 타겟을 꺼내거나 새로 만든다.
+    bool TakeOrCreate(const RenderTargetDesc& desc, Target& out_target);
+    void Recycle(Target target);
+    void Destroy(Target& target);
+
+private:
+    SDL_GPUDevice* device = nullptr;
+    uint32 max_free_targets = 0;
+    uint32 max_idle_frames = 0;
+    uint64 frame_index = 0;
+
+    std::unordered_map<uint64, Target> active; // (owner, slot) -> 타겟
+    std::vector<Target> free_targets;          // 오래된 것이 앞
+
+    uint32 num_created = 0;
+    uint32 num_reused = 0;
+};
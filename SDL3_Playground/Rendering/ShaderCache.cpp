@@ -0,0 +1,255 @@
+﻿#include "ShaderCache.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+#include "Asset/CacheFile.h"
+#include "Asset/ContentHash.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    constexpr uint32 CacheMagic = 0x43534553; // "SESC"
+    constexpr uint32 CacheVersion = 2;        // 저장 형식이나 키 구성이 바뀌면 올린다
+
+    struct CacheEntryHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 key;
+        uint32 format;
+        uint32 reserved;
+        uint64 size;
+        uint64 checksum;
+    };
+
+    /// HashBytes를 이어 붙여 여러 입력을 하나의 키로 해시한다.
+    struct KeyHasher
+    {
+        uint64 value = 0;
+
+        void Update(const void* data, size_t size)
+        {
+            value = HashBytes({ static_cast<const uint8*>(data), size }, value);
+        }
+
+        void Update(std::string_view text)
+        {
+            // 길이를 같이 넣어 "ab"+"c"와 "a"+"bc"가 같아지지 않게 한다
+            const uint64 length = text.size();
+            Update(&length, sizeof(length));
+            Update(text.data(), text.size());
+        }
+    };
+
+    bool ReadFile(const std::filesystem::path& path, std::string& out_text)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        out_text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    /// `#include "x"` / `#include <x>`의 파일 이름을 뽑는다.
+    void ParseIncludes(std::string_view source, std::vector<std::string>& out_includes)
+    {
+        size_t pos = 0;
+        while ((pos = source.find("#include", pos)) != std::string_view::npos)
+        {
+            pos += 8;
+            const size_t open = source.find_first_of("\"<\n", pos);
+            if (open == std::string_view::npos || source[open] == '\n') continue;
+
+            const char close_char = source[open] == '"' ? '"' : '>';
+            const size_t close = source.find_first_of(std::string{ close_char, '\n' }, open + 1);
+            if (close == std::string_view::npos || source[close] == '\n') continue;
+
+            out_includes.emplace_back(source.substr(open + 1, close - open - 1));
+            pos = close + 1;
+        }
+    }
+
+    /// 소스와 include된 파일들을 깊이 우선으로 해시한다.
+    bool HashSourceTree(
+        const std::filesystem::path& path, KeyHasher& hasher, std::unordered_set<std::string>& visited
+    )
+    {
+        std::error_code ec;
+        const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+        if (!visited.insert((ec ? path : canonical).generic_string()).second)
+        {
+            return true; // 이미 포함됨 (include guard / pragma once)
+        }
+
+        std::string text;
+        if (!ReadFile(path, text))
+        {
+            return false;
+        }
+        hasher.Update(path.filename().generic_string());
+        hasher.Update(text);
+
+        std::vector<std::string> includes;
+        ParseIncludes(text, includes);
+        for (const std::string& include : includes)
+        {
+            const std::filesystem::path include_path = path.parent_path() / include;
+            if (!HashSourceTree(include_path, hasher, visited))
+            {
+                // 찾을 수 없는 include는 이름만 반영 (어차피 컴파일에서 실패한다)
+                hasher.Update(include);
+            }
+        }
+        return true;
+    }
+
+    const char* GetFormatExtension(SDL_GPUShaderFormat format)
+    {
+        switch (format)
+        {
+        case SDL_GPU_SHADERFORMAT_SPIRV:    return "spv";
+        case SDL_GPU_SHADERFORMAT_DXIL:     return "dxil";
+        case SDL_GPU_SHADERFORMAT_DXBC:     return "dxbc";
+        case SDL_GPU_SHADERFORMAT_MSL:      return "msl";
+        case SDL_GPU_SHADERFORMAT_METALLIB: return "metallib";
+        default:                            return "bin";
+        }
+    }
+}
+
+ShaderCache::ShaderCache(std::filesystem::path cache_dir)
+    : cache_dir(std::move(cache_dir))
+{
+    std::error_code ec;
+    std::filesystem::create_directories(this->cache_dir, ec);
+}
+
+std::optional<uint64> ShaderCache::ComputeKey(const ShaderCacheKeyDesc& desc)
+{
+    ZoneScoped;
+    const uint64 start = SDL_GetPerformanceCounter();
+
+    KeyHasher hasher;
+    hasher.Update(&CacheVersion, sizeof(CacheVersion));
+
+    std::unordered_set<std::string> visited;
+    if (!HashSourceTree(desc.source_path, hasher, visited))
+    {
+        return std::nullopt;
+    }
+
+    // define은 순서와 무관하게 같은 키가 되도록 정렬
+    std::vector<std::string> defines = desc.defines;
+    std::ranges::sort(defines);
+    for (const std::string& define : defines)
+    {
+        hasher.Update(define);
+    }
+
+    hasher.Update(desc.entry_point);
+    hasher.Update(desc.stage);
+    hasher.Update(&desc.format, sizeof(desc.format));
+
+    std::lock_guard lock(stats_mutex);
+    stats.hash_seconds += SecondsSince(start);
+    return hasher.value;
+}
+
+std::optional<std::vector<uint8>> ShaderCache::Load(uint64 key, SDL_GPUShaderFormat format)
+{
+    ZoneScoped;
+    const uint64 start = SDL_GetPerformanceCounter();
+
+    std::optional<std::vector<uint8>> result;
+    bool is_corrupted = false;
+
+    const std::filesystem::path entry_path = MakeEntryPath(key, format);
+    if (std::ifstream file(entry_path, std::ios::binary); file)
+    {
+        CacheEntryHeader header = {};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        // 크기는 헤더 뒤에 실제로 남은 길이와 같아야 한다. 잘린 파일의 크기를 믿고 할당하지 않는다
+        std::error_code error;
+        const uintmax_t file_size = std::filesystem::file_size(entry_path, error);
+
+        const bool is_header_valid = file
+                                  && header.magic == CacheMagic
+                                  && header.version == CacheVersion
+                                  && header.key == key
+                                  && header.format == format
+                                  && !error
+                                  && file_size >= sizeof(header)
+                                  && header.size == file_size - sizeof(header);
+        if (is_header_valid)
+        {
+            std::vector<uint8> bytecode(header.size);
+            file.read(reinterpret_cast<char*>(bytecode.data()), static_cast<std::streamsize>(bytecode.size()));
+
+            if (file && HashBytes(bytecode) == header.checksum)
+            {
+                result = std::move(bytecode);
+            }
+        }
+        is_corrupted = !result.has_value();
+    }
+
+    std::lock_guard lock(stats_mutex);
+    stats.load_seconds += SecondsSince(start);
+    if (result)
+    {
+        ++stats.hits;
+    }
+    else
+    {
+        ++stats.misses;
+        stats.corrupted += is_corrupted ? 1 : 0;
+    }
+    return result;
+}
+
+void ShaderCache::Store(uint64 key, SDL_GPUShaderFormat format, const void* bytecode, size_t size)
+{
+    ZoneScoped;
+
+    const CacheEntryHeader header = {
+        .magic = CacheMagic,
+        .version = CacheVersion,
+        .key = key,
+        .format = format,
+        .reserved = 0,
+        .size = size,
+        .checksum = HashBytes({ static_cast<const uint8*>(bytecode), size }),
+    };
+
+    const bool is_written = WriteFileAtomically(MakeEntryPath(key, format), [&](std::ostream& file)
+    {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(bytecode), static_cast<std::streamsize>(size));
+    });
+    if (!is_written)
+    {
+        return;
+    }
+
+    std::lock_guard lock(stats_mutex);
+    ++stats.stores;
+}
+
+ShaderCacheStats ShaderCache::GetStats() const
+{
+    std::lock_guard lock(stats_mutex);
+    return stats;
+}
+
+std::filesystem::path ShaderCache::MakeEntryPath(uint64 key, SDL_GPUShaderFormat format) const
+{
+    return cache_dir / std::format("{:016x}.{}", key, GetFormatExtension(format));
+}
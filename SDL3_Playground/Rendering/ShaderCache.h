@@ -0,0 +1,62 @@
+﻿#pragma once
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/// 캐시 키를 만들 때 쓰는 셰이더 컴파일 입력
+struct ShaderCacheKeyDesc
+{
+    std::filesystem::path source_path;
+    std::string entry_point = "main";
+    std::vector<std::string> defines; // "NAME" 또는 "NAME=VALUE"
+    std::string stage;                // "vertex", "fragment", "compute"
+    SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
+};
+
+struct ShaderCacheStats
+{
+    uint32 hits = 0;
+    uint32 misses = 0;
+    uint32 stores = 0;
+    uint32 corrupted = 0;   // 헤더/체크섬이 맞지 않아 버린 항목
+    double hash_seconds = 0.0;
+    double load_seconds = 0.0;
+};
+
+/**
+ * 컴파일된 셰이더 바이트코드를 디스크에 저장해 두는 캐시
+ *
+ * 키는 소스, #include로 따라간 파일들의 내용, define, 엔트리 포인트, 스테이지, 포맷을 해시한 값이라
+ * 어느 하나라도 바뀌면 자연히 다른 항목이 된다. (무효화 처리가 따로 필요 없음)
+ * 여러 스레드에서 동시에 호출해도 된다.
+ */
+class ShaderCache
+{
+public:
+    explicit ShaderCache(std::filesystem::path cache_dir);
+
+public:
+    /// 키를 계산한다. 소스를 읽지 못하면 nullopt
+    [[nodiscard]] std::optional<uint64> ComputeKey(const ShaderCacheKeyDesc& desc);
+
+    [[nodiscard]] std::optional<std::vector<uint8>> Load(uint64 key, SDL_GPUShaderFormat format);
+    void Store(uint64 key, SDL_GPUShaderFormat format, const void* bytecode, size_t size);
+
+    [[nodiscard]] ShaderCacheStats GetStats() const;
+    [[nodiscard]] const std::filesystem::path& GetCacheDir() const { return cache_dir; }
+
+private:
+    [[nodiscard]] std::filesystem::path MakeEntryPath(uint64 key, SDL_GPUShaderFormat format) const;
+
+private:
+    std::filesystem::path cache_dir;
+
+    mutable std::mutex stats_mutex;
+    ShaderCacheStats stats;
+};
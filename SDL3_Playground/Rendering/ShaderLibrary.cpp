@@ -0,0 +1,257 @@
+﻿#include "ShaderLibrary.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    // 기록 파일 한 줄: stage \t format \t entry_point \t define1;define2 \t source_path
+    constexpr char RecordSeparator = '\t';
+    constexpr char DefineSeparator = ';';
+
+    std::string SerializeDesc(const ShaderCacheKeyDesc& desc)
+    {
+        std::string defines;
+        for (const std::string& define : desc.defines)
+        {
+            if (!defines.empty()) defines += DefineSeparator;
+            defines += define;
+        }
+
+        std::ostringstream line;
+        line << desc.stage << RecordSeparator
+             << desc.format << RecordSeparator
+             << desc.entry_point << RecordSeparator
+             << defines << RecordSeparator
+             << desc.source_path.generic_string();
+        return line.str();
+    }
+
+    bool DeserializeDesc(const std::string& line, ShaderCacheKeyDesc& out_desc)
+    {
+        std::istringstream stream(line);
+        std::string format, defines, source_path;
+        if (!std::getline(stream, out_desc.stage, RecordSeparator)
+            || !std::getline(stream, format, RecordSeparator)
+            || !std::getline(stream, out_desc.entry_point, RecordSeparator)
+            || !std::getline(stream, defines, RecordSeparator)
+            || !std::getline(stream, source_path))
+        {
+            return false;
+        }
+
+        uint32 format_value = 0;
+        const auto [end, error] = std::from_chars(format.data(), format.data() + format.size(), format_value);
+        if (error != std::errc{} || end != format.data() + format.size())
+        {
+            return false;
+        }
+
+        out_desc.format = static_cast<SDL_GPUShaderFormat>(format_value);
+        out_desc.source_path = source_path;
+
+        out_desc.defines.clear();
+        std::istringstream define_stream(defines);
+        for (std::string define; std::getline(define_stream, define, DefineSeparator);)
+        {
+            out_desc.defines.push_back(define);
+        }
+        return true;
+    }
+}
+
+ShaderLibrary::ShaderLibrary(ShaderCache& disk_cache, std::filesystem::path record_path)
+    : disk_cache(disk_cache)
+    , record_path(std::move(record_path))
+{
+}
+
+void ShaderLibrary::SetCompiler(CompileFunction compiler)
+{
+    std::lock_guard lock(mutex);
+    this->compiler = std::move(compiler);
+}
+
+ShaderBytecodePtr ShaderLibrary::GetOrCompile(const ShaderCacheKeyDesc& desc)
+{
+    ZoneScoped;
+
+    const std::optional<uint64> key = disk_cache.ComputeKey(desc);
+    if (!key)
+    {
+        // 소스를 읽을 수 없음: 공유하지 않고 컴파일러에 그대로 넘긴다 (오류 보고는 컴파일러 몫)
+        CompileFunction compile_function;
+        {
+            std::lock_guard lock(mutex);
+            compile_function = compiler;
+        }
+        return std::make_shared<const std::vector<uint8>>(compile_function ? compile_function(desc) : std::vector<uint8>{});
+    }
+
+    std::promise<ShaderBytecodePtr> promise;
+    {
+        std::unique_lock lock(mutex);
+        if (const auto it = modules.find(*key); it != modules.end())
+        {
+            ++stats.shared_hits;
+            const std::shared_future<ShaderBytecodePtr> module = it->second;
+
+            // 다른 스레드가 만드는 중이면 잠금을 풀고 기다린다
+            lock.unlock();
+            return module.get();
+        }
+
+        modules.emplace(*key, promise.get_future().share());
+        requested.emplace_back(*key, desc);
+        ++stats.unique_modules;
+    }
+
+    // 컴파일러가 던지면 약속이 값 없이 사라져 기다리던 요청이 모두 broken_promise를 받으므로 실패로 바꿔 넘긴다
+    ShaderBytecodePtr bytecode;
+    try
+    {
+        bytecode = Build(desc, *key);
+    }
+    catch (const std::exception& e)
+    {
+        SDL_Log("ShaderLibrary: failed to build %s: %s", desc.source_path.string().c_str(), e.what());
+        bytecode = std::make_shared<const std::vector<uint8>>();
+    }
+    catch (...)
+    {
+        SDL_Log("ShaderLibrary: failed to build %s", desc.source_path.string().c_str());
+        bytecode = std::make_shared<const std::vector<uint8>>();
+    }
+    promise.set_value(bytecode);
+
+    if (bytecode->empty())
+    {
+        // 실패한 결과는 남겨두지 않아 다음 요청에서 다시 시도하게 한다
+        std::lock_guard lock(mutex);
+        modules.erase(*key);
+        std::erase_if(requested, [&](const auto& entry) { return entry.first == *key; });
+        --stats.unique_modules;
+    }
+    return bytecode;
+}
+
+void ShaderLibrary::Prewarm(std::span<const ShaderCacheKeyDesc> descs)
+{
+    ZoneScoped;
+
+    if (descs.empty())
+    {
+        return;
+    }
+
+    const uint32 num_workers = std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<uint32>(descs.size()));
+
+    std::atomic<size_t> next_index = 0;
+    std::atomic<uint32> num_built = 0;
+    auto worker_main = [&]
+    {
+        for (size_t i = next_index++; i < descs.size(); i = next_index++)
+        {
+            if (!GetOrCompile(descs[i])->empty())
+            {
+                ++num_built;
+            }
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(num_workers - 1);
+    for (uint32 i = 1; i < num_workers; ++i)
+    {
+        workers.emplace_back(worker_main);
+    }
+    worker_main(); // 호출한 스레드도 같이 일한다
+    workers.clear();
+
+    std::lock_guard lock(mutex);
+    stats.prewarmed += num_built;
+}
+
+void ShaderLibrary::PrewarmRecorded()
+{
+    std::ifstream file(record_path);
+    if (!file)
+    {
+        return;
+    }
+
+    std::vector<ShaderCacheKeyDesc> descs;
+    uint32 line_number = 0;
+    for (std::string line; std::getline(file, line);)
+    {
+        ++line_number;
+        if (line.empty()) continue;
+
+        // 잘렸거나 손으로 고친 줄은 건너뛴다. 미리 만들지 못해도 처음 요청할 때 만들어진다
+        ShaderCacheKeyDesc desc;
+        if (!DeserializeDesc(line, desc))
+        {
+            SDL_Log("ShaderLibrary: skipping malformed record at %s:%u", record_path.string().c_str(), line_number);
+            continue;
+        }
+        descs.push_back(std::move(desc));
+    }
+    Prewarm(descs);
+}
+
+void ShaderLibrary::SaveRecorded() const
+{
+    std::vector<std::string> lines;
+    {
+        std::lock_guard lock(mutex);
+        lines.reserve(requested.size());
+        for (const ShaderCacheKeyDesc& desc : requested | std::views::values)
+        {
+            lines.push_back(SerializeDesc(desc));
+        }
+    }
+
+    std::ofstream file(record_path, std::ios::trunc);
+    for (const std::string& line : lines)
+    {
+        file << line << '\n';
+    }
+}
+
+ShaderLibraryStats ShaderLibrary::GetStats() const
+{
+    std::lock_guard lock(mutex);
+    return stats;
+}
+
+ShaderBytecodePtr ShaderLibrary::Build(const ShaderCacheKeyDesc& desc, uint64 key)
+{
+    if (std::optional<std::vector<uint8>> cached = disk_cache.Load(key, desc.format))
+    {
+        return std::make_shared<const std::vector<uint8>>(std::move(*cached));
+    }
+
+    CompileFunction compile_function;
+    {
+        std::lock_guard lock(mutex);
+        compile_function = compiler;
+        ++stats.compiled;
+    }
+
+    std::vector<uint8> bytecode = compile_function ? compile_function(desc) : std::vector<uint8>{};
+    if (!bytecode.empty())
+    {
+        disk_cache.Store(key, desc.format, bytecode.data(), bytecode.size());
+    }
+    return std::make_shared<const std::vector<uint8>>(std::move(bytecode));
+}
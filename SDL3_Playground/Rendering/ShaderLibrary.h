@@ -0,0 +1,73 @@
+﻿#pragma once
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+#include "ShaderCache.h"
+
+
+using ShaderBytecodePtr = std::shared_ptr<const std::vector<uint8>>;
+
+struct ShaderLibraryStats
+{
+    uint32 unique_modules = 0; // 이번 실행에서 만든 (디스크에서 읽었거나 컴파일한) 모듈 수
+    uint32 shared_hits = 0;    // 이미 만든 모듈을 다시 요청해 재사용한 횟수
+    uint32 compiled = 0;       // 디스크 캐시에도 없어 실제로 컴파일한 수
+    uint32 prewarmed = 0;      // Prewarm에서 준비된 요청 수 (공유된 것 포함)
+};
+
+/**
+ * 셰이더 모듈을 요청 해시(ShaderCache 키) 단위로 한 번만 만들어 공유하는 메모리 캐시
+ *
+ * 같은 소스를 쓰는 파이프라인이 여러 개여도 컴파일 / 디스크 읽기는 한 번만 일어난다.
+ * 동시에 같은 키를 요청하면 나중 요청은 먼저 시작한 작업의 결과를 기다린다.
+ * 요청된 키 설명은 기록해 두었다가 다음 실행 시작 때 워커 스레드에서 미리 만들 수 있다.
+ * 병렬로 도는 것은 키 해시와 디스크 캐시 읽기뿐이고, 캐시에 없어 컴파일하는 경우는 컴파일러가 한 번에 하나씩 처리한다.
+ */
+class ShaderLibrary
+{
+public:
+    using CompileFunction = std::function<std::vector<uint8>(const ShaderCacheKeyDesc&)>;
+
+    ShaderLibrary(ShaderCache& disk_cache, std::filesystem::path record_path);
+
+public:
+    /// 디스크 캐시에도 없을 때 사용할 컴파일 함수. 여러 스레드에서 동시에 불릴 수 있으므로 직렬화가 필요하면 함수 쪽에서 한다.
+    void SetCompiler(CompileFunction compiler);
+
+    /// 실패하면 빈 바이트코드를 가리키는 포인터를 반환한다.
+    ShaderBytecodePtr GetOrCompile(const ShaderCacheKeyDesc& desc);
+
+    /// descs를 워커 스레드에 나눠 만들고 모두 끝날 때까지 기다린다.
+    /// 디스크 캐시에 있는 모듈은 병렬로 읽히지만, 컴파일이 필요한 모듈은 컴파일러 함수의 직렬화를 따른다.
+    void Prewarm(std::span<const ShaderCacheKeyDesc> descs);
+
+    /// 지난 실행에서 기록해 둔 목록으로 Prewarm한다.
+    void PrewarmRecorded();
+
+    /// 이번 실행에서 요청된 목록을 기록한다.
+    void SaveRecorded() const;
+
+    [[nodiscard]] ShaderLibraryStats GetStats() const;
+
+private:
+    ShaderBytecodePtr Build(const ShaderCacheKeyDesc& desc, uint64 key);
+
+private:
+    ShaderCache& disk_cache;
+    std::filesystem::path record_path;
+    CompileFunction compiler;
+
+    mutable std::mutex mutex;
+    std::unordered_map<uint64, std::shared_future<ShaderBytecodePtr>> modules;
+    std::vector<std::pair<uint64, ShaderCacheKeyDesc>> requested; // 기록용, 키 기준 중복 없음
+    ShaderLibraryStats stats;
+};
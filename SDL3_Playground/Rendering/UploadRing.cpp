@@ -0,0 +1,254 @@
+﻿#include "UploadRing.h"
+
+#include <algorithm>
+
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    // 정점 / 인덱스 / 행렬 데이터 모두 만족하는 정렬
+    constexpr uint32 UploadAlignment = 16;
+}
+
+UploadRing::UploadRing(SDL_GPUDevice* device, uint32 capacity)
+    : device(device)
+{
+    const SDL_GPUTransferBufferCreateInfo transfer_info = {
+        .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        .size = capacity,
+    };
+    transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+    if (transfer_buffer)
+    {
+        this->capacity = capacity;
+    }
+}
+
+UploadRing::~UploadRing()
+{
+    WaitIdle();
+    if (transfer_buffer)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
+    }
+}
+
+bool UploadRing::UploadToBuffer(SDL_GPUBuffer* dst, uint32 dst_offset, const void* data, uint32 size)
+{
+    const auto* bytes = static_cast<const uint8*>(data);
+    if (size <= capacity)
+    {
+        return UploadChunk(dst, dst_offset, bytes, size);
+    }
+
+    // 조각마다 제출해 두면 링이 찼을 때 전부가 아니라 가장 오래된 조각만 기다리고,
+    // 그동안 GPU는 앞 조각을 복사하고 CPU는 다음 조각을 채운다
+    ZoneScopedN("UploadRing::SplitUpload");
+    const uint32 chunk_size = std::max((capacity / 4) & ~(UploadAlignment - 1), UploadAlignment);
+    for (uint32 uploaded = 0; uploaded < size;)
+    {
+        if (uploaded > 0)
+        {
+            Flush();
+        }
+
+        const uint32 size_to_upload = std::min(chunk_size, size - uploaded);
+        if (!UploadChunk(dst, dst_offset + uploaded, bytes + uploaded, size_to_upload))
+        {
+            return false;
+        }
+        uploaded += size_to_upload;
+    }
+    return true;
+}
+
+bool UploadRing::UploadChunk(SDL_GPUBuffer* dst, uint32 dst_offset, const uint8* data, uint32 size)
+{
+    if (size == 0)
+    {
+        return true;
+    }
+
+    uint32 offset;
+    if (!Allocate(size, offset))
+    {
+        return false;
+    }
+
+    // 사용 중인 구간은 건드리지 않으므로 cycle 없이 매핑한다
+    if (!mapped)
+    {
+        mapped = static_cast<uint8*>(SDL_MapGPUTransferBuffer(device, transfer_buffer, false));
+        if (!mapped)
+        {
+            return false;
+        }
+    }
+
+    SDL_memcpy(mapped + offset, data, size);
+    pending.push_back({ .src_buffer = nullptr, .dst = dst, .dst_offset = dst_offset, .src_offset = offset, .size = size });
+    return true;
+}
+
+void UploadRing::CopyBuffer(SDL_GPUBuffer* src, uint32 src_offset, SDL_GPUBuffer* dst, uint32 dst_offset, uint32 size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    pending.push_back({ .src_buffer = src, .dst = dst, .dst_offset = dst_offset, .src_offset = src_offset, .size = size });
+}
+
+SDL_GPUCommandBuffer* UploadRing::GetCommandBuffer()
+{
+    if (!command_buffer)
+    {
+        command_buffer = SDL_AcquireGPUCommandBuffer(device);
+    }
+    return command_buffer;
+}
+
+void UploadRing::Flush()
+{
+    ZoneScoped;
+
+    Retire(false);
+
+    if (pending.empty() && !command_buffer)
+    {
+        return;
+    }
+
+    if (mapped)
+    {
+        SDL_UnmapGPUTransferBuffer(device, transfer_buffer);
+        mapped = nullptr;
+    }
+
+    SDL_GPUCommandBuffer* cmd = GetCommandBuffer();
+    if (!pending.empty())
+    {
+        SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
+        for (const PendingCopy& copy : pending)
+        {
+            if (copy.src_buffer)
+            {
+                const SDL_GPUBufferLocation src = { .buffer = copy.src_buffer, .offset = copy.src_offset };
+                const SDL_GPUBufferLocation dst = { .buffer = copy.dst, .offset = copy.dst_offset };
+                SDL_CopyGPUBufferToBuffer(copy_pass, &src, &dst, copy.size, false);
+                continue;
+            }
+
+            const SDL_GPUTransferBufferLocation src = { .transfer_buffer = transfer_buffer, .offset = copy.src_offset };
+            const SDL_GPUBufferRegion dst = { .buffer = copy.dst, .offset = copy.dst_offset, .size = copy.size };
+            SDL_UploadToGPUBuffer(copy_pass, &src, &dst, false);
+        }
+        SDL_EndGPUCopyPass(copy_pass);
+        pending.clear();
+    }
+
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    command_buffer = nullptr;
+
+    if (frame_bytes > 0)
+    {
+        if (fence)
+        {
+            in_flight.push_back({ .fence = fence, .size = frame_bytes });
+        }
+        else
+        {
+            // 제출 실패: 펜스가 없으므로 GPU가 끝났다고 보고 바로 반환
+            used_bytes -= frame_bytes;
+        }
+        frame_bytes = 0;
+    }
+    else if (fence)
+    {
+        SDL_ReleaseGPUFence(device, fence);
+    }
+}
+
+void UploadRing::WaitIdle()
+{
+    if (command_buffer || !pending.empty())
+    {
+        Flush();
+    }
+
+    while (!in_flight.empty())
+    {
+        Retire(true);
+    }
+}
+
+bool UploadRing::Allocate(uint32 size, uint32& out_offset)
+{
+    if (size > capacity)
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        uint32 offset = (head + UploadAlignment - 1) & ~(UploadAlignment - 1);
+        uint32 padding = offset - head;
+        if (offset > capacity || size > capacity - offset)
+        {
+            // 끝에 남은 공간은 버리고 앞에서부터
+            padding = capacity - head;
+            offset = 0;
+        }
+
+        const uint64 required = static_cast<uint64>(used_bytes) + padding + size;
+        if (required <= capacity)
+        {
+            used_bytes += padding + size;
+            frame_bytes += padding + size;
+            head = offset + size;
+            out_offset = offset;
+            return true;
+        }
+
+        // 링이 가득 참: 이번 프레임 것까지 먼저 제출하고 가장 오래된 제출을 기다린다
+        ZoneScopedN("UploadRing::Stall");
+        ++num_stalls;
+        if (!pending.empty())
+        {
+            Flush();
+        }
+        if (in_flight.empty())
+        {
+            return false;
+        }
+        Retire(true);
+    }
+}
+
+void UploadRing::Retire(bool wait_oldest)
+{
+    while (!in_flight.empty())
+    {
+        const Submission& oldest = in_flight.front();
+        if (!SDL_QueryGPUFence(device, oldest.fence))
+        {
+            if (!wait_oldest)
+            {
+                break;
+            }
+            SDL_WaitForGPUFences(device, true, &oldest.fence, 1);
+        }
+        wait_oldest = false;
+
+        SDL_ReleaseGPUFence(device, oldest.fence);
+        used_bytes -= oldest.size;
+        in_flight.pop_front();
+    }
+
+    if (used_bytes == 0)
+    {
+        // 비어 있으면 처음부터 써서 끝에서 버려지는 공간을 줄인다
+        head = 0;
+    }
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+#include <deque>
+#include <vector>
+
+#include "SDL3/SDL.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/**
+ * 프레임 간에 재사용하는 업로드용 링 버퍼 (Transfer Buffer 하나)
+ *
+ * 한 프레임 동안 스테이징한 데이터는 Flush에서 하나의 Copy Pass / Command Buffer로 제출되고,
+ * 제출마다 받은 펜스가 신호되면 그 구간을 다시 쓴다.
+ * 링이 가득 차면 가장 오래된 제출의 펜스를 기다린다 (back-pressure).
+ * 링보다 큰 업로드는 조각으로 나눠 조각마다 제출하므로, 링 크기와 상관없이 올릴 수 있다.
+ */
+class UploadRing
+{
+public:
+    UploadRing(SDL_GPUDevice* device, uint32 capacity);
+    ~UploadRing();
+
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+    UploadRing(UploadRing&&) = delete;
+    UploadRing& operator=(UploadRing&&) = delete;
+
+public:
+    /// data를 링에 복사하고 dst로의 복사를 이번 프레임 Copy Pass에 예약한다.
+    /// size가 링 용량보다 크면 용량의 1/4 조각으로 나누고, 조각 사이마다 그때까지 예약된 복사를 제출한다.
+    bool UploadToBuffer(SDL_GPUBuffer* dst, uint32 dst_offset, const void* data, uint32 size);
+
+    /// GPU 버퍼 사이의 복사를 이번 프레임 Copy Pass에 예약한다. 업로드와 예약한 순서대로 기록된다.
+    /// 같은 버퍼 안에서 옮길 때는 두 구간이 겹치면 안 된다.
+    void CopyBuffer(SDL_GPUBuffer* src, uint32 src_offset, SDL_GPUBuffer* dst, uint32 dst_offset, uint32 size);
+
+    /// 이번 프레임 업로드를 기록할 Command Buffer. 링을 거치지 않는 업로드도 여기에 기록하면 같이 제출된다.
+    SDL_GPUCommandBuffer* GetCommandBuffer();
+
+    /// 예약된 복사를 기록하고 Command Buffer를 제출한다. 프레임마다 한 번 호출한다.
+    void Flush();
+
+    /// 제출한 모든 업로드가 끝날 때까지 기다린다.
+    void WaitIdle();
+
+    [[nodiscard]] uint32 GetCapacity() const { return capacity; }
+    [[nodiscard]] uint32 GetUsedBytes() const { return used_bytes; }
+    [[nodiscard]] uint32 GetNumInFlight() const { return static_cast<uint32>(in_flight.size()); }
+    [[nodiscard]] uint64 GetNumStalls() const { return num_stalls; }
+
+private:
+    struct PendingCopy
+    {
+        SDL_GPUBuffer* src_buffer; // nullptr이면 링(Transfer Buffer)의 src_offset에서 올린다
+        SDL_GPUBuffer* dst;
+        uint32 dst_offset;
+        uint32 src_offset;
+        uint32 size;
+    };
+
+    struct Submission
+    {
+        SDL_GPUFence* fence;
+        uint32 size; // 패딩 포함, 이 제출이 차지한 링 바이트 수
+    };
+
+    /// 링 용량 이하의 조각 하나를 링에 복사하고 예약한다.
+    bool UploadChunk(SDL_GPUBuffer* dst, uint32 dst_offset, const uint8* data, uint32 size);
+
+    /// size 바이트를 연속으로 쓸 수 있는 위치를 찾는다. 필요하면 이전 제출을 기다린다.
+    bool Allocate(uint32 size, uint32& out_offset);
+
+    /// 끝난 제출의 구간을 반환한다. wait_oldest면 가장 오래된 제출 하나는 기다려서라도 반환한다.
+    void Retire(bool wait_oldest);
+
+private:
+    SDL_GPUDevice* device = nullptr;
+    SDL_GPUTransferBuffer* transfer_buffer = nullptr;
+    uint8* mapped = nullptr;
+    uint32 capacity = 0;
+
+    uint32 head = 0;       // 다음에 쓸 위치
+    uint32 used_bytes = 0; // 아직 GPU가 읽을 수 있는 바이트 (이번 프레임 포함)
+    uint32 frame_bytes = 0;
+
+    SDL_GPUCommandBuffer* command_buffer = nullptr;
+    std::vector<PendingCopy> pending;
+    std::deque<Submission> in_flight;
+
+    uint64 num_stalls = 0;
+};
@@ -0,0 +1,388 @@
+﻿#include "DynamicAabbTree.h"
+
+#include <cassert>
+#include <utility>
+
+using namespace se;
+using namespace se::ecs;
+
+
+int32 DynamicAabbTree::CreateProxy(const AABB& bounds, Entity entity)
+{
+    const int32 proxy_id = AllocateNode();
+
+    Node& node = nodes[proxy_id];
+    node.bounds = MakeFatBounds(bounds);
+    node.entity = entity;
+    node.height = 0;
+
+    InsertLeaf(proxy_id);
+    ++proxy_count;
+    return proxy_id;
+}
+
+void DynamicAabbTree::DestroyProxy(int32 proxy_id)
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<int32>(nodes.size()));
+    assert(nodes[proxy_id].IsLeaf());
+
+    RemoveLeaf(proxy_id);
+    FreeNode(proxy_id);
+    --proxy_count;
+}
+
+bool DynamicAabbTree::MoveProxy(int32 proxy_id, const AABB& bounds)
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<int32>(nodes.size()));
+    assert(nodes[proxy_id].IsLeaf());
+
+    if (Contains(nodes[proxy_id].bounds, bounds))
+    {
+        // 바운드가 많이 줄어든 경우에도 다시 삽입해 fat AABB가 너무 커지지 않게 한다
+        const Bounds fat = MakeFatBounds(bounds);
+        const Bounds& current = nodes[proxy_id].bounds;
+        if (SurfaceArea(current) <= SurfaceArea(fat) * 2.0)
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy_id);
+    nodes[proxy_id].bounds = MakeFatBounds(bounds);
+    InsertLeaf(proxy_id);
+    return true;
+}
+
+int32 DynamicAabbTree::AllocateNode()
+{
+    if (free_list == NullNode)
+    {
+        nodes.emplace_back();
+        return static_cast<int32>(nodes.size() - 1);
+    }
+
+    const int32 node_id = free_list;
+    free_list = nodes[node_id].parent;
+    nodes[node_id] = Node{};
+    return node_id;
+}
+
+void DynamicAabbTree::FreeNode(int32 node_id)
+{
+    Node& node = nodes[node_id];
+    node = Node{};
+    node.parent = free_list;
+    free_list = node_id;
+}
+
+void DynamicAabbTree::InsertLeaf(int32 leaf)
+{
+    if (root == NullNode)
+    {
+        root = leaf;
+        nodes[root].parent = NullNode;
+        return;
+    }
+
+    // 표면적 비용이 가장 작은 형제를 찾는다
+    const Bounds leaf_bounds = nodes[leaf].bounds;
+    int32 index = root;
+    while (!nodes[index].IsLeaf())
+    {
+        const Node& node = nodes[index];
+        const int32 child1 = node.child1;
+        const int32 child2 = node.child2;
+
+        const double area = SurfaceArea(node.bounds);
+        const double combined_area = SurfaceArea(Union(node.bounds, leaf_bounds));
+
+        // 여기서 새 부모를 만드는 비용
+        const double cost = 2.0 * combined_area;
+
+        // 더 내려갈 때 조상들이 커지는 비용
+        const double inheritance_cost = 2.0 * (combined_area - area);
+
+        auto descend_cost = [&](int32 child)
+        {
+            const Node& child_node = nodes[child];
+            const double union_area = SurfaceArea(Union(leaf_bounds, child_node.bounds));
+            if (child_node.IsLeaf())
+            {
+                return union_area + inheritance_cost;
+            }
+            return union_area - SurfaceArea(child_node.bounds) + inheritance_cost;
+        };
+
+        const double cost1 = descend_cost(child1);
+        const double cost2 = descend_cost(child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    const int32 sibling = index;
+
+    // 형제와 리프를 묶는 새 부모 생성 (AllocateNode가 nodes를 재할당할 수 있으므로 인덱스로 접근)
+    const int32 old_parent = nodes[sibling].parent;
+    const int32 new_parent = AllocateNode();
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].bounds = Union(leaf_bounds, nodes[sibling].bounds);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].child1 = sibling;
+    nodes[new_parent].child2 = leaf;
+
+    if (old_parent != NullNode)
+    {
+        if (nodes[old_parent].child1 == sibling)
+        {
+            nodes[old_parent].child1 = new_parent;
+        }
+        else
+        {
+            nodes[old_parent].child2 = new_parent;
+        }
+    }
+    else
+    {
+        root = new_parent;
+    }
+
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    Refit(nodes[leaf].parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(int32 leaf)
+{
+    if (leaf == root)
+    {
+        root = NullNode;
+        return;
+    }
+
+    const int32 parent = nodes[leaf].parent;
+    const int32 grand_parent = nodes[parent].parent;
+    const int32 sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grand_parent != NullNode)
+    {
+        // 부모를 없애고 형제를 조부모에 바로 연결
+        if (nodes[grand_parent].child1 == parent)
+        {
+            nodes[grand_parent].child1 = sibling;
+        }
+        else
+        {
+            nodes[grand_parent].child2 = sibling;
+        }
+        nodes[sibling].parent = grand_parent;
+        FreeNode(parent);
+
+        Refit(grand_parent);
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = NullNode;
+        FreeNode(parent);
+    }
+
+    nodes[leaf].parent = NullNode;
+}
+
+void DynamicAabbTree::Refit(int32 node_id)
+{
+    int32 index = node_id;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.bounds = Union(child1.bounds, child2.bounds);
+
+        index = node.parent;
+    }
+}
+
+int32 DynamicAabbTree::Balance(int32 node_id)
+{
+    const int32 ia = node_id;
+    Node& a = nodes[ia];
+    if (a.IsLeaf() || a.height < 2)
+    {
+        return ia;
+    }
+
+    const int32 ib = a.child1;
+    const int32 ic = a.child2;
+    Node& b = nodes[ib];
+    Node& c = nodes[ic];
+
+    const int32 balance = c.height - b.height;
+
+    // 부모의 자식 포인터를 교체
+    auto replace_child = [this](int32 parent, int32 old_child, int32 new_child)
+    {
+        if (parent == NullNode)
+        {
+            root = new_child;
+        }
+        else if (nodes[parent].child1 == old_child)
+        {
+            nodes[parent].child1 = new_child;
+        }
+        else
+        {
+            nodes[parent].child2 = new_child;
+        }
+    };
+
+    // C를 위로 회전
+    if (balance > 1)
+    {
+        const int32 i_f = c.child1;
+        const int32 i_g = c.child2;
+        Node& f = nodes[i_f];
+        Node& g = nodes[i_g];
+
+        c.child1 = ia;
+        c.parent = a.parent;
+        a.parent = ic;
+        replace_child(c.parent, ia, ic);
+
+        if (f.height > g.height)
+        {
+            c.child2 = i_f;
+            a.child2 = i_g;
+            g.parent = ia;
+            a.bounds = Union(b.bounds, g.bounds);
+            c.bounds = Union(a.bounds, f.bounds);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else
+        {
+            c.child2 = i_g;
+            a.child2 = i_f;
+            f.parent = ia;
+            a.bounds = Union(b.bounds, f.bounds);
+            c.bounds = Union(a.bounds, g.bounds);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return ic;
+    }
+
+    // B를 위로 회전
+    if (balance < -1)
+    {
+        const int32 i_d = b.child1;
+        const int32 i_e = b.child2;
+        Node& d = nodes[i_d];
+        Node& e = nodes[i_e];
+
+        b.child1 = ia;
+        b.parent = a.parent;
+        a.parent = ib;
+        replace_child(b.parent, ia, ib);
+
+        if (d.height > e.height)
+        {
+            b.child2 = i_d;
+            a.child1 = i_e;
+            e.parent = ia;
+            a.bounds = Union(c.bounds, e.bounds);
+            b.bounds = Union(a.bounds, d.bounds);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else
+        {
+            b.child2 = i_e;
+            a.child1 = i_d;
+            d.parent = ia;
+            a.bounds = Union(c.bounds, d.bounds);
+            b.bounds = Union(a.bounds, e.bounds);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return ib;
+    }
+
+    return ia;
+}
+
+DynamicAabbTree::Bounds DynamicAabbTree::MakeFatBounds(const AABB& bounds)
+{
+    const double min[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+    const double max[3] = { bounds.max.x, bounds.max.y, bounds.max.z };
+
+    // 크기에 비례한 여유 + 아주 작은 물체를 위한 최소 여유
+    const double largest_extent = std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2] });
+    const double margin = largest_extent * 0.1 + 0.01;
+
+    Bounds result;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        result.min[axis] = min[axis] - margin;
+        result.max[axis] = max[axis] + margin;
+    }
+    return result;
+}
+
+bool DynamicAabbTree::Contains(const Bounds& outer, const AABB& inner)
+{
+    return outer.min[0] <= inner.min.x && outer.min[1] <= inner.min.y && outer.min[2] <= inner.min.z
+        && inner.max.x <= outer.max[0] && inner.max.y <= outer.max[1] && inner.max.z <= outer.max[2];
+}
+
+DynamicAabbTree::Bounds DynamicAabbTree::Union(const Bounds& a, const Bounds& b)
+{
+    Bounds result;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        result.min[axis] = std::min(a.min[axis], b.min[axis]);
+        result.max[axis] = std::max(a.max[axis], b.max[axis]);
+    }
+    return result;
+}
+
+double DynamicAabbTree::SurfaceArea(const Bounds& bounds)
+{
+    const double wx = bounds.max[0] - bounds.min[0];
+    const double wy = bounds.max[1] - bounds.min[1];
+    const double wz = bounds.max[2] - bounds.min[2];
+    return 2.0 * (wx * wy + wy * wz + wz * wx);
+}
+
+bool DynamicAabbTree::IntersectRay(const Bounds& bounds, const double (&origin)[3], const double (&inv_dir)[3], double max_distance)
+{
+    double t_min = 0.0;
+    double t_max = max_distance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        double t1 = (bounds.min[axis] - origin[axis]) * inv_dir[axis];
+        double t2 = (bounds.max[axis] - origin[axis]) * inv_dir[axis];
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+        }
+
+        // 0 * inf로 생기는 NaN은 비교에서 무시된다 (해당 축 제약 없음)
+        t_min = t1 > t_min ? t1 : t_min;
+        t_max = t2 < t_max ? t2 : t_max;
+        if (t_min > t_max)
+        {
+            return false;
+        }
+    }
+    return true;
+}
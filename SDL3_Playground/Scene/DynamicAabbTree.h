@@ -0,0 +1,124 @@
+﻿#pragma once
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+#include "SimpleEngine/Core/Math/Ray.h"
+#include "SimpleEngine/ECS/World.h"
+
+
+/**
+ * 월드 공간 AABB에 대한 동적 BVH (Box2D의 b2DynamicTree 방식)
+ *
+ * 각 프록시는 실제 바운드보다 조금 넓은(fat) AABB를 가지므로,
+ * 작은 이동은 MoveProxy에서 트리를 건드리지 않고 넘어간다.
+ * 삽입은 표면적 비용으로 형제를 고르고, 회전으로 높이 균형을 유지한다.
+ */
+class DynamicAabbTree
+{
+public:
+    static constexpr int32 NullNode = -1;
+
+    struct Bounds
+    {
+        double min[3];
+        double max[3];
+    };
+
+public:
+    /// bounds를 감싸는 프록시를 만들고 id를 반환한다.
+    int32 CreateProxy(const se::AABB& bounds, se::ecs::Entity entity);
+    void DestroyProxy(int32 proxy_id);
+
+    /// 새 바운드가 기존 fat AABB를 벗어날 때만 다시 삽입한다. 다시 삽입했으면 true
+    bool MoveProxy(int32 proxy_id, const se::AABB& bounds);
+
+    [[nodiscard]] se::ecs::Entity GetEntity(int32 proxy_id) const { return nodes[proxy_id].entity; }
+    [[nodiscard]] int32 GetHeight() const { return root == NullNode ? 0 : nodes[root].height; }
+    [[nodiscard]] uint32 GetProxyCount() const { return proxy_count; }
+
+    /**
+     * ray와 만나는 프록시를 가까운 순서와 무관하게 방문한다.
+     * callback(entity, max_distance)는 정밀 판정 후 새 최대 거리를 반환한다.
+     * 맞지 않았으면 max_distance를 그대로, 맞았으면 그 거리를 반환하면 더 먼 노드는 건너뛴다.
+     */
+    template <typename Callback>
+    void RayCast(const se::Ray& ray, double max_distance, Callback&& callback) const;
+
+private:
+    struct Node
+    {
+        Bounds bounds;
+        se::ecs::Entity entity;
+
+        int32 parent = NullNode; // 해제된 노드에서는 다음 빈 노드
+        int32 child1 = NullNode;
+        int32 child2 = NullNode;
+        int32 height = -1;       // 리프는 0, 해제된 노드는 -1
+
+        [[nodiscard]] bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+    int32 AllocateNode();
+    void FreeNode(int32 node_id);
+
+    void InsertLeaf(int32 leaf);
+    void RemoveLeaf(int32 leaf);
+    int32 Balance(int32 node_id);
+
+    /// 노드부터 루트까지 균형을 맞추며 높이와 AABB를 다시 계산한다.
+    void Refit(int32 node_id);
+
+    static Bounds MakeFatBounds(const se::AABB& bounds);
+    static bool Contains(const Bounds& outer, const se::AABB& inner);
+    static Bounds Union(const Bounds& a, const Bounds& b);
+    static double SurfaceArea(const Bounds& bounds);
+    static bool IntersectRay(const Bounds& bounds, const double (&origin)[3], const double (&inv_dir)[3], double max_distance);
+
+private:
+    std::vector<Node> nodes;
+    int32 root = NullNode;
+    int32 free_list = NullNode;
+    uint32 proxy_count = 0;
+
+    mutable std::vector<int32> traversal_stack;
+};
+
+template <typename Callback>
+void DynamicAabbTree::RayCast(const se::Ray& ray, double max_distance, Callback&& callback) const
+{
+    if (root == NullNode)
+    {
+        return;
+    }
+
+    const double origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+    const double inv_dir[3] = { 1.0 / ray.direction.x, 1.0 / ray.direction.y, 1.0 / ray.direction.z };
+
+    traversal_stack.clear();
+    traversal_stack.push_back(root);
+
+    while (!traversal_stack.empty())
+    {
+        const int32 node_id = traversal_stack.back();
+        traversal_stack.pop_back();
+
+        const Node& node = nodes[node_id];
+        if (!IntersectRay(node.bounds, origin, inv_dir, max_distance))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            max_distance = std::min(max_distance, static_cast<double>(callback(node.entity, max_distance)));
+        }
+        else
+        {
+            traversal_stack.push_back(node.child1);
+            traversal_stack.push_back(node.child2);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+﻿#include "EntityList.h"
+
+#include <utility>
+
+#include "tracy/Tracy.hpp"
+
+using namespace se::ecs;
+
+
+void EntityList::Sync(World& world)
+{
+    if (!is_dirty) return;
+
+    ZoneScoped;
+
+    // 이전 목록의 위치는 새 엔티티를 가려내는 데만 쓴다
+    se::Array<Entity> previous_entities = std::move(entities);
+    std::swap(index_by_id, previous_index_by_id);
+
+    entities = world.GetAliveEntities();
+    is_dirty = false;
+
+    index_by_id.assign(previous_index_by_id.size(), InvalidIndex);
+    for (uint32 i = 0; i < entities.Len(); ++i)
+    {
+        const Entity entity = entities[i];
+        const uint32 id = entity.GetId();
+        if (id >= index_by_id.size())
+        {
+            index_by_id.resize(id + 1, InvalidIndex);
+        }
+        index_by_id[id] = i;
+
+        // 같은 id라도 세대가 다르면 지운 뒤 새로 만든 엔티티
+        const uint32 previous_index = id < previous_index_by_id.size() ? previous_index_by_id[id] : InvalidIndex;
+        if (previous_index == InvalidIndex || previous_entities[previous_index] != entity)
+        {
+            spawned_entities.push_back(entity);
+        }
+    }
+}
+
+std::optional<uint32> EntityList::FindIndex(Entity entity) const
+{
+    if (!entity.IsValid()) return std::nullopt;
+
+    const uint32 id = entity.GetId();
+    if (id >= index_by_id.size() || index_by_id[id] == InvalidIndex)
+    {
+        return std::nullopt;
+    }
+
+    // 같은 id를 새 세대가 쓰고 있을 수 있으므로 엔티티까지 비교
+    const uint32 index = index_by_id[id];
+    if (entities[index] != entity)
+    {
+        return std::nullopt;
+    }
+    return index;
+}
@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/Container/Array.h"
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/ECS/World.h"
+
+
+/**
+ * World의 살아 있는 엔티티를 UI에서 읽기 위한 목록
+ *
+ * World::GetAliveEntities는 부를 때마다 배열을 새로 만드므로, 엔티티를 만들거나 지운 뒤(MarkDirty)에만 다시 받는다.
+ * 엔티티 id로 목록 위치를 바로 찾을 수 있어, 선택 핸들이 아직 살아 있는지 훑지 않고 확인한다.
+ * 다시 받을 때 이전 목록에 없던 엔티티를 모아 두므로, 만든 쪽이 핸들을 몰라도 새 엔티티만 따로 처리할 수 있다.
+ */
+class EntityList
+{
+public:
+    /// 엔티티를 만들거나 지웠을 때 호출한다. 다음 Sync에서 다시 받는다.
+    void MarkDirty() { is_dirty = true; }
+
+    void Sync(se::ecs::World& world);
+
+    /// 같은 id, 같은 세대의 엔티티가 목록에 있으면 그 위치
+    [[nodiscard]] std::optional<uint32> FindIndex(se::ecs::Entity entity) const;
+    [[nodiscard]] bool Contains(se::ecs::Entity entity) const { return FindIndex(entity).has_value(); }
+
+    [[nodiscard]] uint32 Len() const { return static_cast<uint32>(entities.Len()); }
+
+    /// 지금까지 본 가장 큰 엔티티 id + 1. 지운 id를 다시 쓰거나 그 뒤로 이어지므로, n개를 더 만들어도 id는 이 값 + n보다 작다.
+    [[nodiscard]] uint32 GetIdBound() const { return static_cast<uint32>(index_by_id.size()); }
+    [[nodiscard]] se::ecs::Entity operator[](uint32 index) const { return entities[index]; }
+
+    /// 마지막 ClearSpawnedEntities 뒤로 Sync에서 처음 본 엔티티. 그 사이에 지워진 엔티티가 섞여 있을 수 있으므로 Contains로 확인한다.
+    [[nodiscard]] std::span<const se::ecs::Entity> GetSpawnedEntities() const { return spawned_entities; }
+    void ClearSpawnedEntities() { spawned_entities.clear(); }
+
+private:
+    static constexpr uint32 InvalidIndex = ~0u;
+
+    se::Array<se::ecs::Entity> entities;
+    std::vector<uint32> index_by_id; // 엔티티 id -> entities 위치
+    std::vector<uint32> previous_index_by_id; // Sync 중 이전 목록과 비교할 때 쓰는 스크래치
+    std::vector<se::ecs::Entity> spawned_entities;
+    bool is_dirty = true;
+};
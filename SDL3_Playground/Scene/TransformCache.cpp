@@ -0,0 +1,323 @@
+﻿#include "TransformCache.h"
+
+#include <cmath>
+
+#include "App.h"
+#include "SimpleEngine/Asset/Types/MeshTypes.h"
+#include "SimpleEngine/ECS/Components/TransformComponent.h"
+#include "tracy/Tracy.hpp"
+
+using namespace se;
+using namespace se::ecs;
+
+
+namespace
+{
+    /// 로컬 AABB를 월드 공간으로 변환한 AABB (중심/반경 방식)
+    AABB TransformBounds(const AABBf& local, const Matrix4x4& world)
+    {
+        const double* m = world.GetData();
+
+        const double center[3] = {
+            (static_cast<double>(local.min.x) + local.max.x) * 0.5,
+            (static_cast<double>(local.min.y) + local.max.y) * 0.5,
+            (static_cast<double>(local.min.z) + local.max.z) * 0.5,
+        };
+        const double extent[3] = {
+            (static_cast<double>(local.max.x) - local.min.x) * 0.5,
+            (static_cast<double>(local.max.y) - local.min.y) * 0.5,
+            (static_cast<double>(local.max.z) - local.min.z) * 0.5,
+        };
+
+        double world_center[3];
+        double world_extent[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            world_center[c] = center[0] * m[0 * 4 + c] + center[1] * m[1 * 4 + c] + center[2] * m[2 * 4 + c] + m[3 * 4 + c];
+            world_extent[c] = extent[0] * std::abs(m[0 * 4 + c]) + extent[1] * std::abs(m[1 * 4 + c]) + extent[2] * std::abs(m[2 * 4 + c]);
+        }
+
+        return AABB(
+            Vector3(world_center[0] - world_extent[0], world_center[1] - world_extent[1], world_center[2] - world_extent[2]),
+            Vector3(world_center[0] + world_extent[0], world_center[1] + world_extent[1], world_center[2] + world_extent[2])
+        );
+    }
+
+    /// MakeFromScale(size) * MakeFromTranslation(min) * model 과 같다.
+    Matrix4x4f MakeBoundsMatrix(const AABBf& bounds, const Matrix4x4f& model)
+    {
+        const float size[3] = { bounds.GetSize().x, bounds.GetSize().y, bounds.GetSize().z };
+        const float min[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+
+        const float* m = model.GetData();
+        Matrix4x4f result;
+        float* r = result.GetData();
+        for (int c = 0; c < 4; ++c)
+        {
+            r[0 * 4 + c] = size[0] * m[0 * 4 + c];
+            r[1 * 4 + c] = size[1] * m[1 * 4 + c];
+            r[2 * 4 + c] = size[2] * m[2 * 4 + c];
+            r[3 * 4 + c] = min[0] * m[0 * 4 + c] + min[1] * m[1 * 4 + c] + min[2] * m[2 * 4 + c] + m[3 * 4 + c];
+        }
+        return result;
+    }
+}
+
+void TransformCache::Update(World& world)
+{
+    ZoneScoped;
+
+    ++frame;
+    changed_entities.clear();
+    removed_entities.clear();
+    dirty_slots.clear();
+    bounds_slots.clear();
+    dirty_batch.Clear();
+
+    // 지운 엔티티를 먼저 빼야, 같은 프레임에 같은 id를 받은 새 엔티티가 슬롯을 쓸 수 있다
+    for (const Entity entity : pending_removals)
+    {
+        RemoveSlot(entity);
+    }
+    pending_removals.clear();
+
+    // 1. 값이 바뀐 Transform만 double 행렬과 역행렬을 다시 계산
+    if (is_all_dirty)
+    {
+        RescanAll(world);
+        is_all_dirty = false;
+    }
+    else
+    {
+        RefreshDirty(world);
+    }
+    dirty_entities.clear();
+
+    // 2. 렌더링용 float 행렬은 바뀐 엔티티만 모아 한 번에 계산
+    dirty_models.resize(dirty_batch.Num());
+    dirty_batch.BuildModelMatrices(dirty_models);
+    for (size_t i = 0; i < dirty_slots.size(); ++i)
+    {
+        const uint32 slot = dirty_slots[i];
+        cached[slot].world_f = dirty_models[i];
+        MarkBoundsDirty(slot);
+        MarkChanged(slot);
+    }
+    num_recomputed = static_cast<uint32>(dirty_slots.size());
+
+    // 3. 월드 AABB는 행렬이나 메쉬가 바뀐 경우에만 갱신
+    for (const uint32 slot : bounds_slots)
+    {
+        SlotState& state = states[slot];
+        state.is_bounds_dirty = false;
+
+        CachedTransform& entry = cached[slot];
+        entry.has_bounds = state.source_mesh != nullptr;
+        if (entry.has_bounds)
+        {
+            const AABBf& local_bounds = state.source_mesh->bounds;
+            entry.world_bounds = TransformBounds(local_bounds, entry.world);
+            entry.bounds_matrix = MakeBoundsMatrix(local_bounds, entry.world_f);
+        }
+        MarkChanged(slot);
+    }
+}
+
+void TransformCache::MarkDirty(Entity entity)
+{
+    if (!entity.IsValid()) return;
+    dirty_entities.push_back(entity);
+}
+
+void TransformCache::MarkRemoved(Entity entity)
+{
+    if (!entity.IsValid()) return;
+
+    // 지운 엔티티의 컴포넌트는 더 읽을 수 없으므로 대기 중인 갱신도 뺀다
+    std::erase(dirty_entities, entity);
+    pending_removals.push_back(entity);
+}
+
+void TransformCache::RescanAll(World& world)
+{
+    ZoneScoped;
+
+    for (auto [entity, transform] : world.QueryEntities<Entity, const TransformComponent&>())
+    {
+        const uint32 slot = RefreshTransform(entity, transform);
+        states[slot].seen_frame = frame;
+    }
+
+    for (auto [entity, mesh_comp] : world.QueryEntities<Entity, const MeshComponent&>())
+    {
+        const uint32 slot = entity.GetId();
+        if (slot >= states.size() || states[slot].entity != entity || states[slot].seen_frame != frame)
+        {
+            continue; // TransformComponent가 없는 엔티티
+        }
+
+        states[slot].mesh_seen_frame = frame;
+        SetSourceMesh(slot, mesh_comp.mesh.get());
+    }
+
+    // 이번에 보이지 않은 엔티티와 메쉬 정리
+    for (uint32 slot = 0; slot < states.size(); ++slot)
+    {
+        const SlotState& state = states[slot];
+        if (!state.is_valid) continue;
+
+        if (state.seen_frame != frame)
+        {
+            RemoveSlot(state.entity);
+        }
+        else if (state.mesh_seen_frame != frame)
+        {
+            SetSourceMesh(slot, nullptr);
+        }
+    }
+}
+
+void TransformCache::RefreshDirty(World& world)
+{
+    if (dirty_entities.empty()) return;
+
+    ZoneScoped;
+
+    for (const Entity entity : dirty_entities)
+    {
+        Optional<TransformComponent&> transform_opt = world.TryGetComponent<TransformComponent>(entity);
+        if (!transform_opt)
+        {
+            RemoveSlot(entity); // TransformComponent가 없는 엔티티
+            continue;
+        }
+
+        const uint32 slot = RefreshTransform(entity, transform_opt.Value());
+
+        Optional<MeshComponent&> mesh_comp_opt = world.TryGetComponent<MeshComponent>(entity);
+        SetSourceMesh(slot, mesh_comp_opt ? mesh_comp_opt.Value().mesh.get() : nullptr);
+    }
+}
+
+template <typename TransformType>
+uint32 TransformCache::RefreshTransform(Entity entity, const TransformType& transform)
+{
+    bool is_new;
+    const uint32 slot = AcquireSlot(entity, is_new);
+
+    const TransformSource source = {
+        transform.position.x, transform.position.y, transform.position.z,
+        transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+        transform.scale.x, transform.scale.y, transform.scale.z,
+    };
+    if (!is_new && sources[slot] == source)
+    {
+        return slot;
+    }
+    sources[slot] = source;
+
+    CachedTransform& entry = cached[slot];
+    entry.world = math::TransformUtility::MakeModelMatrix(transform.position, transform.rotation, transform.scale);
+    entry.inverse_world = entry.world.Inverse();
+
+    dirty_batch.Push(transform);
+    dirty_slots.push_back(slot);
+    return slot;
+}
+
+void TransformCache::SetSourceMesh(uint32 slot, const LoadedMesh* mesh)
+{
+    SlotState& state = states[slot];
+    if (state.source_mesh == mesh) return;
+
+    state.source_mesh = mesh;
+    MarkBoundsDirty(slot);
+}
+
+void TransformCache::MarkBoundsDirty(uint32 slot)
+{
+    SlotState& state = states[slot];
+    if (state.is_bounds_dirty) return;
+
+    state.is_bounds_dirty = true;
+    bounds_slots.push_back(slot);
+}
+
+const CachedTransform* TransformCache::Find(Entity entity) const
+{
+    const uint32 slot = entity.GetId();
+    if (slot >= states.size() || !states[slot].is_valid || states[slot].entity != entity)
+    {
+        return nullptr;
+    }
+    return &cached[slot];
+}
+
+void TransformCache::Reserve(size_t id_bound, size_t num_entities)
+{
+    states.reserve(id_bound);
+    cached.reserve(id_bound);
+    sources.reserve(id_bound);
+
+    // 새 엔티티는 첫 Update에서 모두 다시 계산된다
+    dirty_slots.reserve(num_entities);
+    dirty_models.reserve(num_entities);
+    dirty_batch.Reserve(num_entities);
+}
+
+uint32 TransformCache::AcquireSlot(Entity entity, bool& out_is_new)
+{
+    const uint32 slot = entity.GetId();
+    if (slot >= states.size())
+    {
+        states.resize(slot + 1);
+        cached.resize(slot + 1);
+        sources.resize(slot + 1);
+    }
+
+    SlotState& state = states[slot];
+    out_is_new = !state.is_valid || state.entity != entity;
+    if (out_is_new)
+    {
+        // 같은 id를 재사용한 새 엔티티라면 이전 엔티티는 제거된 것으로 알린다
+        if (state.is_valid)
+        {
+            removed_entities.push_back(state.entity);
+        }
+        else
+        {
+            ++num_cached;
+        }
+
+        state = SlotState{ .entity = entity, .is_valid = true };
+        cached[slot] = CachedTransform{ .entity = entity };
+    }
+    return slot;
+}
+
+void TransformCache::RemoveSlot(Entity entity)
+{
+    const uint32 slot = entity.GetId();
+    if (slot >= states.size() || !states[slot].is_valid || states[slot].entity != entity)
+    {
+        return;
+    }
+
+    removed_entities.push_back(entity);
+    states[slot] = SlotState{};
+    cached[slot] = CachedTransform{};
+    --num_cached;
+}
+
+void TransformCache::MarkChanged(uint32 slot)
+{
+    SlotState& state = states[slot];
+    if (state.changed_frame == frame)
+    {
+        return;
+    }
+
+    state.changed_frame = frame;
+    ++cached[slot].version;
+    changed_entities.push_back(state.entity);
+}
@@ -0,0 +1,124 @@
+﻿#pragma once
+#include <array>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+#include "SimpleEngine/Core/Math/Math.h"
+#include "SimpleEngine/ECS/World.h"
+
+#include "Math/TransformKernel.h"
+
+
+struct LoadedMesh;
+
+/// 엔티티별로 캐시된 월드 변환 결과
+struct CachedTransform
+{
+    se::ecs::Entity entity;
+
+    se::Matrix4x4 world;
+    se::Matrix4x4 inverse_world;
+    se::Matrix4x4f world_f; // 렌더링용 (float)
+
+    // MeshComponent가 있을 때만 유효
+    bool has_bounds = false;
+    se::AABB world_bounds;
+    se::Matrix4x4f bounds_matrix; // 단위 큐브(0~1)를 메쉬 AABB에 맞춘 뒤 world를 적용한 행렬
+
+    uint32 version = 0; // 행렬이나 바운드가 바뀔 때마다 증가
+};
+
+/**
+ * TransformComponent의 변경을 추적해, 바뀐 엔티티만 월드 행렬/역행렬/월드 AABB를 다시 계산하는 캐시
+ *
+ * 엔티티 id로 인덱싱하는 슬롯 배열을 사용하며, 세대(generation)가 다르면 새 엔티티로 취급한다.
+ * 컴포넌트를 바꾸는 쪽이 MarkDirty / MarkRemoved로 알려주고, Update는 알려준 엔티티만 확인하므로
+ * 아무것도 바뀌지 않은 프레임에는 엔티티 수와 상관없이 비용이 거의 없다.
+ * 알려준 엔티티도 마지막으로 본 위치/회전/스케일 값과 같으면 다시 계산하지 않는다.
+ */
+class TransformCache
+{
+public:
+    /// 알려준 엔티티로 캐시를 갱신한다. 프레임당 한 번, 컴포넌트 수정이 끝난 뒤 호출한다.
+    void Update(se::ecs::World& world);
+
+    /// 위치/회전/스케일이나 메쉬를 바꿨을 때, 엔티티를 만들었거나 컴포넌트를 붙였을 때 호출한다.
+    void MarkDirty(se::ecs::Entity entity);
+
+    /// 엔티티를 지울 때 호출한다.
+    void MarkRemoved(se::ecs::Entity entity);
+
+    /// 바뀐 엔티티의 핸들을 모를 때 호출한다. 다음 Update에서 월드 전체를 다시 확인한다.
+    void MarkAllDirty() { is_all_dirty = true; }
+
+    /// 엔티티를 한꺼번에 많이 만들기 전에 호출하면, 다음 Update에서 슬롯 배열을 여러 번 늘리지 않는다.
+    /// 슬롯은 엔티티 id로 찾으므로 id_bound(나올 수 있는 가장 큰 id + 1)까지, 갱신 목록은 num_entities까지 잡는다.
+    void Reserve(size_t id_bound, size_t num_entities);
+
+    [[nodiscard]] const CachedTransform* Find(se::ecs::Entity entity) const;
+
+    /// 마지막 Update에서 행렬이나 바운드가 바뀐 엔티티 (새로 생긴 엔티티 포함)
+    [[nodiscard]] std::span<const se::ecs::Entity> GetChangedEntities() const { return changed_entities; }
+
+    /// 마지막 Update에서 사라진 엔티티 (삭제되었거나 TransformComponent가 제거됨)
+    [[nodiscard]] std::span<const se::ecs::Entity> GetRemovedEntities() const { return removed_entities; }
+
+    [[nodiscard]] uint32 GetNumCached() const { return num_cached; }
+    [[nodiscard]] uint32 GetNumRecomputed() const { return num_recomputed; }
+
+private:
+    // 매 프레임 훑는 작은 상태와 캐시 결과를 분리해 둔다
+    struct SlotState
+    {
+        se::ecs::Entity entity;
+        const LoadedMesh* source_mesh = nullptr;
+        uint64 seen_frame = 0;
+        uint64 mesh_seen_frame = 0;
+        uint64 changed_frame = 0;
+        bool is_valid = false;
+        bool is_bounds_dirty = false;
+    };
+
+    using TransformSource = std::array<double, 10>;
+
+    /// 월드 전체를 훑어 캐시를 맞춘다. (처음 Update, MarkAllDirty 뒤)
+    void RescanAll(se::ecs::World& world);
+
+    /// MarkDirty로 알려준 엔티티만 다시 확인한다.
+    void RefreshDirty(se::ecs::World& world);
+
+    /// 값이 바뀌었으면 double 행렬을 다시 계산하고 float 행렬 계산을 예약한다. 슬롯을 돌려준다.
+    template <typename TransformType>
+    uint32 RefreshTransform(se::ecs::Entity entity, const TransformType& transform);
+
+    void SetSourceMesh(uint32 slot, const LoadedMesh* mesh);
+    void MarkBoundsDirty(uint32 slot);
+
+    uint32 AcquireSlot(se::ecs::Entity entity, bool& out_is_new);
+    void RemoveSlot(se::ecs::Entity entity);
+    void MarkChanged(uint32 slot);
+
+private:
+    std::vector<SlotState> states;
+    std::vector<CachedTransform> cached;
+    std::vector<TransformSource> sources;
+
+    std::vector<se::ecs::Entity> changed_entities;
+    std::vector<se::ecs::Entity> removed_entities;
+
+    // 다음 Update에서 확인할 엔티티
+    std::vector<se::ecs::Entity> dirty_entities;
+    std::vector<se::ecs::Entity> pending_removals;
+    bool is_all_dirty = true;
+
+    // 이번 프레임에 다시 계산할 슬롯 (float 행렬은 TransformBatch로 한 번에 계산)
+    std::vector<uint32> dirty_slots;
+    std::vector<uint32> bounds_slots;
+    std::vector<se::Matrix4x4f> dirty_models;
+    TransformBatch dirty_batch;
+
+    uint64 frame = 0;
+    uint32 num_cached = 0;
+    uint32 num_recomputed = 0;
+};
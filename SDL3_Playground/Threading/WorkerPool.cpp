@@ -0,0 +1,93 @@
+﻿#include "WorkerPool.h"
+
+#include <algorithm>
+
+#include "tracy/Tracy.hpp"
+
+
+WorkerPool::WorkerPool(uint32 num_workers)
+{
+    if (num_workers == 0)
+    {
+        num_workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    workers.reserve(num_workers);
+    for (uint32 i = 0; i < num_workers; ++i)
+    {
+        workers.emplace_back([this] { WorkerMain(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        is_stopping = true;
+    }
+    work_cv.notify_all();
+    workers.clear(); // join
+}
+
+void WorkerPool::ParallelFor(uint32 count, const std::function<void(uint32)>& task)
+{
+    ZoneScoped;
+
+    // 나눌 것이 없으면 워커를 깨우지 않는다
+    if (count <= 1 || workers.empty())
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        this->task = &task;
+        task_count = count;
+        next_index = 0;
+        num_running = static_cast<uint32>(workers.size());
+        ++generation;
+    }
+    work_cv.notify_all();
+
+    RunTasks();
+
+    // 워커가 task를 참조하는 동안에는 돌아가면 안 된다
+    std::unique_lock lock(mutex);
+    done_cv.wait(lock, [this] { return num_running == 0; });
+    this->task = nullptr;
+}
+
+void WorkerPool::WorkerMain()
+{
+    uint64 seen_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex);
+            work_cv.wait(lock, [&] { return is_stopping || generation != seen_generation; });
+            if (is_stopping) return;
+
+            seen_generation = generation;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard lock(mutex);
+            --num_running;
+        }
+        done_cv.notify_one();
+    }
+}
+
+void WorkerPool::RunTasks()
+{
+    for (uint32 i = next_index++; i < task_count; i = next_index++)
+    {
+        (*task)(i);
+    }
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+/**
+ * 프레임마다 짧은 병렬 작업을 돌리기 위한 상주 워커 스레드 풀
+ *
+ * 매번 스레드를 만들지 않도록 워커는 대기 상태로 남아 있고, ParallelFor가 깨운다.
+ * ParallelFor는 한 번에 하나만 (같은 스레드에서) 호출해야 한다.
+ */
+class WorkerPool
+{
+public:
+    /// num_workers가 0이면 하드웨어 스레드 수 - 1 (호출 스레드 몫을 뺀다)
+    explicit WorkerPool(uint32 num_workers = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+public:
+    /// [0, count)의 인덱스마다 task를 실행하고 모두 끝날 때까지 기다린다. 호출한 스레드도 같이 일한다.
+    void ParallelFor(uint32 count, const std::function<void(uint32)>& task);
+
+    [[nodiscard]] uint32 GetNumWorkers() const { return static_cast<uint32>(workers.size()); }
+
+private:
+    void WorkerMain();
+    void RunTasks();
+
+private:
+    std::vector<std::jthread> workers;
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    bool is_stopping = false;
+    uint64 generation = 0;  // ParallelFor 호출마다 증가
+    uint32 num_running = 0; // 이번 작업에서 아직 끝나지 않은 워커 수
+
+    const std::function<void(uint32)>* task = nullptr;
+    uint32 task_count = 0;
+    std::atomic<uint32> next_index = 0;
+};
@@ -0,0 +1,170 @@
+﻿#include "FramePacer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "SDL3/SDL.h"
+#include "tracy/Tracy.hpp"
+
+
+namespace
+{
+    // 스핀 구간 범위. 최솟값은 OS 타이머가 아무리 정확해도 남겨두는 여유
+    constexpr uint64 MinSpinThresholdNs = 200'000;
+    constexpr uint64 MaxSpinThresholdNs = 4'000'000;
+
+    // 측정한 늦잠에 더하는 여유
+    constexpr uint64 OversleepMarginNs = 100'000;
+
+    double NsToMs(double ns) { return ns / 1'000'000.0; }
+}
+
+FramePacer::FramePacer()
+    : target_frame_ns(SDL_NS_PER_SECOND / 60)
+    , idle_frame_ns(SDL_NS_PER_SECOND / 30)
+    , spin_threshold_ns(1'000'000)
+{
+}
+
+void FramePacer::SetMode(FramePacingMode new_mode)
+{
+    mode = new_mode;
+}
+
+void FramePacer::SetTargetFrameTime(double seconds)
+{
+    target_frame_ns = static_cast<uint64>(std::max(seconds, 0.0) * SDL_NS_PER_SECOND);
+}
+
+void FramePacer::SetIdleFrameTime(double seconds)
+{
+    idle_frame_ns = static_cast<uint64>(std::max(seconds, 0.0) * SDL_NS_PER_SECOND);
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    ZoneScoped;
+
+    const uint64 frame_ns = GetActiveFrameTimeNs();
+    const bool is_waiting = frame_ns > 0 && (mode == FramePacingMode::Fixed || mode == FramePacingMode::Adaptive);
+
+    uint64 now = SDL_GetTicksNS();
+    uint64 sleep_ns = 0;
+    uint64 spin_ns = 0;
+
+    if (is_waiting)
+    {
+        // 이미 늦었으면 따라잡으려 하지 않고 지금부터 다시 맞춘다
+        uint64 next_start = deadline_ns + frame_ns;
+        if (deadline_ns == 0 || next_start <= now || next_start > now + frame_ns)
+        {
+            next_start = std::max(now, last_frame_start_ns + frame_ns);
+            next_start = std::min(next_start, now + frame_ns);
+        }
+
+        // 1. 대부분의 시간은 OS 타이머로 잔다
+        if (next_start > now + spin_threshold_ns)
+        {
+            ZoneScopedN("FramePacer::Sleep");
+
+            const uint64 wake_target = next_start - spin_threshold_ns;
+            SDL_DelayNS(wake_target - now);
+
+            const uint64 woke = SDL_GetTicksNS();
+            sleep_ns = woke - now;
+
+            // 늦게 깨어난 만큼 스핀 구간을 늘리고, 그렇지 않으면 천천히 줄인다
+            const uint64 oversleep = woke > wake_target ? woke - wake_target : 0;
+            const uint64 decayed = spin_threshold_ns - spin_threshold_ns / 64;
+            spin_threshold_ns = std::clamp(std::max(oversleep + OversleepMarginNs, decayed), MinSpinThresholdNs, MaxSpinThresholdNs);
+            now = woke;
+        }
+
+        // 2. 마지막 구간은 스핀
+        {
+            ZoneScopedN("FramePacer::Spin");
+
+            const uint64 spin_start = now;
+            while (now < next_start)
+            {
+                SDL_CPUPauseInstruction();
+                now = SDL_GetTicksNS();
+            }
+            spin_ns = now - spin_start;
+        }
+
+        deadline_ns = next_start;
+    }
+    else
+    {
+        deadline_ns = now;
+    }
+
+    RecordFrame(now, sleep_ns, spin_ns);
+}
+
+FramePacingStats FramePacer::GetStats() const
+{
+    FramePacingStats stats;
+    stats.target_ms = NsToMs(static_cast<double>(GetActiveFrameTimeNs()));
+    stats.spin_threshold_ms = NsToMs(static_cast<double>(spin_threshold_ns));
+    stats.num_samples = num_samples;
+    if (num_samples == 0)
+    {
+        return stats;
+    }
+
+    std::array<double, NumSamples> errors;
+    double total_frame = 0.0, total_error = 0.0, total_sleep = 0.0, total_spin = 0.0;
+    for (uint32 i = 0; i < num_samples; ++i)
+    {
+        const Sample& sample = samples[i];
+        const double frame = static_cast<double>(sample.frame_ns);
+
+        errors[i] = sample.target_ns > 0 ? std::abs(frame - static_cast<double>(sample.target_ns)) : 0.0;
+        total_frame += frame;
+        total_error += errors[i];
+        total_sleep += static_cast<double>(sample.sleep_ns);
+        total_spin += static_cast<double>(sample.spin_ns);
+    }
+
+    const uint32 p99_index = std::min(num_samples - 1, num_samples * 99 / 100);
+    std::nth_element(errors.begin(), errors.begin() + p99_index, errors.begin() + num_samples);
+
+    stats.mean_frame_ms = NsToMs(total_frame / num_samples);
+    stats.mean_abs_error_ms = NsToMs(total_error / num_samples);
+    stats.p99_abs_error_ms = NsToMs(errors[p99_index]);
+    stats.max_abs_error_ms = NsToMs(*std::max_element(errors.begin(), errors.begin() + num_samples));
+    if (total_frame > 0.0)
+    {
+        stats.sleep_ratio = total_sleep / total_frame;
+        stats.spin_ratio = total_spin / total_frame;
+    }
+    return stats;
+}
+
+uint64 FramePacer::GetActiveFrameTimeNs() const
+{
+    switch (mode)
+    {
+    case FramePacingMode::Unlimited: return 0;
+    case FramePacingMode::Adaptive:  return is_idle ? std::max(idle_frame_ns, target_frame_ns) : target_frame_ns;
+    default:                         return target_frame_ns;
+    }
+}
+
+void FramePacer::RecordFrame(uint64 frame_start_ns, uint64 sleep_ns, uint64 spin_ns)
+{
+    if (last_frame_start_ns != 0)
+    {
+        samples[sample_cursor] = {
+            .target_ns = GetActiveFrameTimeNs(),
+            .frame_ns = frame_start_ns - last_frame_start_ns,
+            .sleep_ns = sleep_ns,
+            .spin_ns = spin_ns,
+        };
+        sample_cursor = (sample_cursor + 1) % NumSamples;
+        num_samples = std::min(num_samples + 1, NumSamples);
+    }
+    last_frame_start_ns = frame_start_ns;
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+#include <array>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+enum class FramePacingMode : uint8
+{
+    Unlimited, // 대기 없음
+    Fixed,     // 목표 프레임 시간에 맞춰 대기
+    VSync,     // 스왑체인(VSYNC)이 속도를 정하고, 여기서는 측정만 한다
+    Adaptive,  // 디스플레이 주사율에 맞추고, 유휴 상태면 더 낮은 속도로 대기
+};
+
+struct FramePacingStats
+{
+    double target_ms = 0.0;
+    double mean_frame_ms = 0.0;
+    double mean_abs_error_ms = 0.0; // |실제 프레임 간격 - 목표|
+    double p99_abs_error_ms = 0.0;
+    double max_abs_error_ms = 0.0;
+    double sleep_ratio = 0.0;       // 프레임 시간 중 OS 대기 비율
+    double spin_ratio = 0.0;        // 프레임 시간 중 스핀 대기 비율
+    double spin_threshold_ms = 0.0;
+    uint32 num_samples = 0;
+};
+
+/**
+ * 프레임 시작 간격을 목표 시간에 맞추는 페이서
+ *
+ * 남은 시간의 대부분은 OS 타이머로 자고, 마지막 구간만 스핀한다.
+ * 스핀 구간의 길이는 실제로 측정한 sleep 오차(늦게 깨어난 정도)에 맞춰 줄이거나 늘린다.
+ * 데드라인은 절대 시각으로 누적하므로 프레임마다의 오차가 쌓이지 않는다.
+ */
+class FramePacer
+{
+public:
+    FramePacer();
+
+public:
+    void SetMode(FramePacingMode new_mode);
+    [[nodiscard]] FramePacingMode GetMode() const { return mode; }
+
+    /// Fixed / Adaptive 모드의 목표 프레임 시간 (초)
+    void SetTargetFrameTime(double seconds);
+
+    /// Adaptive 모드에서 유휴 상태(포커스 없음, 최소화)일 때 사용할 프레임 시간 (초)
+    void SetIdleFrameTime(double seconds);
+    void SetIdle(bool is_idle) { this->is_idle = is_idle; }
+
+    /// 다음 프레임 시작 시각까지 기다린다. 프레임 루프 끝에서 한 번 호출한다.
+    void WaitForNextFrame();
+
+    [[nodiscard]] FramePacingStats GetStats() const;
+
+private:
+    [[nodiscard]] uint64 GetActiveFrameTimeNs() const;
+    void RecordFrame(uint64 frame_start_ns, uint64 sleep_ns, uint64 spin_ns);
+
+private:
+    static constexpr uint32 NumSamples = 240;
+
+    FramePacingMode mode = FramePacingMode::Adaptive;
+    uint64 target_frame_ns = 0;
+    uint64 idle_frame_ns = 0;
+    bool is_idle = false;
+
+    uint64 deadline_ns = 0;         // 다음 프레임 시작 예정 시각
+    uint64 last_frame_start_ns = 0; // 지난 프레임 시작 시각
+    uint64 spin_threshold_ns = 0;
+
+    struct Sample
+    {
+        uint64 target_ns;
+        uint64 frame_ns;
+        uint64 sleep_ns;
+        uint64 spin_ns;
+    };
+    std::array<Sample, NumSamples> samples = {};
+    uint32 sample_cursor = 0;
+    uint32 num_samples = 0;
+};
@@ -0,0 +1,182 @@
+﻿#include "FrameTelemetry.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+#include "SDL3/SDL.h"
+
+
+namespace
+{
+    double NsToMs(uint64 ns) { return static_cast<double>(ns) / 1'000'000.0; }
+
+    /// 정렬된 값에서 백분위 (nearest-rank)
+    double Percentile(const std::vector<uint64>& sorted, double percent)
+    {
+        const size_t rank = static_cast<size_t>(percent / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+        return NsToMs(sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1]);
+    }
+}
+
+const char* GetFrameStageName(FrameStage stage)
+{
+    switch (stage)
+    {
+    case FrameStage::PlatformEvents:   return "PlatformEvents";
+    case FrameStage::Update:           return "Update";
+    case FrameStage::Render:           return "Render";
+    case FrameStage::SwapchainAcquire: return "SwapchainAcquire";
+    case FrameStage::Submit:           return "Submit";
+    case FrameStage::FrameSleep:       return "FrameSleep";
+    case FrameStage::Frame:            return "Frame";
+    default:                           return "Unknown";
+    }
+}
+
+void FrameTelemetry::EndFrame()
+{
+    const uint64 index = write_count.load(std::memory_order_relaxed);
+    frames[index % NumFrames] = current;
+    write_count.store(index + 1, std::memory_order_release);
+
+    current = {};
+}
+
+void FrameTelemetry::ComputeStats(std::span<FrameStageStats> out_stats) const
+{
+    std::vector<FrameSample> samples;
+    Snapshot(samples);
+
+    std::vector<uint64> values(samples.size());
+    for (uint32 stage = 0; stage < NumFrameStages && stage < out_stats.size(); ++stage)
+    {
+        FrameStageStats& stats = out_stats[stage];
+        stats = {};
+        if (samples.empty()) continue;
+
+        uint64 total = 0;
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            values[i] = samples[i][stage];
+            total += values[i];
+        }
+        std::ranges::sort(values);
+
+        stats.mean_ms = NsToMs(total) / static_cast<double>(values.size());
+        stats.p50_ms = Percentile(values, 50.0);
+        stats.p95_ms = Percentile(values, 95.0);
+        stats.p99_ms = Percentile(values, 99.0);
+        stats.max_ms = NsToMs(values.back());
+    }
+}
+
+bool FrameTelemetry::ExportCsv(const std::filesystem::path& path) const
+{
+    std::vector<FrameSample> samples;
+    const uint64 first_frame = Snapshot(samples);
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "frame";
+    for (uint32 stage = 0; stage < NumFrameStages; ++stage)
+    {
+        file << ',' << GetFrameStageName(static_cast<FrameStage>(stage)) << "_ms";
+    }
+    file << '\n';
+
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        file << first_frame + i;
+        for (const uint64 ns : samples[i])
+        {
+            file << std::format(",{:.4f}", NsToMs(ns));
+        }
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool FrameTelemetry::ExportJson(const std::filesystem::path& path) const
+{
+    std::vector<FrameSample> samples;
+    const uint64 first_frame = Snapshot(samples);
+
+    std::array<FrameStageStats, NumFrameStages> stats;
+    ComputeStats(stats);
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "{\n  \"first_frame\": " << first_frame << ",\n  \"num_frames\": " << samples.size() << ",\n";
+
+    file << "  \"stats\": {\n";
+    for (uint32 stage = 0; stage < NumFrameStages; ++stage)
+    {
+        const FrameStageStats& s = stats[stage];
+        file << std::format(
+            "    \"{}\": {{ \"mean_ms\": {:.4f}, \"p50_ms\": {:.4f}, \"p95_ms\": {:.4f}, \"p99_ms\": {:.4f}, \"max_ms\": {:.4f} }}{}\n",
+            GetFrameStageName(static_cast<FrameStage>(stage)),
+            s.mean_ms, s.p50_ms, s.p95_ms, s.p99_ms, s.max_ms,
+            stage + 1 < NumFrameStages ? "," : ""
+        );
+    }
+    file << "  },\n";
+
+    // 단계별 프레임 시간 배열 (frame = first_frame + 인덱스)
+    file << "  \"frames_ms\": {\n";
+    for (uint32 stage = 0; stage < NumFrameStages; ++stage)
+    {
+        file << "    \"" << GetFrameStageName(static_cast<FrameStage>(stage)) << "\": [";
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            file << std::format("{}{:.4f}", i > 0 ? "," : "", NsToMs(samples[i][stage]));
+        }
+        file << (stage + 1 < NumFrameStages ? "],\n" : "]\n");
+    }
+    file << "  }\n}\n";
+    return static_cast<bool>(file);
+}
+
+uint64 FrameTelemetry::Snapshot(std::vector<FrameSample>& out_frames) const
+{
+    const uint64 end = write_count.load(std::memory_order_acquire);
+
+    // 가장 오래된 슬롯은 다음 EndFrame이 덮어쓸 수 있으므로 빼고 읽는다
+    const uint64 begin = end > NumFrames - 1 ? end - (NumFrames - 1) : 0;
+    out_frames.resize(end - begin);
+    for (uint64 i = begin; i < end; ++i)
+    {
+        out_frames[i - begin] = frames[i % NumFrames];
+    }
+
+    // 읽는 동안 기록이 더 진행되었다면 덮어쓰인 앞부분을 버린다
+    const uint64 end_after = write_count.load(std::memory_order_acquire);
+    const uint64 valid_begin = end_after > NumFrames - 1 ? end_after - (NumFrames - 1) : 0;
+    if (valid_begin > begin)
+    {
+        const uint64 num_stale = std::min(valid_begin - begin, static_cast<uint64>(out_frames.size()));
+        out_frames.erase(out_frames.begin(), out_frames.begin() + static_cast<ptrdiff_t>(num_stale));
+        return begin + num_stale;
+    }
+    return begin;
+}
+
+ScopedFrameStage::ScopedFrameStage(FrameTelemetry& telemetry, FrameStage stage)
+    : telemetry(telemetry)
+    , stage(stage)
+    , start_ns(SDL_GetTicksNS())
+{
+}
+
+ScopedFrameStage::~ScopedFrameStage()
+{
+    telemetry.Record(stage, SDL_GetTicksNS() - start_ns);
+}
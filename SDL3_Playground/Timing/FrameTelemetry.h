@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "SimpleEngine/Core/HAL/PlatformTypes.h"
+
+
+enum class FrameStage : uint8
+{
+    PlatformEvents,   // ProcessPlatformEvents
+    Update,           // Update (ImGui 포함)
+    Render,           // Render 전체 (아래 두 단계 포함)
+    SwapchainAcquire, // 스왑체인 텍스처 대기 (윈도우 수만큼 합산)
+    Submit,           // 커맨드 버퍼 제출 (윈도우 수만큼 합산)
+    FrameSleep,       // 프레임 페이싱 대기
+    Frame,            // 프레임 시작 ~ 다음 프레임 시작
+
+    Count,
+};
+
+constexpr uint32 NumFrameStages = static_cast<uint32>(FrameStage::Count);
+
+const char* GetFrameStageName(FrameStage stage);
+
+struct FrameStageStats
+{
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/**
+ * 프레임 단계별 소요 시간을 최근 NumFrames 프레임만큼 보관하는 텔레메트리
+ *
+ * 프레임 안에서 같은 단계가 여러 번 불리면(윈도우별 Acquire / Submit) 합산해 한 샘플로 만든다.
+ * 기록은 메인 스레드 하나가 하고, 링 버퍼의 쓰기 위치만 원자적으로 공개하므로
+ * 다른 스레드에서도 잠금 없이 최근 프레임을 읽을 수 있다 (덮어쓰는 중인 가장 오래된 프레임은 제외).
+ */
+class FrameTelemetry
+{
+public:
+    static constexpr uint32 NumFrames = 1024;
+
+    /// 단계 시간을 현재 프레임에 더한다.
+    void Record(FrameStage stage, uint64 duration_ns)
+    {
+        current[static_cast<uint32>(stage)] += duration_ns;
+    }
+
+    /// 현재 프레임을 링 버퍼에 넣고 다음 프레임을 시작한다.
+    void EndFrame();
+
+    /// 최근 프레임들의 단계별 통계. out_stats는 NumFrameStages 크기여야 한다.
+    void ComputeStats(std::span<FrameStageStats> out_stats) const;
+
+    /// 최근 프레임들을 프레임 단위 행으로 내보낸다 (단위 ms).
+    bool ExportCsv(const std::filesystem::path& path) const;
+
+    /// 통계와 프레임별 샘플을 함께 내보낸다 (단위 ms).
+    bool ExportJson(const std::filesystem::path& path) const;
+
+    [[nodiscard]] uint64 GetNumFramesRecorded() const { return write_count.load(std::memory_order_acquire); }
+
+private:
+    using FrameSample = std::array<uint64, NumFrameStages>;
+
+    /// 읽을 수 있는 프레임들을 오래된 순으로 복사한다. 첫 프레임의 번호를 반환한다.
+    uint64 Snapshot(std::vector<FrameSample>& out_frames) const;
+
+private:
+    FrameSample current = {};
+
+    std::array<FrameSample, NumFrames> frames = {};
+    std::atomic<uint64> write_count = 0; // 지금까지 기록한 프레임 수
+};
+
+/// 스코프가 끝날 때 경과 시간을 기록한다.
+class ScopedFrameStage
+{
+public:
+    ScopedFrameStage(FrameTelemetry& telemetry, FrameStage stage);
+    ~ScopedFrameStage();
+
+    ScopedFrameStage(const ScopedFrameStage&) = delete;
+    ScopedFrameStage& operator=(const ScopedFrameStage&) = delete;
+
+private:
+    FrameTelemetry& telemetry;
+    FrameStage stage;
+    uint64 start_ns;
+};
@@ -4,7 +4,7 @@
 #include "SimpleEngine/Core/Logging/Backends/ConsoleBackend.h"
 
 
-int main()
+int main(int argc, char* argv[])
 {
     {
         using namespace se;
@@ -13,7 +13,7 @@ int main()
     }
 
     {
-        App app;
+        App app(AppOptions::FromCommandLine(argc, argv));
         app.Initialize();
         app.Run();
         app.Release();
@@ -0,0 +1,49 @@
+// CompactVertex (Rendering/MeshEncoding.h) 입력용 버텍스 셰이더
+struct VertexInput
+{
+    float4 position : POSITION;  // unorm16x4, 메쉬 AABB 기준
+    float2 normal : NORMAL;      // snorm16x2, 8면체 인코딩
+    float2 tex_coord : TEXCOORD; // half2
+};
+
+struct VertexOutput
+{
+    float4 position : SV_POSITION;
+    float3 normal : NORMAL;
+};
+
+// 인스턴스별 모델 행렬 (프레임마다 업로드)
+StructuredBuffer<float4x4> instance_models : register(t0, space0);
+
+cbuffer ViewBuffer : register(b0, space1)
+{
+    float4x4 view_proj;
+    uint instance_offset; // 이번 드로우의 첫 인스턴스 위치
+};
+
+// 메쉬별 위치 복원 값 (position = position_min + v * position_scale)
+cbuffer MeshBuffer : register(b1, space1)
+{
+    float4 position_min;
+    float4 position_scale;
+};
+
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 n = float3(encoded.x, encoded.y, 1.0 - abs(encoded.x) - abs(encoded.y));
+    const float t = saturate(-n.z);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+VertexOutput main(VertexInput input, uint instance_id : SV_InstanceID)
+{
+    const float4x4 model = instance_models[instance_offset + instance_id];
+    const float3 position = position_min.xyz + input.position.xyz * position_scale.xyz;
+
+    VertexOutput output;
+    output.position = mul(view_proj, mul(model, float4(position, 1.0)));
+    output.normal = DecodeOctahedral(input.normal);
+    return output;
+}
@@ -10,15 +10,21 @@ struct VertexOutput
     float3 normal : NORMAL;
 };
 
-cbuffer MVPBuffer : register(b0, space1)
+// 인스턴스별 모델 행렬 (프레임마다 업로드)
+StructuredBuffer<float4x4> instance_models : register(t0, space0);
+
+cbuffer ViewBuffer : register(b0, space1)
 {
-    float4x4 mvp;
+    float4x4 view_proj;
+    uint instance_offset; // 이번 드로우의 첫 인스턴스 위치
 };
 
-VertexOutput main(VertexInput input)
+VertexOutput main(VertexInput input, uint instance_id : SV_InstanceID)
 {
+    const float4x4 model = instance_models[instance_offset + instance_id];
+
     VertexOutput output;
-    output.position = mul(mvp, float4(input.position, 1.0));
+    output.position = mul(view_proj, mul(model, float4(input.position, 1.0)));
     output.normal = input.normal;
     return output;
 }
@@ -0,0 +1,224 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Scene/DynamicAabbTree.h"
+#include "SimpleEngine/ECS/Components/TransformComponent.h"
+
+using namespace se;
+using namespace se::ecs;
+
+
+namespace
+{
+    /// 정밀 판정용 ray / AABB 교차. 맞으면 들어가는 거리
+    std::optional<double> IntersectRay(const Ray& ray, const AABB& bounds)
+    {
+        const double origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+        const double direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+        const double min[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+        const double max[3] = { bounds.max.x, bounds.max.y, bounds.max.z };
+
+        double t_min = 0.0;
+        double t_max = std::numeric_limits<double>::max();
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            double t1 = (min[axis] - origin[axis]) / direction[axis];
+            double t2 = (max[axis] - origin[axis]) / direction[axis];
+            if (t1 > t2) std::swap(t1, t2);
+            t_min = std::max(t_min, t1);
+            t_max = std::min(t_max, t2);
+            if (t_min > t_max) return std::nullopt;
+        }
+        return t_min;
+    }
+
+    AABB MakeBox(double x, double y, double z, double half_extent)
+    {
+        return AABB(
+            Vector3(x - half_extent, y - half_extent, z - half_extent),
+            Vector3(x + half_extent, y + half_extent, z + half_extent)
+        );
+    }
+
+    class DynamicAabbTreeTest : public testing::Test
+    {
+    protected:
+        /// 프록시에 붙일 엔티티를 count개 만든다.
+        void SpawnEntities(uint32 count)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                world.SpawnEntity()
+                     .AddComponent<TransformComponent>();
+            }
+            const auto alive_entities = world.GetAliveEntities();
+            for (uint32 i = 0; i < alive_entities.Len(); ++i)
+            {
+                entities.push_back(alive_entities[i]);
+            }
+            ASSERT_EQ(entities.size(), count);
+        }
+
+        [[nodiscard]] size_t IndexOf(Entity entity) const
+        {
+            return std::ranges::find(entities, entity) - entities.begin();
+        }
+
+        /// 트리에서 가장 가까운 박스를 찾는다. 없으면 entities.size()
+        [[nodiscard]] size_t RayCastClosest(const DynamicAabbTree& tree, const Ray& ray, const std::vector<AABB>& boxes) const
+        {
+            size_t closest = entities.size();
+            tree.RayCast(ray, std::numeric_limits<double>::max(), [&](Entity entity, double max_distance) -> double
+            {
+                const size_t index = IndexOf(entity);
+                const std::optional<double> distance = IntersectRay(ray, boxes[index]);
+                if (!distance || *distance >= max_distance) return max_distance;
+
+                closest = index;
+                return *distance;
+            });
+            return closest;
+        }
+
+    protected:
+        World world;
+        std::vector<Entity> entities;
+    };
+}
+
+TEST_F(DynamicAabbTreeTest, RayCastFindsClosestProxy)
+{
+    SpawnEntities(3);
+
+    DynamicAabbTree tree;
+    const std::vector<AABB> boxes = { MakeBox(30.0, 0.0, 0.0, 1.0), MakeBox(10.0, 0.0, 0.0, 1.0), MakeBox(20.0, 0.0, 0.0, 1.0) };
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        tree.CreateProxy(boxes[i], entities[i]);
+    }
+    EXPECT_EQ(tree.GetProxyCount(), 3u);
+
+    const Ray ray(Vector3(0.0, 0.25, 0.25), Vector3(1.0, 0.0, 0.0));
+    EXPECT_EQ(RayCastClosest(tree, ray, boxes), 1u);
+
+    const Ray miss(Vector3(0.0, 5.0, 0.25), Vector3(1.0, 0.0, 0.0));
+    EXPECT_EQ(RayCastClosest(tree, miss, boxes), entities.size());
+}
+
+TEST_F(DynamicAabbTreeTest, DestroyedProxyIsNotHit)
+{
+    SpawnEntities(2);
+
+    DynamicAabbTree tree;
+    const std::vector<AABB> boxes = { MakeBox(10.0, 0.0, 0.0, 1.0), MakeBox(20.0, 0.0, 0.0, 1.0) };
+    const int32 near_proxy = tree.CreateProxy(boxes[0], entities[0]);
+    tree.CreateProxy(boxes[1], entities[1]);
+
+    tree.DestroyProxy(near_proxy);
+    EXPECT_EQ(tree.GetProxyCount(), 1u);
+
+    const Ray ray(Vector3(0.0, 0.25, 0.25), Vector3(1.0, 0.0, 0.0));
+    EXPECT_EQ(RayCastClosest(tree, ray, boxes), 1u);
+}
+
+TEST_F(DynamicAabbTreeTest, MoveProxyReinsertsOnlyOutsideFatBounds)
+{
+    SpawnEntities(1);
+
+    DynamicAabbTree tree;
+    const int32 proxy = tree.CreateProxy(MakeBox(0.0, 0.0, 0.0, 1.0), entities[0]);
+
+    EXPECT_FALSE(tree.MoveProxy(proxy, MakeBox(0.01, 0.0, 0.0, 1.0)));
+    EXPECT_TRUE(tree.MoveProxy(proxy, MakeBox(50.0, 0.0, 0.0, 1.0)));
+    EXPECT_EQ(tree.GetEntity(proxy), entities[0]);
+
+    const std::vector<AABB> boxes = { MakeBox(50.0, 0.0, 0.0, 1.0) };
+    const Ray ray(Vector3(0.0, 0.25, 0.25), Vector3(1.0, 0.0, 0.0));
+    EXPECT_EQ(RayCastClosest(tree, ray, boxes), 0u);
+}
+
+TEST_F(DynamicAabbTreeTest, MatchesBruteForceAfterRandomEdits)
+{
+    constexpr uint32 NumEntities = 2000;
+    SpawnEntities(NumEntities);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> position_dist(-100.0, 100.0);
+    std::uniform_real_distribution<double> extent_dist(0.1, 3.0);
+    const auto random_box = [&]
+    {
+        return MakeBox(position_dist(rng), position_dist(rng), position_dist(rng), extent_dist(rng));
+    };
+
+    DynamicAabbTree tree;
+    std::vector<AABB> boxes(NumEntities);
+    std::vector<int32> proxies(NumEntities, DynamicAabbTree::NullNode);
+    for (uint32 i = 0; i < NumEntities; ++i)
+    {
+        boxes[i] = random_box();
+        proxies[i] = tree.CreateProxy(boxes[i], entities[i]);
+    }
+
+    uint32 num_alive = NumEntities;
+    for (uint32 step = 0; step < 10000; ++step)
+    {
+        const uint32 i = rng() % NumEntities;
+        const uint32 op = rng() % 3;
+        if (op == 0 && proxies[i] != DynamicAabbTree::NullNode)
+        {
+            tree.DestroyProxy(proxies[i]);
+            proxies[i] = DynamicAabbTree::NullNode;
+            --num_alive;
+        }
+        else if (op == 1 && proxies[i] == DynamicAabbTree::NullNode)
+        {
+            boxes[i] = random_box();
+            proxies[i] = tree.CreateProxy(boxes[i], entities[i]);
+            ++num_alive;
+        }
+        else if (proxies[i] != DynamicAabbTree::NullNode)
+        {
+            const double offset = position_dist(rng) * 0.05;
+            boxes[i].min.x += offset;
+            boxes[i].max.x += offset;
+            tree.MoveProxy(proxies[i], boxes[i]);
+        }
+    }
+    ASSERT_EQ(tree.GetProxyCount(), num_alive);
+
+    // 균형이 깨지면 높이가 프록시 수에 비례해 커진다
+    EXPECT_LE(tree.GetHeight(), 4 * static_cast<int32>(std::ceil(std::log2(static_cast<double>(num_alive)))));
+
+    for (uint32 r = 0; r < 500; ++r)
+    {
+        const Vector3 origin(position_dist(rng), position_dist(rng), position_dist(rng));
+        const Vector3 direction = Vector3(position_dist(rng), position_dist(rng), position_dist(rng)).GetNormalized();
+        const Ray ray(origin, direction);
+
+        double expected_distance = std::numeric_limits<double>::max();
+        for (uint32 i = 0; i < NumEntities; ++i)
+        {
+            if (proxies[i] == DynamicAabbTree::NullNode) continue;
+            if (const std::optional<double> distance = IntersectRay(ray, boxes[i]))
+            {
+                expected_distance = std::min(expected_distance, *distance);
+            }
+        }
+
+        const size_t closest = RayCastClosest(tree, ray, boxes);
+        if (expected_distance == std::numeric_limits<double>::max())
+        {
+            EXPECT_EQ(closest, entities.size()) << "ray " << r;
+        }
+        else
+        {
+            ASSERT_LT(closest, entities.size()) << "ray " << r;
+            EXPECT_DOUBLE_EQ(*IntersectRay(ray, boxes[closest]), expected_distance) << "ray " << r;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+﻿#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Rendering/GeometryBuffer.h"
+#include "Rendering/UploadRing.h"
+
+
+namespace
+{
+    constexpr uint32 VertexStride = 16;
+
+    std::vector<uint8> MakeBytes(size_t size, uint32 seed)
+    {
+        std::vector<uint8> bytes(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<uint8>(seed * 31 + i * 7);
+        }
+        return bytes;
+    }
+
+    /// GPU 디바이스가 필요한 테스트. 디바이스를 만들 수 없는 환경(드라이버 없는 CI 등)에서는 건너뛴다.
+    class GeometryBufferTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+            SDL_Init(SDL_INIT_VIDEO);
+
+            device = SDL_CreateGPUDevice(
+                SDL_GPU_SHADERFORMAT_SPIRV | SDL_GPU_SHADERFORMAT_DXIL | SDL_GPU_SHADERFORMAT_MSL, false, nullptr
+            );
+            if (!device)
+            {
+                GTEST_SKIP() << "GPU device unavailable: " << SDL_GetError();
+            }
+        }
+
+        void TearDown() override
+        {
+            geometry.reset();
+            upload_ring.reset();
+            if (device)
+            {
+                SDL_DestroyGPUDevice(device);
+            }
+            SDL_Quit();
+        }
+
+        void Create(uint32 ring_bytes, uint32 page_bytes, uint32 retire_frames)
+        {
+            upload_ring = std::make_unique<UploadRing>(device, ring_bytes);
+            geometry = std::make_unique<GeometryBuffer>(device, *upload_ring, page_bytes, retire_frames);
+        }
+
+        /// App::Update와 같은 순서: 지오메트리 갱신(조각 모음 예약) -> 업로드 / 해제 -> 제출
+        void BeginFrame(uint64 max_move_bytes)
+        {
+            geometry->Update(frame_index, max_move_bytes);
+        }
+
+        void EndFrame()
+        {
+            upload_ring->Flush();
+            ++frame_index;
+        }
+
+        std::vector<uint8> ReadBuffer(SDL_GPUBuffer* buffer, uint32 offset, uint32 size)
+        {
+            const SDL_GPUTransferBufferCreateInfo transfer_info = {
+                .usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD,
+                .size = size,
+            };
+            SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+
+            // 업로드 링과 같은 큐이므로 앞서 제출한 복사가 끝난 뒤에 읽는다
+            SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(device);
+            SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(cmd);
+            const SDL_GPUBufferRegion src = { .buffer = buffer, .offset = offset, .size = size };
+            const SDL_GPUTransferBufferLocation dst = { .transfer_buffer = transfer_buffer, .offset = 0 };
+            SDL_DownloadFromGPUBuffer(copy_pass, &src, &dst);
+            SDL_EndGPUCopyPass(copy_pass);
+
+            SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+            SDL_WaitForGPUFences(device, true, &fence, 1);
+            SDL_ReleaseGPUFence(device, fence);
+
+            const auto* mapped = static_cast<const uint8*>(SDL_MapGPUTransferBuffer(device, transfer_buffer, false));
+            std::vector<uint8> bytes(mapped, mapped + size);
+            SDL_UnmapGPUTransferBuffer(device, transfer_buffer);
+            SDL_ReleaseGPUTransferBuffer(device, transfer_buffer);
+            return bytes;
+        }
+
+        void ExpectContents(uint32 handle, const std::vector<uint8>& vertices, const std::vector<uint8>& indices)
+        {
+            const GeometrySlice slice = geometry->GetSlice(handle);
+            ASSERT_TRUE(slice.IsValid());
+            EXPECT_EQ(ReadBuffer(slice.vertex_buffer, slice.first_vertex * VertexStride, static_cast<uint32>(vertices.size())), vertices);
+            EXPECT_EQ(ReadBuffer(slice.index_buffer, slice.first_index * 2, static_cast<uint32>(indices.size())), indices);
+        }
+
+    protected:
+        SDL_GPUDevice* device = nullptr;
+        std::unique_ptr<UploadRing> upload_ring;
+        std::unique_ptr<GeometryBuffer> geometry;
+        uint64 frame_index = 0;
+    };
+}
+
+TEST_F(GeometryBufferTest, CompactionMovesLiveMeshesIntoFreedRanges)
+{
+    constexpr uint32 RetireFrames = 2;
+    Create(1024 * 1024, 4096, RetireFrames);
+
+    // 한 페이지(256 정점)를 64 정점짜리 메쉬 넷으로 채운다
+    std::vector<std::vector<uint8>> vertices;
+    std::vector<std::vector<uint8>> indices;
+    std::vector<uint32> handles;
+    BeginFrame(0);
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        vertices.push_back(MakeBytes(64 * VertexStride, i));
+        indices.push_back(MakeBytes(128, i + 100));
+        handles.push_back(geometry->Upload(vertices[i], VertexStride, indices[i], SDL_GPU_INDEXELEMENTSIZE_16BIT));
+        ASSERT_NE(handles[i], GeometryBuffer::InvalidHandle);
+    }
+    EndFrame();
+
+    const uint32 old_first_vertex[2] = { geometry->GetSlice(handles[2]).first_vertex, geometry->GetSlice(handles[3]).first_vertex };
+    EXPECT_GE(old_first_vertex[0], 128u);
+    EXPECT_GE(old_first_vertex[1], 128u);
+
+    // 앞쪽 둘을 지운다. 구간은 retire_frames 뒤에야 할당기로 돌아오므로 그 전에는 옮기지 않는다
+    BeginFrame(0);
+    geometry->Free(handles[0]);
+    geometry->Free(handles[1]);
+    EndFrame();
+
+    BeginFrame(1024 * 1024);
+    EndFrame();
+    EXPECT_EQ(geometry->GetStats().num_moves, 0u);
+
+    BeginFrame(1024 * 1024);
+    EndFrame();
+
+    const GeometryBufferStats stats = geometry->GetStats();
+    EXPECT_GE(stats.num_moves, 2u);
+    EXPECT_GT(stats.moved_bytes, 0u);
+    EXPECT_EQ(stats.num_meshes, 2u);
+
+    const GeometrySlice moved[2] = { geometry->GetSlice(handles[2]), geometry->GetSlice(handles[3]) };
+    EXPECT_LT(moved[0].first_vertex, 128u);
+    EXPECT_LT(moved[1].first_vertex, 128u);
+    EXPECT_NE(moved[0].first_vertex, moved[1].first_vertex);
+
+    ExpectContents(handles[2], vertices[2], indices[2]);
+    ExpectContents(handles[3], vertices[3], indices[3]);
+
+    // 옮기기 전 구간도 retire_frames 뒤에 돌아와 페이지가 다시 절반 비어야 한다
+    for (uint32 i = 0; i <= RetireFrames; ++i)
+    {
+        BeginFrame(0);
+        EndFrame();
+    }
+    EXPECT_EQ(geometry->GetStats().pending_free_bytes, 0u);
+    EXPECT_EQ(geometry->GetStats().used_bytes, 2 * (64 * VertexStride + 128));
+}
+
+TEST_F(GeometryBufferTest, UploadsMeshLargerThanUploadRing)
+{
+    Create(16 * 1024, 64 * 1024, 2);
+
+    const std::vector<uint8> vertices = MakeBytes(6400 * VertexStride, 1);
+    const std::vector<uint8> indices = MakeBytes(40 * 1024, 2);
+
+    BeginFrame(0);
+    const uint32 handle = geometry->Upload(vertices, VertexStride, indices, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+    ASSERT_NE(handle, GeometryBuffer::InvalidHandle);
+    EndFrame();
+
+    ExpectContents(handle, vertices, indices);
+}
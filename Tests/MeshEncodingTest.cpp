@@ -0,0 +1,99 @@
+﻿#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "Rendering/MeshEncoding.h"
+
+
+namespace
+{
+    /// 기대값 계산용 half -> float (정확히 표현되므로 ldexp로 충분하다)
+    float HalfToFloat(uint16 half)
+    {
+        const float sign = (half & 0x8000) ? -1.0f : 1.0f;
+        const int32 exponent = (half >> 10) & 0x1F;
+        const int32 mantissa = half & 0x3FF;
+        if (exponent == 0)
+        {
+            return sign * std::ldexp(static_cast<float>(mantissa), -24);
+        }
+        if (exponent == 0x1F)
+        {
+            return mantissa == 0 ? sign * std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+        }
+        return sign * std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+    }
+}
+
+TEST(FloatToHalf, ConvertsExactValues)
+{
+    EXPECT_EQ(FloatToHalf(0.0f), 0x0000);
+    EXPECT_EQ(FloatToHalf(-0.0f), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.0f), 0xC000);
+    EXPECT_EQ(FloatToHalf(0.5f), 0x3800);
+    EXPECT_EQ(FloatToHalf(65504.0f), 0x7BFF); // 가장 큰 유한값
+}
+
+TEST(FloatToHalf, RoundsToNearestEven)
+{
+    EXPECT_EQ(FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);     // 1과 다음 값의 중간, 짝수 쪽
+    EXPECT_EQ(FloatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3C02); // 홀수와 짝수 사이, 짝수 쪽
+    EXPECT_EQ(FloatToHalf(1.0f + std::ldexp(1.0f, -11) + std::ldexp(1.0f, -20)), 0x3C01);
+    EXPECT_EQ(FloatToHalf(2.0f - std::ldexp(1.0f, -11)), 0x4000);     // 가수가 넘쳐 지수로 올라간다
+}
+
+TEST(FloatToHalf, OverflowBecomesInfinity)
+{
+    EXPECT_EQ(FloatToHalf(65520.0f), 0x7C00); // 65504와 65536의 중간, 짝수(inf) 쪽
+    EXPECT_EQ(FloatToHalf(65519.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(1.0e10f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(-1.0e10f), 0xFC00);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::max()), 0x7C00);
+}
+
+TEST(FloatToHalf, KeepsInfinityAndNaN)
+{
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_EQ(FloatToHalf(-std::numeric_limits<float>::infinity()), 0xFC00);
+
+    const uint16 nan = FloatToHalf(std::numeric_limits<float>::quiet_NaN());
+    EXPECT_EQ(nan & 0x7C00, 0x7C00);
+    EXPECT_NE(nan & 0x03FF, 0);
+
+    // 가수의 위쪽 비트가 0인 NaN도 inf가 되면 안 된다
+    const uint16 signaling_nan = FloatToHalf(std::numeric_limits<float>::signaling_NaN());
+    EXPECT_EQ(signaling_nan & 0x7C00, 0x7C00);
+    EXPECT_NE(signaling_nan & 0x03FF, 0);
+}
+
+TEST(FloatToHalf, ConvertsHalfDenormals)
+{
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -14)), 0x0400);            // 가장 작은 정규값
+    EXPECT_EQ(FloatToHalf(std::ldexp(1023.0f, -24)), 0x03FF);         // 가장 큰 비정규값
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -24)), 0x0001);            // 가장 작은 비정규값
+    EXPECT_EQ(FloatToHalf(-std::ldexp(1.0f, -24)), 0x8001);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -25)), 0x0000);            // 0과 2^-24의 중간, 짝수(0) 쪽
+    EXPECT_EQ(FloatToHalf(std::ldexp(3.0f, -26)), 0x0001);            // 중간보다 크다
+    EXPECT_EQ(FloatToHalf(std::ldexp(3.0f, -25)), 0x0002);            // 1과 2의 중간, 짝수 쪽
+    EXPECT_EQ(FloatToHalf(std::ldexp(2047.0f, -25)), 0x0400);         // 비정규에서 정규로 올라간다
+}
+
+TEST(FloatToHalf, FlushesTinyAndFloatDenormalsToSignedZero)
+{
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -26)), 0x0000);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::denorm_min()), 0x0000);
+    EXPECT_EQ(FloatToHalf(-std::numeric_limits<float>::denorm_min()), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.0e-40f), 0x0000);
+}
+
+TEST(FloatToHalf, RoundTripsEveryHalf)
+{
+    for (uint32 half = 0; half <= 0xFFFF; ++half)
+    {
+        const bool is_nan = (half & 0x7C00) == 0x7C00 && (half & 0x03FF) != 0;
+        if (is_nan) continue;
+
+        EXPECT_EQ(FloatToHalf(HalfToFloat(static_cast<uint16>(half))), half) << std::hex << "half 0x" << half;
+    }
+}
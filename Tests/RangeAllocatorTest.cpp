@@ -0,0 +1,122 @@
+﻿#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Rendering/RangeAllocator.h"
+
+
+TEST(RangeAllocator, AllocatesFromFrontUntilFull)
+{
+    RangeAllocator allocator(100);
+    EXPECT_EQ(allocator.Allocate(10), 0u);
+    EXPECT_EQ(allocator.Allocate(20), 10u);
+    EXPECT_EQ(allocator.Allocate(70), 30u);
+
+    EXPECT_EQ(allocator.GetUsedSize(), 100u);
+    EXPECT_EQ(allocator.GetNumFreeBlocks(), 0u);
+    EXPECT_FALSE(allocator.Allocate(1).has_value());
+}
+
+TEST(RangeAllocator, PicksSmallestFittingBlock)
+{
+    RangeAllocator allocator(100);
+    const uint32 a = *allocator.Allocate(30);
+    const uint32 b = *allocator.Allocate(10);
+    const uint32 c = *allocator.Allocate(10);
+    const uint32 d = *allocator.Allocate(25);
+    (void)b;
+    (void)d;
+
+    // 빈 구간: [0, 30), [40, 50), [75, 100)
+    allocator.Free(a, 30);
+    allocator.Free(c, 10);
+    ASSERT_EQ(allocator.GetNumFreeBlocks(), 3u);
+
+    EXPECT_EQ(allocator.Allocate(8), 40u);
+    EXPECT_EQ(allocator.Allocate(20), 75u);
+    EXPECT_EQ(allocator.Allocate(30), 0u);
+}
+
+TEST(RangeAllocator, FreeCoalescesWithBothNeighbors)
+{
+    RangeAllocator allocator(90);
+    const uint32 a = *allocator.Allocate(30);
+    const uint32 b = *allocator.Allocate(30);
+    const uint32 c = *allocator.Allocate(30);
+
+    allocator.Free(a, 30);
+    allocator.Free(c, 30);
+    EXPECT_EQ(allocator.GetNumFreeBlocks(), 2u);
+    EXPECT_EQ(allocator.GetLargestFreeBlock(), 30u);
+
+    allocator.Free(b, 30);
+    EXPECT_EQ(allocator.GetNumFreeBlocks(), 1u);
+    EXPECT_EQ(allocator.GetLargestFreeBlock(), 90u);
+    EXPECT_EQ(allocator.GetFreeSize(), 90u);
+    EXPECT_EQ(allocator.Allocate(90), 0u);
+}
+
+TEST(RangeAllocator, AllocateLowestStaysBelowLimit)
+{
+    RangeAllocator allocator(100);
+    const uint32 a = *allocator.Allocate(50);
+    (void)*allocator.Allocate(50);
+    allocator.Free(a, 50);
+
+    EXPECT_FALSE(allocator.AllocateLowest(60, 100).has_value());
+    EXPECT_FALSE(allocator.AllocateLowest(45, 40).has_value());
+    EXPECT_EQ(allocator.AllocateLowest(10, 50), 0u);
+    EXPECT_EQ(allocator.AllocateLowest(10, 50), 10u);
+    EXPECT_EQ(allocator.GetFreeSize(), 30u);
+}
+
+TEST(RangeAllocator, MatchesBruteForceUnderRandomAllocations)
+{
+    constexpr uint32 Capacity = 10000;
+    RangeAllocator allocator(Capacity);
+    std::vector<bool> is_used(Capacity, false);
+    std::vector<std::pair<uint32, uint32>> live;
+
+    std::mt19937 rng(1);
+    for (int32 i = 0; i < 20000; ++i)
+    {
+        if (live.empty() || rng() % 2 == 0)
+        {
+            const uint32 size = 1 + rng() % 200;
+            if (const std::optional<uint32> offset = allocator.Allocate(size))
+            {
+                ASSERT_LE(*offset + size, Capacity);
+                for (uint32 k = *offset; k < *offset + size; ++k)
+                {
+                    ASSERT_FALSE(is_used[k]) << "overlapping allocation at " << k;
+                    is_used[k] = true;
+                }
+                live.emplace_back(*offset, size);
+            }
+        }
+        else
+        {
+            const size_t index = rng() % live.size();
+            const auto [offset, size] = live[index];
+            for (uint32 k = offset; k < offset + size; ++k)
+            {
+                is_used[k] = false;
+            }
+            allocator.Free(offset, size);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    // 빈 칸 수와, 연속된 빈 칸 묶음 수(= 병합된 빈 구간 수)가 같아야 한다
+    uint32 free_size = 0;
+    uint32 num_free_runs = 0;
+    for (uint32 k = 0; k < Capacity; ++k)
+    {
+        free_size += is_used[k] ? 0 : 1;
+        num_free_runs += !is_used[k] && (k == 0 || is_used[k - 1]) ? 1 : 0;
+    }
+    EXPECT_EQ(allocator.GetFreeSize(), free_size);
+    EXPECT_EQ(allocator.GetNumFreeBlocks(), num_free_runs);
+}